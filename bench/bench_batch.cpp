@@ -0,0 +1,96 @@
+#include <benchmark.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <vector_array.hpp>
+#include <vector_kernels.hpp>
+
+/*
+ * Normalizing arrays of Vector3f: per-element member calls against the
+ * blocked batch kernels (array-of-structures) and VectorArray (SoA)
+ */
+namespace
+{
+    constexpr std::int64_t counts[] = {1 << 10, 1 << 14, 1 << 18, 1 << 22};
+
+    std::vector<Vector3f> make_points(std::size_t n)
+    {
+        std::vector<Vector3f> points;
+        for (std::size_t i = 0; i < n; ++i)
+            points.emplace_back(0.5f + (i % 13), -1.0f - (i % 7), 2.0f + (i % 5));
+        return points;
+    }
+
+    void finish(bench::State &state, std::size_t n)
+    {
+        const auto processed{static_cast<std::int64_t>(state.iterations() * n)};
+        state.set_items_processed(processed);
+        state.set_bytes_processed(processed * static_cast<std::int64_t>(2 * sizeof(Vector3f)));
+    }
+
+    void bm_member_normalize(bench::State &state)
+    {
+        const std::vector<Vector3f> in{make_points(static_cast<std::size_t>(state.range(0)))};
+        std::vector<Vector3f> out(in.size());
+        for (auto _ : state)
+        {
+            for (std::size_t i = 0; i < in.size(); ++i)
+                out[i] = in[i].normalize();
+            bench::clobber_memory();
+        }
+        finish(state, in.size());
+    }
+
+    void bm_kernel_normalize(bench::State &state)
+    {
+        const std::vector<Vector3f> in{make_points(static_cast<std::size_t>(state.range(0)))};
+        std::vector<Vector3f> out(in.size());
+        for (auto _ : state)
+        {
+            vec::normalize(in.data(), out.data(), in.size());
+            bench::clobber_memory();
+        }
+        finish(state, in.size());
+    }
+
+    void bm_kernel_normalize_fast(bench::State &state)
+    {
+        const std::vector<Vector3f> in{make_points(static_cast<std::size_t>(state.range(0)))};
+        std::vector<Vector3f> out(in.size());
+        for (auto _ : state)
+        {
+            vec::normalize_fast(in.data(), out.data(), in.size());
+            bench::clobber_memory();
+        }
+        finish(state, in.size());
+    }
+
+    void bm_array_normalize(bench::State &state)
+    {
+        const std::vector<Vector3f> points{make_points(static_cast<std::size_t>(state.range(0)))};
+        const Vector3fArray in(points.data(), points.size());
+        for (auto _ : state)
+        {
+            Vector3fArray out{in.normalize()};
+            bench::do_not_optimize(out);
+        }
+        finish(state, in.size());
+    }
+
+    bool register_all()
+    {
+        for (const std::int64_t n : counts)
+        {
+            const std::string suffix{"/" + std::to_string(n)};
+            bench::register_benchmark("BM_Vector3f_normalize_member" + suffix, bm_member_normalize, {n});
+            bench::register_benchmark("BM_Vector3f_normalize_kernel" + suffix, bm_kernel_normalize, {n});
+            bench::register_benchmark("BM_Vector3f_normalize_fast_kernel" + suffix, bm_kernel_normalize_fast, {n});
+            bench::register_benchmark("BM_Vector3fArray_normalize" + suffix, bm_array_normalize, {n});
+        }
+        return true;
+    }
+
+    [[maybe_unused]] const bool registered = register_all();
+} // namespace
@@ -0,0 +1,109 @@
+#include <benchmark.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <vector_dispatch.hpp>
+#include <vector_random.hpp>
+
+/*
+ * The batch kernels at each instruction-set level the CPU supports, called
+ * through vec::detail::kernel_for, and through vec::dispatched ("auto",
+ * labelled with the level that ran; set VECTORS_SIMD_LEVEL to force one).
+ * 64K vectors, about L2 sized. Items are vectors.
+ */
+namespace
+{
+    constexpr std::size_t count{1 << 16};
+
+    template <typename V>
+    std::vector<V> make_vectors(std::uint64_t seed)
+    {
+        using T = vec::detail::scalar_t<V>;
+        std::vector<V> v(count);
+        vec::Philox4x32 rng{seed};
+        vec::generate(rng, vec::UniformBox<V>(T(-1), T(1)), v.data(), count);
+        return v;
+    }
+
+    void finish(bench::State &state, const char *level)
+    {
+        state.set_items_processed(static_cast<std::int64_t>(state.iterations() * count));
+        state.set_label(level);
+    }
+
+    template <typename V>
+    void bm_normalize(bench::State &state, vec::detail::kernel_fn<const V *, V *, std::size_t> f, const char *level)
+    {
+        const std::vector<V> in{make_vectors<V>(1)};
+        std::vector<V> out(count);
+        for (auto _ : state)
+        {
+            f(in.data(), out.data(), count);
+            bench::clobber_memory();
+        }
+        finish(state, level);
+    }
+
+    template <typename V, typename R>
+    void bm_dot_many(bench::State &state, vec::detail::kernel_fn<const V *, const V *, R *, std::size_t> f,
+                     const char *level)
+    {
+        const std::vector<V> a{make_vectors<V>(1)};
+        const std::vector<V> b{make_vectors<V>(2)};
+        std::vector<R> out(count);
+        for (auto _ : state)
+        {
+            f(a.data(), b.data(), out.data(), count);
+            bench::clobber_memory();
+        }
+        finish(state, level);
+    }
+
+    template <typename V, typename R>
+    void bm_length_many(bench::State &state, vec::detail::kernel_fn<const V *, R *, std::size_t> f, const char *level)
+    {
+        const std::vector<V> in{make_vectors<V>(1)};
+        std::vector<R> out(count);
+        for (auto _ : state)
+        {
+            f(in.data(), out.data(), count);
+            bench::clobber_memory();
+        }
+        finish(state, level);
+    }
+
+    // One row per supported level, then the dispatched one
+    template <typename K, typename... A, typename B>
+    void register_levels(const std::string &name, B bm)
+    {
+        constexpr vec::simd_level levels[] = {vec::simd_level::baseline, vec::simd_level::sse4_2,
+                                              vec::simd_level::avx2, vec::simd_level::avx512};
+        for (const vec::simd_level level : levels)
+            if (level <= vec::detect_simd_level())
+            {
+                const vec::detail::kernel_fn<A...> f{vec::detail::kernel_for<K, A...>(level)};
+                const char *level_name{vec::simd_level_name(level)};
+                bench::register_benchmark(name + "/" + level_name, [=](bench::State &s) { bm(s, f, level_name); });
+            }
+        bench::register_benchmark(name + "/auto", [=](bench::State &s)
+                                  { bm(s, vec::detail::dispatch<K, A...>, vec::simd_level_name(vec::active_simd_level())); });
+    }
+
+    bool register_all()
+    {
+        using namespace vec::detail;
+        register_levels<normalize_kernel, const Vector3f *, Vector3f *, std::size_t>(
+            "BM_dispatch_normalize_Vector3f", bm_normalize<Vector3f>);
+        register_levels<normalize_kernel, const Vector4d *, Vector4d *, std::size_t>(
+            "BM_dispatch_normalize_Vector4d", bm_normalize<Vector4d>);
+        register_levels<dot_many_kernel, const Vector3f *, const Vector3f *, float *, std::size_t>(
+            "BM_dispatch_dot_many_Vector3f", bm_dot_many<Vector3f, float>);
+        register_levels<length_many_kernel, const Vector2f *, float *, std::size_t>(
+            "BM_dispatch_length_many_Vector2f", bm_length_many<Vector2f, float>);
+        return true;
+    }
+
+    [[maybe_unused]] const bool registered = register_all();
+} // namespace
@@ -0,0 +1,136 @@
+#include <benchmark.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <vector_expr.hpp>
+
+/*
+ * a * s + b - c: eager operators (one temporary per operator) against the
+ * expression templates of vector_expr.hpp, on single Vector3d values and on
+ * Vector3dArray (where the temporaries are whole arrays)
+ */
+namespace
+{
+    constexpr std::int64_t counts[] = {1 << 10, 1 << 14, 1 << 18, 1 << 22};
+
+    Vector3d make_point(std::size_t i)
+    {
+        return Vector3d(0.5 + static_cast<double>(i % 13), -1.0 - static_cast<double>(i % 7), 2.0 + static_cast<double>(i % 5));
+    }
+
+    Vector3dArray make_array(std::size_t n, std::size_t offset)
+    {
+        Vector3dArray points;
+        points.reserve(n);
+        for (std::size_t i = 0; i < n; ++i)
+            points.push_back(make_point(i + offset));
+        return points;
+    }
+
+    void finish(bench::State &state, std::size_t n)
+    {
+        const auto processed{static_cast<std::int64_t>(state.iterations() * n)};
+        state.set_items_processed(processed);
+        state.set_bytes_processed(processed * static_cast<std::int64_t>(4 * sizeof(Vector3d)));
+    }
+
+    void bm_vector_eager(bench::State &state)
+    {
+        const std::size_t n{static_cast<std::size_t>(state.range(0))};
+        std::vector<Vector3d> a, b, c, out(n);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            a.push_back(make_point(i));
+            b.push_back(make_point(i + 1));
+            c.push_back(make_point(i + 2));
+        }
+        const double s{1.5};
+        for (auto _ : state)
+        {
+            for (std::size_t i = 0; i < n; ++i)
+                out[i] = a[i] * s + b[i] - c[i];
+            bench::clobber_memory();
+        }
+        finish(state, n);
+    }
+
+    void bm_vector_lazy(bench::State &state)
+    {
+        const std::size_t n{static_cast<std::size_t>(state.range(0))};
+        std::vector<Vector3d> a, b, c, out(n);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            a.push_back(make_point(i));
+            b.push_back(make_point(i + 1));
+            c.push_back(make_point(i + 2));
+        }
+        const double s{1.5};
+        for (auto _ : state)
+        {
+            for (std::size_t i = 0; i < n; ++i)
+                out[i] = vec::lazy(a[i]) * s + b[i] - c[i];
+            bench::clobber_memory();
+        }
+        finish(state, n);
+    }
+
+    void bm_array_eager(bench::State &state)
+    {
+        const std::size_t n{static_cast<std::size_t>(state.range(0))};
+        const Vector3dArray a{make_array(n, 0)}, b{make_array(n, 1)}, c{make_array(n, 2)};
+        Vector3dArray out{Vector3dArray::uninitialized(n)};
+        const double s{1.5};
+        for (auto _ : state)
+        {
+            out = a * s + b - c;
+            bench::clobber_memory();
+        }
+        finish(state, n);
+    }
+
+    void bm_array_lazy(bench::State &state)
+    {
+        const std::size_t n{static_cast<std::size_t>(state.range(0))};
+        const Vector3dArray a{make_array(n, 0)}, b{make_array(n, 1)}, c{make_array(n, 2)};
+        Vector3dArray out{Vector3dArray::uninitialized(n)};
+        const double s{1.5};
+        for (auto _ : state)
+        {
+            vec::assign(out, vec::lazy(a) * s + b - c);
+            bench::clobber_memory();
+        }
+        finish(state, n);
+    }
+
+    void bm_array_fma(bench::State &state)
+    {
+        const std::size_t n{static_cast<std::size_t>(state.range(0))};
+        const Vector3dArray a{make_array(n, 0)}, b{make_array(n, 1)}, c{make_array(n, 2)};
+        Vector3dArray out{Vector3dArray::uninitialized(n)};
+        const double s{1.5};
+        for (auto _ : state)
+        {
+            vec::assign(out, vec::fma(vec::lazy(a), s, b) - c);
+            bench::clobber_memory();
+        }
+        finish(state, n);
+    }
+
+    bool register_all()
+    {
+        for (const std::int64_t n : counts)
+        {
+            const std::string suffix{"/" + std::to_string(n)};
+            bench::register_benchmark("BM_Vector3d_axpy_sub_eager" + suffix, bm_vector_eager, {n});
+            bench::register_benchmark("BM_Vector3d_axpy_sub_lazy" + suffix, bm_vector_lazy, {n});
+            bench::register_benchmark("BM_Vector3dArray_axpy_sub_eager" + suffix, bm_array_eager, {n});
+            bench::register_benchmark("BM_Vector3dArray_axpy_sub_lazy" + suffix, bm_array_lazy, {n});
+            bench::register_benchmark("BM_Vector3dArray_axpy_sub_fma" + suffix, bm_array_fma, {n});
+        }
+        return true;
+    }
+
+    [[maybe_unused]] const bool registered = register_all();
+} // namespace
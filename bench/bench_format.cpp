@@ -0,0 +1,120 @@
+#include <benchmark.hpp>
+
+#include <cstdint>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <vector_format.hpp>
+
+/*
+ * Text of 1M Vector3f, one "x y z" line each: vec::parse_vectors and
+ * vec::format against iostreams. Bytes are those of the text.
+ */
+namespace
+{
+    constexpr std::size_t count{1 << 20};
+
+    const std::vector<Vector3f> &points()
+    {
+        static const std::vector<Vector3f> p{[] {
+            std::vector<Vector3f> r;
+            for (std::size_t i = 0; i < count; ++i)
+                r.emplace_back(0.001f * i, -1.0f / (i + 1), 12.5f + (i % 13));
+            return r;
+        }()};
+        return p;
+    }
+
+    const std::string &text()
+    {
+        static const std::string t{[] {
+            std::string r;
+            char line[vec::max_format_chars<float, 3> + 1];
+            for (const Vector3f &p : points())
+            {
+                char *end{vec::format(line, line + sizeof(line) - 1, p).ptr};
+                *end++ = '\n';
+                r.append(line, end);
+            }
+            return r;
+        }()};
+        return t;
+    }
+
+    void finish(bench::State &state)
+    {
+        state.set_items_processed(static_cast<std::int64_t>(state.iterations() * count));
+        state.set_bytes_processed(static_cast<std::int64_t>(state.iterations() * text().size()));
+    }
+
+    void bm_parse(bench::State &state)
+    {
+        const std::string &t{text()};
+        std::vector<Vector3f> out;
+        for (auto _ : state)
+        {
+            out.clear();
+            vec::parse_vectors(t.data(), t.data() + t.size(), out);
+            bench::do_not_optimize(out);
+        }
+        finish(state);
+    }
+
+    void bm_parse_iostream(bench::State &state)
+    {
+        std::vector<Vector3f> out;
+        for (auto _ : state)
+        {
+            out.clear();
+            std::istringstream in(text());
+            Vector3f p;
+            while (in >> p.x >> p.y >> p.z)
+                out.push_back(p);
+            bench::do_not_optimize(out);
+        }
+        finish(state);
+    }
+
+    void bm_format(bench::State &state)
+    {
+        std::string out(text().size(), '\0');
+        for (auto _ : state)
+        {
+            char *p{out.data()};
+            char *const last{out.data() + out.size()};
+            for (const Vector3f &v : points())
+            {
+                p = vec::format(p, last, v).ptr;
+                *p++ = '\n';
+            }
+            bench::do_not_optimize(out);
+        }
+        finish(state);
+    }
+
+    void bm_format_iostream(bench::State &state)
+    {
+        for (auto _ : state)
+        {
+            std::ostringstream out;
+            out.precision(std::numeric_limits<float>::max_digits10);
+            for (const Vector3f &v : points())
+                out << v.x << ' ' << v.y << ' ' << v.z << '\n';
+            bench::do_not_optimize(out);
+        }
+        finish(state);
+    }
+
+    bool register_all()
+    {
+        bench::register_benchmark("BM_Vector3f_text_parse", bm_parse);
+        bench::register_benchmark("BM_Vector3f_text_parse_iostream", bm_parse_iostream);
+        bench::register_benchmark("BM_Vector3f_text_format", bm_format);
+        bench::register_benchmark("BM_Vector3f_text_format_iostream", bm_format_iostream);
+        return true;
+    }
+
+    [[maybe_unused]] const bool registered = register_all();
+} // namespace
@@ -0,0 +1,156 @@
+#include <benchmark.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <vector_kernels.hpp>
+#include <vector_random.hpp>
+
+/*
+ * Integer vectors on voxel-grid coordinates (components within +-2^20):
+ * Vector4i arithmetic on the epi32 backend, Vector3i normalize() and pow()
+ * and squared norms, the default double ones against the exact 64-bit
+ * ones per element and through norm_squared_many(). Items are vectors.
+ */
+namespace
+{
+    constexpr std::int64_t counts[] = {1 << 12, 1 << 20};
+
+    template <typename V>
+    std::vector<V> make_vectors(std::size_t n, std::uint64_t seed)
+    {
+        std::vector<V> v(n);
+        vec::Philox4x32 rng{seed};
+        for (V &p : v)
+            for (std::size_t c = 0; c < V::size(); ++c)
+                p[c] = static_cast<int>(rng() >> 11) - (1 << 20);
+        return v;
+    }
+
+    template <typename V>
+    void finish(bench::State &state, std::size_t n)
+    {
+        const auto processed{static_cast<std::int64_t>(state.iterations() * n)};
+        state.set_items_processed(processed);
+        state.set_bytes_processed(processed * static_cast<std::int64_t>(sizeof(V)));
+    }
+
+    // r = clamp(a * b + c, -2^24, 2^24): multiplies, adds, minima and maxima
+    void bm_vector4i_arithmetic(bench::State &state)
+    {
+        const auto n{static_cast<std::size_t>(state.range(0))};
+        const std::vector<Vector4i> a{make_vectors<Vector4i>(n, 1)};
+        const std::vector<Vector4i> b{make_vectors<Vector4i>(n, 2)};
+        const std::vector<Vector4i> c{make_vectors<Vector4i>(n, 3)};
+        std::vector<Vector4i> r(n);
+        for (auto _ : state)
+        {
+            for (std::size_t i = 0; i < n; ++i)
+                r[i] = (a[i] * b[i] + c[i]).clamp(-(1 << 24), 1 << 24);
+            bench::clobber_memory();
+        }
+        finish<Vector4i>(state, n);
+    }
+
+    void bm_vector4i_divide(bench::State &state)
+    {
+        const auto n{static_cast<std::size_t>(state.range(0))};
+        const std::vector<Vector4i> a{make_vectors<Vector4i>(n, 1)};
+        std::vector<Vector4i> r(n);
+        for (auto _ : state)
+        {
+            for (std::size_t i = 0; i < n; ++i)
+                r[i] = a[i] / 7;
+            bench::clobber_memory();
+        }
+        finish<Vector4i>(state, n);
+    }
+
+    void bm_vector3i_normalize(bench::State &state)
+    {
+        const auto n{static_cast<std::size_t>(state.range(0))};
+        const std::vector<Vector3i> a{make_vectors<Vector3i>(n, 1)};
+        std::vector<Vector3i> r(n);
+        for (auto _ : state)
+        {
+            for (std::size_t i = 0; i < n; ++i)
+                r[i] = a[i].normalize();
+            bench::clobber_memory();
+        }
+        finish<Vector3i>(state, n);
+    }
+
+    void bm_vector3i_pow(bench::State &state)
+    {
+        const auto n{static_cast<std::size_t>(state.range(0))};
+        const std::vector<Vector3i> a{make_vectors<Vector3i>(n, 1)};
+        std::vector<Vector3i> r(n);
+        for (auto _ : state)
+        {
+            for (std::size_t i = 0; i < n; ++i)
+                r[i] = a[i].pow(3);
+            bench::clobber_memory();
+        }
+        finish<Vector3i>(state, n);
+    }
+
+    void bm_vector3i_norm_squared_double(bench::State &state)
+    {
+        const auto n{static_cast<std::size_t>(state.range(0))};
+        const std::vector<Vector3i> a{make_vectors<Vector3i>(n, 1)};
+        std::vector<double> r(n);
+        for (auto _ : state)
+        {
+            for (std::size_t i = 0; i < n; ++i)
+                r[i] = a[i].norm_squared();
+            bench::clobber_memory();
+        }
+        finish<Vector3i>(state, n);
+    }
+
+    void bm_vector3i_norm_squared_wide(bench::State &state)
+    {
+        const auto n{static_cast<std::size_t>(state.range(0))};
+        const std::vector<Vector3i> a{make_vectors<Vector3i>(n, 1)};
+        std::vector<std::uint64_t> r(n);
+        for (auto _ : state)
+        {
+            for (std::size_t i = 0; i < n; ++i)
+                r[i] = a[i].norm_squared_wide();
+            bench::clobber_memory();
+        }
+        finish<Vector3i>(state, n);
+    }
+
+    void bm_vector3i_norm_squared_many(bench::State &state)
+    {
+        const auto n{static_cast<std::size_t>(state.range(0))};
+        const std::vector<Vector3i> a{make_vectors<Vector3i>(n, 1)};
+        std::vector<std::uint64_t> r(n);
+        for (auto _ : state)
+        {
+            vec::norm_squared_many(a.data(), r.data(), n);
+            bench::clobber_memory();
+        }
+        finish<Vector3i>(state, n);
+    }
+
+    bool register_all()
+    {
+        for (const std::int64_t n : counts)
+        {
+            const std::string suffix{"/" + std::to_string(n)};
+            bench::register_benchmark("BM_Vector4i_arithmetic" + suffix, bm_vector4i_arithmetic, {n});
+            bench::register_benchmark("BM_Vector4i_divide" + suffix, bm_vector4i_divide, {n});
+            bench::register_benchmark("BM_Vector3i_normalize" + suffix, bm_vector3i_normalize, {n});
+            bench::register_benchmark("BM_Vector3i_pow" + suffix, bm_vector3i_pow, {n});
+            bench::register_benchmark("BM_Vector3i_norm_squared_double" + suffix, bm_vector3i_norm_squared_double, {n});
+            bench::register_benchmark("BM_Vector3i_norm_squared_wide" + suffix, bm_vector3i_norm_squared_wide, {n});
+            bench::register_benchmark("BM_Vector3i_norm_squared_many" + suffix, bm_vector3i_norm_squared_many, {n});
+        }
+        return true;
+    }
+
+    [[maybe_unused]] const bool registered = register_all();
+} // namespace
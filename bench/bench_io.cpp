@@ -0,0 +1,117 @@
+#include <benchmark.hpp>
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <vector_io.hpp>
+
+/*
+ * Saving and loading 1M Vector3f (12 MB) as a binary vector file against
+ * lossless text ("x y z" lines with max_digits10). Loads read from the page
+ * cache, so they measure parsing and copying rather than the disk.
+ */
+namespace
+{
+    constexpr std::size_t count{1 << 20};
+
+    const std::string binary_path{(std::filesystem::temp_directory_path() / "bench_vector_io.vec").string()};
+    const std::string text_path{(std::filesystem::temp_directory_path() / "bench_vector_io.txt").string()};
+
+    const std::vector<Vector3f> &points()
+    {
+        static const std::vector<Vector3f> p{[] {
+            std::vector<Vector3f> r;
+            for (std::size_t i = 0; i < count; ++i)
+                r.emplace_back(0.001f * i, -1.0f / (i + 1), 12.5f + (i % 13));
+            return r;
+        }()};
+        return p;
+    }
+
+    void write_text(const std::string &path, const std::vector<Vector3f> &v)
+    {
+        std::ofstream out(path);
+        out.precision(std::numeric_limits<float>::max_digits10);
+        for (const Vector3f &p : v)
+            out << p.x << ' ' << p.y << ' ' << p.z << '\n';
+    }
+
+    void finish(bench::State &state)
+    {
+        const auto processed{static_cast<std::int64_t>(state.iterations() * count)};
+        state.set_items_processed(processed);
+        state.set_bytes_processed(processed * static_cast<std::int64_t>(sizeof(Vector3f)));
+    }
+
+    void bm_write_binary(bench::State &state)
+    {
+        for (auto _ : state)
+            vec::write_vectors(binary_path, points().data(), points().size());
+        finish(state);
+    }
+
+    void bm_read_binary(bench::State &state)
+    {
+        vec::write_vectors(binary_path, points().data(), points().size());
+        for (auto _ : state)
+        {
+            std::vector<Vector3f> r{vec::read_vectors<Vector3f>(binary_path)};
+            bench::do_not_optimize(r);
+        }
+        finish(state);
+    }
+
+    // Open and touch every vector (the pages are faulted in on each mapping)
+    void bm_read_mapped(bench::State &state)
+    {
+        vec::write_vectors(binary_path, points().data(), points().size());
+        for (auto _ : state)
+        {
+            const vec::MappedVectorFile<Vector3f> file(binary_path);
+            Vector3f sum;
+            for (const Vector3f &p : file)
+                sum += p;
+            bench::do_not_optimize(sum);
+        }
+        finish(state);
+    }
+
+    void bm_write_text(bench::State &state)
+    {
+        for (auto _ : state)
+            write_text(text_path, points());
+        finish(state);
+    }
+
+    void bm_read_text(bench::State &state)
+    {
+        write_text(text_path, points());
+        for (auto _ : state)
+        {
+            std::ifstream in(text_path);
+            std::vector<Vector3f> r;
+            r.reserve(count);
+            Vector3f p;
+            while (in >> p.x >> p.y >> p.z)
+                r.push_back(p);
+            bench::do_not_optimize(r);
+        }
+        finish(state);
+    }
+
+    bool register_all()
+    {
+        bench::register_benchmark("BM_Vector3f_io_write_binary", bm_write_binary);
+        bench::register_benchmark("BM_Vector3f_io_read_binary", bm_read_binary);
+        bench::register_benchmark("BM_Vector3f_io_read_mapped", bm_read_mapped);
+        bench::register_benchmark("BM_Vector3f_io_write_text", bm_write_text);
+        bench::register_benchmark("BM_Vector3f_io_read_text", bm_read_text);
+        return true;
+    }
+
+    [[maybe_unused]] const bool registered = register_all();
+} // namespace
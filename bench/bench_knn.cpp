@@ -0,0 +1,76 @@
+#include <benchmark.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <vector_knn.hpp>
+#include <vector_random.hpp>
+
+/*
+ * 10 nearest neighbours of every query by squared L2 distance:
+ * vec::knn_brute_force against a loop over (a - b).norm_squared() feeding
+ * the same heap. Vector4f: 1K queries x 100K vectors; VectorN<float, 128>:
+ * 256 queries x 20K vectors. Items are query-vector pairs.
+ */
+namespace
+{
+    constexpr std::size_t k{10};
+
+    template <typename V>
+    std::vector<V> make_vectors(std::size_t n, std::uint64_t seed)
+    {
+        std::vector<V> v(n);
+        vec::Philox4x32 rng{seed};
+        vec::generate(rng, vec::UniformBox<V>(-1.0f, 1.0f), v.data(), n);
+        return v;
+    }
+
+    template <typename V>
+    void bm_loop(bench::State &state, std::size_t m, std::size_t n)
+    {
+        const std::vector<V> queries{make_vectors<V>(m, 1)};
+        const std::vector<V> database{make_vectors<V>(n, 2)};
+        std::vector<vec::Neighbor<float>> found;
+        for (auto _ : state)
+            for (const V &q : queries)
+            {
+                vec::detail::nearest_heap<float> heap(k, found);
+                for (std::size_t j = 0; j < n; ++j)
+                    heap.push(j, (database[j] - q).norm_squared());
+                heap.finish();
+                bench::do_not_optimize(found);
+            }
+        state.set_items_processed(static_cast<std::int64_t>(state.iterations() * m * n));
+    }
+
+    template <typename V>
+    void bm_blocked(bench::State &state, std::size_t m, std::size_t n)
+    {
+        const std::vector<V> queries{make_vectors<V>(m, 1)};
+        const std::vector<V> database{make_vectors<V>(n, 2)};
+        std::vector<vec::Neighbor<float>> found(m * k);
+        for (auto _ : state)
+        {
+            vec::knn_brute_force(queries.data(), m, database.data(), n, k, found.data());
+            bench::do_not_optimize(found);
+        }
+        state.set_items_processed(static_cast<std::int64_t>(state.iterations() * m * n));
+    }
+
+    template <typename V>
+    void register_pair(const std::string &name, std::size_t m, std::size_t n)
+    {
+        bench::register_benchmark("BM_knn_" + name + "_loop", [m, n](bench::State &s) { bm_loop<V>(s, m, n); });
+        bench::register_benchmark("BM_knn_" + name + "_blocked", [m, n](bench::State &s) { bm_blocked<V>(s, m, n); });
+    }
+
+    bool register_all()
+    {
+        register_pair<Vector4f>("Vector4f", 1000, 100000);
+        register_pair<VectorN<float, 128>>("Vector128f", 256, 20000);
+        return true;
+    }
+
+    [[maybe_unused]] const bool registered = register_all();
+} // namespace
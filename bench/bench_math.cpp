@@ -0,0 +1,135 @@
+#include <benchmark.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <vector_math.hpp>
+#include <vector_random.hpp>
+
+/*
+ * Component-wise exp, log, sin, atan2 and pow over 4K Vector3f/Vector3d
+ * (about L1 sized): std:: per component against the vec:: kernels at each
+ * instruction-set level the CPU supports ("baseline" is vec::exp_many etc.
+ * at the build flags). Items are vectors.
+ */
+namespace
+{
+    constexpr std::size_t count{1 << 12};
+
+    // x in [0, 4) for log and the base of pow, y in [-4, 4) for the rest
+    template <typename T>
+    std::vector<Vector3<T>> make_vectors(std::uint64_t seed, T lo, T hi)
+    {
+        std::vector<Vector3<T>> v(count);
+        vec::Philox4x32 rng{seed};
+        vec::generate(rng, vec::UniformBox<Vector3<T>>(lo, hi), v.data(), count);
+        return v;
+    }
+
+    struct std_exp
+    {
+        template <typename T>
+        T operator()(T a) const noexcept { return std::exp(a); }
+    };
+
+    struct std_log
+    {
+        template <typename T>
+        T operator()(T a) const noexcept { return std::log(a); }
+    };
+
+    struct std_sin
+    {
+        template <typename T>
+        T operator()(T a) const noexcept { return std::sin(a); }
+    };
+
+    struct std_atan2
+    {
+        template <typename T>
+        T operator()(T a, T b) const noexcept { return std::atan2(a, b); }
+    };
+
+    struct std_pow
+    {
+        template <typename T>
+        T operator()(T a, T b) const noexcept { return std::pow(a, b); }
+    };
+
+    // out = f(a) or f(a, b) over the components
+    template <typename F, bool Binary>
+    struct math_kernel
+    {
+        template <typename T>
+        static void run(const T *a, const T *b, T *out, std::size_t n) noexcept
+        {
+            if constexpr (Binary)
+                vec::detail::math_zip(a, b, out, n, F{});
+            else
+                vec::detail::math_map(a, out, n, F{});
+        }
+    };
+
+    template <typename T>
+    using kernel_fn = vec::detail::kernel_fn<const T *, const T *, T *, std::size_t>;
+
+    // Unary functions read y (or x for log), binary ones y and x as atan2(y, x) and pow(x, y)
+    template <typename T>
+    void bm_math(bench::State &state, kernel_fn<T> f, bool on_x, bool swap)
+    {
+        const std::vector<Vector3<T>> x{make_vectors<T>(1, T(0), T(4))};
+        const std::vector<Vector3<T>> y{make_vectors<T>(2, T(-4), T(4))};
+        std::vector<T> out(3 * count);
+        const T *a{vec::detail::scalars(on_x || swap ? x.data() : y.data())};
+        const T *b{vec::detail::scalars(swap ? y.data() : x.data())};
+        for (auto _ : state)
+        {
+            f(a, b, out.data(), out.size());
+            bench::clobber_memory();
+        }
+        state.set_items_processed(static_cast<std::int64_t>(state.iterations() * count));
+    }
+
+    // std:: at the build flags, then one row per supported level
+    template <typename T, typename S, typename F, bool Binary>
+    void register_function(const std::string &name, bool on_x, bool swap)
+    {
+        const kernel_fn<T> reference{
+            vec::detail::kernel_for<math_kernel<S, Binary>, const T *, const T *, T *, std::size_t>(
+                vec::simd_level::baseline)};
+        bench::register_benchmark(name + "/std", [=](bench::State &s) { bm_math<T>(s, reference, on_x, swap); });
+
+        constexpr vec::simd_level levels[] = {vec::simd_level::baseline, vec::simd_level::sse4_2,
+                                              vec::simd_level::avx2, vec::simd_level::avx512};
+        for (const vec::simd_level level : levels)
+            if (level <= vec::detect_simd_level())
+            {
+                const kernel_fn<T> f{
+                    vec::detail::kernel_for<math_kernel<F, Binary>, const T *, const T *, T *, std::size_t>(level)};
+                bench::register_benchmark(name + "/" + vec::simd_level_name(level),
+                                          [=](bench::State &s) { bm_math<T>(s, f, on_x, swap); });
+            }
+    }
+
+    template <typename T>
+    void register_type(const std::string &suffix)
+    {
+        using namespace vec::detail;
+        register_function<T, std_exp, exp_fn, false>("BM_math_exp_" + suffix, false, false);
+        register_function<T, std_log, log_fn, false>("BM_math_log_" + suffix, true, false);
+        register_function<T, std_sin, sin_fn, false>("BM_math_sin_" + suffix, false, false);
+        register_function<T, std_atan2, atan2_fn, true>("BM_math_atan2_" + suffix, false, false);
+        register_function<T, std_pow, pow_fn, true>("BM_math_pow_" + suffix, false, true);
+    }
+
+    bool register_all()
+    {
+        register_type<float>("Vector3f");
+        register_type<double>("Vector3d");
+        return true;
+    }
+
+    [[maybe_unused]] const bool registered = register_all();
+} // namespace
@@ -0,0 +1,140 @@
+#include <benchmark.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <matrix.hpp>
+
+/*
+ * Transforming arrays of points by a Matrix4f: per-element products against
+ * the blocked batch kernels, and the 4x4 products themselves
+ */
+namespace
+{
+    constexpr std::int64_t counts[] = {1 << 10, 1 << 14, 1 << 18, 1 << 22};
+
+    const Matrix4f transform{Vector4f(0.0f, 2.0f, 0.0f, 0.0f), Vector4f(-2.0f, 0.0f, 0.5f, 0.0f),
+                             Vector4f(0.0f, 0.25f, 2.0f, 0.0f), Vector4f(1.0f, 2.0f, 3.0f, 1.0f)};
+
+    std::vector<Vector3f> make_points(std::size_t n)
+    {
+        std::vector<Vector3f> points;
+        for (std::size_t i = 0; i < n; ++i)
+            points.emplace_back(0.5f + (i % 13), -1.0f - (i % 7), 2.0f + (i % 5));
+        return points;
+    }
+
+    template <typename V>
+    void finish(bench::State &state, std::size_t n)
+    {
+        const auto processed{static_cast<std::int64_t>(state.iterations() * n)};
+        state.set_items_processed(processed);
+        state.set_bytes_processed(processed * static_cast<std::int64_t>(2 * sizeof(V)));
+    }
+
+    void bm_points_member(bench::State &state)
+    {
+        const std::vector<Vector3f> in{make_points(static_cast<std::size_t>(state.range(0)))};
+        std::vector<Vector3f> out(in.size());
+        for (auto _ : state)
+        {
+            for (std::size_t i = 0; i < in.size(); ++i)
+            {
+                const Vector4f r{transform * Vector4f(in[i].x, in[i].y, in[i].z, 1.0f)};
+                out[i] = Vector3f(r.x, r.y, r.z);
+            }
+            bench::clobber_memory();
+        }
+        finish<Vector3f>(state, in.size());
+    }
+
+    void bm_points_kernel(bench::State &state)
+    {
+        const std::vector<Vector3f> in{make_points(static_cast<std::size_t>(state.range(0)))};
+        std::vector<Vector3f> out(in.size());
+        for (auto _ : state)
+        {
+            vec::transform_points(transform, in.data(), out.data(), in.size());
+            bench::clobber_memory();
+        }
+        finish<Vector3f>(state, in.size());
+    }
+
+    std::vector<Vector4f> make_vectors(std::size_t n)
+    {
+        std::vector<Vector4f> vectors;
+        for (const Vector3f &p : make_points(n))
+            vectors.emplace_back(p.x, p.y, p.z, 1.0f);
+        return vectors;
+    }
+
+    void bm_vectors_member(bench::State &state)
+    {
+        const std::vector<Vector4f> in{make_vectors(static_cast<std::size_t>(state.range(0)))};
+        std::vector<Vector4f> out(in.size());
+        for (auto _ : state)
+        {
+            for (std::size_t i = 0; i < in.size(); ++i)
+                out[i] = transform * in[i];
+            bench::clobber_memory();
+        }
+        finish<Vector4f>(state, in.size());
+    }
+
+    void bm_vectors_kernel(bench::State &state)
+    {
+        const std::vector<Vector4f> in{make_vectors(static_cast<std::size_t>(state.range(0)))};
+        std::vector<Vector4f> out(in.size());
+        for (auto _ : state)
+        {
+            vec::transform_many(transform, in.data(), out.data(), in.size());
+            bench::clobber_memory();
+        }
+        finish<Vector4f>(state, in.size());
+    }
+
+    template <typename M>
+    void bm_product(bench::State &state)
+    {
+        M a{static_cast<M>(transform)};
+        const M b{static_cast<M>(transform.transpose())};
+        for (auto _ : state)
+        {
+            bench::do_not_optimize(a);
+            M r{a * b};
+            bench::do_not_optimize(r);
+        }
+    }
+
+    template <typename M>
+    void bm_inverse(bench::State &state)
+    {
+        M a{static_cast<M>(transform)};
+        for (auto _ : state)
+        {
+            bench::do_not_optimize(a);
+            M r{a.inverse()};
+            bench::do_not_optimize(r);
+        }
+    }
+
+    bool register_all()
+    {
+        for (const std::int64_t n : counts)
+        {
+            const std::string suffix{"/" + std::to_string(n)};
+            bench::register_benchmark("BM_Matrix4f_transform_points_member" + suffix, bm_points_member, {n});
+            bench::register_benchmark("BM_Matrix4f_transform_points_kernel" + suffix, bm_points_kernel, {n});
+            bench::register_benchmark("BM_Matrix4f_transform_vectors_member" + suffix, bm_vectors_member, {n});
+            bench::register_benchmark("BM_Matrix4f_transform_vectors_kernel" + suffix, bm_vectors_kernel, {n});
+        }
+        bench::register_benchmark("BM_Matrix4f_mul", bm_product<Matrix4f>);
+        bench::register_benchmark("BM_Matrix4d_mul", bm_product<Matrix4d>);
+        bench::register_benchmark("BM_Matrix4f_inverse", bm_inverse<Matrix4f>);
+        bench::register_benchmark("BM_Matrix4d_inverse", bm_inverse<Matrix4d>);
+        return true;
+    }
+
+    [[maybe_unused]] const bool registered = register_all();
+} // namespace
@@ -0,0 +1,117 @@
+#include <benchmark.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <thread_pool.hpp>
+#include <vector_parallel.hpp>
+
+/*
+ * Scaling of the parallel bulk operations on 4M Vector3d (96 MB) from one
+ * thread to one per hardware thread: BM_parallel_<op>/threads:<t>
+ */
+namespace
+{
+    constexpr std::size_t count{1 << 22};
+
+    std::vector<Vector3d> make_points()
+    {
+        std::vector<Vector3d> points;
+        points.reserve(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const double k{static_cast<double>(i)};
+            points.emplace_back(std::sin(k), 1.0 + k * 1e-6, 0.5 * static_cast<double>(i % 9));
+        }
+        return points;
+    }
+
+    // Shared by all benchmarks, built on first use
+    const std::vector<Vector3d> &points()
+    {
+        static const std::vector<Vector3d> p{make_points()};
+        return p;
+    }
+
+    void finish(bench::State &state, std::size_t bytes_per_item)
+    {
+        const auto processed{static_cast<std::int64_t>(state.iterations() * count)};
+        state.set_items_processed(processed);
+        state.set_bytes_processed(processed * static_cast<std::int64_t>(bytes_per_item));
+    }
+
+    void bm_sum(bench::State &state, vec::reduction mode)
+    {
+        const std::vector<Vector3d> &in{points()};
+        vec::ThreadPool pool(static_cast<std::size_t>(state.range(0)));
+        for (auto _ : state)
+        {
+            Vector3d s{vec::parallel_sum(in.data(), in.size(), mode, pool)};
+            bench::do_not_optimize(s);
+        }
+        finish(state, sizeof(Vector3d));
+    }
+
+    void bm_centroid(bench::State &state)
+    {
+        const std::vector<Vector3d> &in{points()};
+        vec::ThreadPool pool(static_cast<std::size_t>(state.range(0)));
+        for (auto _ : state)
+        {
+            Vector3d c{vec::parallel_centroid(in.data(), in.size(), vec::reduction::fast, pool)};
+            bench::do_not_optimize(c);
+        }
+        finish(state, sizeof(Vector3d));
+    }
+
+    void bm_bounds(bench::State &state)
+    {
+        const std::vector<Vector3d> &in{points()};
+        vec::ThreadPool pool(static_cast<std::size_t>(state.range(0)));
+        for (auto _ : state)
+        {
+            auto b{vec::parallel_bounds(in.data(), in.size(), pool)};
+            bench::do_not_optimize(b);
+        }
+        finish(state, sizeof(Vector3d));
+    }
+
+    void bm_normalize(bench::State &state)
+    {
+        const std::vector<Vector3d> &in{points()};
+        std::vector<Vector3d> out(in.size());
+        vec::ThreadPool pool(static_cast<std::size_t>(state.range(0)));
+        for (auto _ : state)
+        {
+            vec::parallel_normalize(in.data(), out.data(), in.size(), pool);
+            bench::clobber_memory();
+        }
+        finish(state, 2 * sizeof(Vector3d));
+    }
+
+    bool register_all()
+    {
+        // 1, 2, 4, ... and the hardware thread count
+        std::vector<std::int64_t> threads;
+        const auto hardware{static_cast<std::int64_t>(vec::ThreadPool::default_threads())};
+        for (std::int64_t t = 1; t < hardware; t *= 2)
+            threads.push_back(t);
+        threads.push_back(hardware);
+
+        for (const std::int64_t t : threads)
+        {
+            const std::string suffix{"/threads:" + std::to_string(t)};
+            bench::register_benchmark("BM_parallel_sum" + suffix, [](bench::State &s) { bm_sum(s, vec::reduction::fast); }, {t});
+            bench::register_benchmark("BM_parallel_sum_deterministic" + suffix,
+                                      [](bench::State &s) { bm_sum(s, vec::reduction::deterministic); }, {t});
+            bench::register_benchmark("BM_parallel_centroid" + suffix, bm_centroid, {t});
+            bench::register_benchmark("BM_parallel_bounds" + suffix, bm_bounds, {t});
+            bench::register_benchmark("BM_parallel_normalize" + suffix, bm_normalize, {t});
+        }
+        return true;
+    }
+
+    [[maybe_unused]] const bool registered = register_all();
+} // namespace
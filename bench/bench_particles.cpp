@@ -0,0 +1,105 @@
+#include <benchmark.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <particle_system.hpp>
+
+/*
+ * One integration step of 1M Vector3f particles (36 MB of state): the
+ * compound assignments over arrays of vectors (pos += vel * dt;
+ * vel += acc * dt) against the fused ParticleSystem steps, from one thread
+ * to one per hardware thread (BM_particles_<step>/threads:<t>). The field
+ * is gravity with linear drag. Items are particles.
+ */
+namespace
+{
+    constexpr std::size_t count{1 << 20};
+    constexpr float dt{0.001f};
+
+    const auto drag = [](const Vector3f &, const Vector3f &v, float) { return Vector3f(0, -9.81f, 0) - 0.1f * v; };
+
+    Vector3f start(std::size_t i)
+    {
+        const float k{static_cast<float>(i)};
+        return Vector3f(k * 1e-3f, 1.0f, -k * 1e-3f);
+    }
+
+    void finish(bench::State &state)
+    {
+        state.set_items_processed(static_cast<std::int64_t>(state.iterations() * count));
+    }
+
+    void bm_compound(bench::State &state)
+    {
+        std::vector<Vector3f> pos(count), vel(count), acc(count, Vector3f(0, -9.81f, 0));
+        for (std::size_t i = 0; i < count; ++i)
+            pos[i] = start(i);
+        for (auto _ : state)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                pos[i] += vel[i] * dt;
+                vel[i] += acc[i] * dt;
+            }
+            bench::clobber_memory();
+        }
+        finish(state);
+    }
+
+    vec::ParticleSystem<float> make_system()
+    {
+        vec::ParticleSystem<float> p;
+        p.reserve(count);
+        for (std::size_t i = 0; i < count; ++i)
+            p.add(start(i));
+        p.evaluate(drag);
+        return p;
+    }
+
+    template <typename Step>
+    void bm_step(bench::State &state, Step step)
+    {
+        vec::ParticleSystem<float> p{make_system()};
+        vec::ThreadPool pool(static_cast<std::size_t>(state.range(0)));
+        for (auto _ : state)
+        {
+            step(p, pool);
+            bench::clobber_memory();
+        }
+        finish(state);
+    }
+
+    bool register_all()
+    {
+        bench::register_benchmark("BM_particles_compound/threads:1", bm_compound);
+
+        // 1, 2, 4, ... and the hardware thread count
+        std::vector<std::int64_t> threads;
+        const auto hardware{static_cast<std::int64_t>(vec::ThreadPool::default_threads())};
+        for (std::int64_t t = 1; t < hardware; t *= 2)
+            threads.push_back(t);
+        threads.push_back(hardware);
+
+        for (const std::int64_t t : threads)
+        {
+            const std::string suffix{"/threads:" + std::to_string(t)};
+            bench::register_benchmark("BM_particles_euler" + suffix, [](bench::State &s)
+                                      { bm_step(s, [](vec::ParticleSystem<float> &p, vec::ThreadPool &pool)
+                                                { p.step_euler(dt, pool); }); }, {t});
+            bench::register_benchmark("BM_particles_euler_field" + suffix, [](bench::State &s)
+                                      { bm_step(s, [](vec::ParticleSystem<float> &p, vec::ThreadPool &pool)
+                                                { p.step_euler(dt, drag, pool); }); }, {t});
+            bench::register_benchmark("BM_particles_verlet" + suffix, [](bench::State &s)
+                                      { bm_step(s, [](vec::ParticleSystem<float> &p, vec::ThreadPool &pool)
+                                                { p.step_verlet(dt, drag, pool); }); }, {t});
+            bench::register_benchmark("BM_particles_rk4" + suffix, [](bench::State &s)
+                                      { bm_step(s, [](vec::ParticleSystem<float> &p, vec::ThreadPool &pool)
+                                                { p.step_rk4(dt, drag, pool); }); }, {t});
+        }
+        return true;
+    }
+
+    [[maybe_unused]] const bool registered = register_all();
+} // namespace
@@ -0,0 +1,88 @@
+#include <benchmark.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <quaternion.hpp>
+
+/*
+ * Rotating arrays of Vector3f: the quaternion's two-cross-product rotate()
+ * against the equivalent rotation matrix, per element and batched
+ * (rotate_many converts to the matrix once)
+ */
+namespace
+{
+    constexpr std::int64_t counts[] = {1 << 10, 1 << 14, 1 << 18, 1 << 22};
+
+    const Quaternionf rotation{Quaternionf(0.2f, -0.4f, 0.7f, 0.5f).normalize()};
+
+    std::vector<Vector3f> make_points(std::size_t n)
+    {
+        std::vector<Vector3f> points;
+        for (std::size_t i = 0; i < n; ++i)
+            points.emplace_back(0.5f + (i % 13), -1.0f - (i % 7), 2.0f + (i % 5));
+        return points;
+    }
+
+    void finish(bench::State &state, std::size_t n)
+    {
+        const auto processed{static_cast<std::int64_t>(state.iterations() * n)};
+        state.set_items_processed(processed);
+        state.set_bytes_processed(processed * static_cast<std::int64_t>(2 * sizeof(Vector3f)));
+    }
+
+    void bm_quaternion_member(bench::State &state)
+    {
+        const std::vector<Vector3f> in{make_points(static_cast<std::size_t>(state.range(0)))};
+        std::vector<Vector3f> out(in.size());
+        for (auto _ : state)
+        {
+            for (std::size_t i = 0; i < in.size(); ++i)
+                out[i] = rotation.rotate(in[i]);
+            bench::clobber_memory();
+        }
+        finish(state, in.size());
+    }
+
+    void bm_quaternion_kernel(bench::State &state)
+    {
+        const std::vector<Vector3f> in{make_points(static_cast<std::size_t>(state.range(0)))};
+        std::vector<Vector3f> out(in.size());
+        for (auto _ : state)
+        {
+            // Includes building the matrix on every call
+            vec::rotate_many(rotation, in.data(), out.data(), in.size());
+            bench::clobber_memory();
+        }
+        finish(state, in.size());
+    }
+
+    void bm_matrix_member(bench::State &state)
+    {
+        const std::vector<Vector3f> in{make_points(static_cast<std::size_t>(state.range(0)))};
+        std::vector<Vector3f> out(in.size());
+        const Matrix3f m{rotation.to_matrix3()};
+        for (auto _ : state)
+        {
+            for (std::size_t i = 0; i < in.size(); ++i)
+                out[i] = m * in[i];
+            bench::clobber_memory();
+        }
+        finish(state, in.size());
+    }
+
+    bool register_all()
+    {
+        for (const std::int64_t n : counts)
+        {
+            const std::string suffix{"/" + std::to_string(n)};
+            bench::register_benchmark("BM_Quaternionf_rotate_member" + suffix, bm_quaternion_member, {n});
+            bench::register_benchmark("BM_Quaternionf_rotate_kernel" + suffix, bm_quaternion_kernel, {n});
+            bench::register_benchmark("BM_Matrix3f_rotate_member" + suffix, bm_matrix_member, {n});
+        }
+        return true;
+    }
+
+    [[maybe_unused]] const bool registered = register_all();
+} // namespace
@@ -0,0 +1,102 @@
+#include <benchmark.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <vector_random.hpp>
+
+/*
+ * Random Vector3f: three std::uniform_real_distribution calls per vector
+ * on std::mt19937 (and a direction from them) against vec::generate at each
+ * instruction-set level the CPU supports. 64K vectors. Items are vectors.
+ */
+namespace
+{
+    constexpr std::size_t count{1 << 16};
+
+    template <typename D>
+    using generate_fn = vec::detail::kernel_fn<vec::Philox4x32 *, const D *, Vector3f *, std::size_t>;
+
+    void bm_std_box(bench::State &state)
+    {
+        std::mt19937 rng{1};
+        std::uniform_real_distribution<float> u(-1.0f, 1.0f);
+        std::vector<Vector3f> out(count);
+        for (auto _ : state)
+        {
+            for (Vector3f &v : out)
+            {
+                const float x{u(rng)};
+                const float y{u(rng)};
+                v = Vector3f(x, y, u(rng));
+            }
+            bench::clobber_memory();
+        }
+        state.set_items_processed(static_cast<std::int64_t>(state.iterations() * count));
+    }
+
+    // z uniform in [-1, 1), angle uniform in [0, 2 pi)
+    void bm_std_sphere(bench::State &state)
+    {
+        std::mt19937 rng{1};
+        std::uniform_real_distribution<float> u(-1.0f, 1.0f);
+        std::uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+        std::vector<Vector3f> out(count);
+        for (auto _ : state)
+        {
+            for (Vector3f &v : out)
+            {
+                const float z{u(rng)};
+                const float a{angle(rng)};
+                const float r{std::sqrt(1 - z * z)};
+                v = Vector3f(r * std::cos(a), r * std::sin(a), z);
+            }
+            bench::clobber_memory();
+        }
+        state.set_items_processed(static_cast<std::int64_t>(state.iterations() * count));
+    }
+
+    template <typename D>
+    void bm_generate(bench::State &state, generate_fn<D> f, D dist)
+    {
+        vec::Philox4x32 rng{1};
+        std::vector<Vector3f> out(count);
+        for (auto _ : state)
+        {
+            f(&rng, &dist, out.data(), count);
+            bench::clobber_memory();
+        }
+        state.set_items_processed(static_cast<std::int64_t>(state.iterations() * count));
+    }
+
+    template <typename D>
+    void register_levels(const std::string &name, D dist)
+    {
+        constexpr vec::simd_level levels[] = {vec::simd_level::baseline, vec::simd_level::sse4_2,
+                                              vec::simd_level::avx2, vec::simd_level::avx512};
+        for (const vec::simd_level level : levels)
+            if (level <= vec::detect_simd_level())
+            {
+                const generate_fn<D> f{vec::detail::kernel_for<vec::detail::generate_kernel, vec::Philox4x32 *,
+                                                               const D *, Vector3f *, std::size_t>(level)};
+                bench::register_benchmark(name + "/" + vec::simd_level_name(level),
+                                          [=](bench::State &s) { bm_generate(s, f, dist); });
+            }
+    }
+
+    bool register_all()
+    {
+        bench::register_benchmark("BM_random_box_Vector3f/std", bm_std_box);
+        register_levels("BM_random_box_Vector3f", vec::UniformBox<Vector3f>(Vector3f(-1, -1, -1), Vector3f(1, 1, 1)));
+        bench::register_benchmark("BM_random_sphere_Vector3f/std", bm_std_sphere);
+        register_levels("BM_random_sphere_Vector3f", vec::OnUnitSphere<Vector3f>{});
+        register_levels("BM_random_ball_Vector3f", vec::InUnitBall<Vector3f>{});
+        register_levels("BM_random_hemisphere_Vector3f", vec::CosineHemisphere<float>{});
+        return true;
+    }
+
+    [[maybe_unused]] const bool registered = register_all();
+} // namespace
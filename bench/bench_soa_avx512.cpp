@@ -0,0 +1,181 @@
+#include <benchmark.hpp>
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <vector_array.hpp>
+#include <vector_random.hpp>
+
+/*
+ * VectorArray kernels on Vector3f/Vector4f streams: the portable loops
+ * built for AVX2 (and for the baseline flags) against the sixteen-lane
+ * AVX-512 kernels with masked tails. 4K and 64K elements (streams in L2
+ * and in L3); rows are registered for the levels the CPU supports. Items
+ * are vectors.
+ */
+#if defined(VECTORS_DISPATCH)
+namespace
+{
+    constexpr std::int64_t counts[] = {1 << 12, 1 << 16};
+
+    using vec::detail::const_streams;
+    using vec::detail::streams;
+
+    template <std::size_t N>
+    using kernel_fn = vec::detail::kernel_fn<const_streams<float, N>, const_streams<float, N>, streams<float, N>,
+                                             float *, std::size_t>;
+
+    // r = a + b
+    template <bool Wide>
+    struct add_kernel
+    {
+        template <std::size_t N>
+        static void run(const_streams<float, N> a, const_streams<float, N> b, streams<float, N> r, float *,
+                        std::size_t n) noexcept
+        {
+            for (std::size_t c = 0; c < N; ++c)
+                if constexpr (Wide)
+                    vec::detail::soa_avx512::zip<vec::detail::plus_op>(a[c], b[c], r[c], n);
+                else
+                    vec::detail::soa_loop::zip(a[c], b[c], r[c], n, vec::detail::plus_op{});
+        }
+    };
+
+    // s = a.dot(b)
+    template <bool Wide>
+    struct dot_kernel
+    {
+        template <std::size_t N>
+        static void run(const_streams<float, N> a, const_streams<float, N> b, streams<float, N>, float *s,
+                        std::size_t n) noexcept
+        {
+            if constexpr (Wide)
+                vec::detail::soa_avx512::dot<N>(a, b, s, n);
+            else
+                vec::detail::soa_loop::dot(a, b, s, n, std::make_index_sequence<N>{});
+        }
+    };
+
+    // s = a.length()
+    template <bool Wide>
+    struct length_kernel
+    {
+        template <std::size_t N>
+        static void run(const_streams<float, N> a, const_streams<float, N>, streams<float, N>, float *s,
+                        std::size_t n) noexcept
+        {
+            if constexpr (Wide)
+                vec::detail::soa_avx512::norm_squared<N>(a, s, n, true);
+            else
+            {
+                vec::detail::soa_loop::norm_squared(a, s, n, std::make_index_sequence<N>{});
+                vec::detail::sqrt_block(s, n);
+            }
+        }
+    };
+
+    // r = a.normalize()
+    template <bool Wide>
+    struct normalize_kernel
+    {
+        template <std::size_t N>
+        static void run(const_streams<float, N> a, const_streams<float, N>, streams<float, N> r, float *,
+                        std::size_t n) noexcept
+        {
+            if constexpr (Wide)
+                vec::detail::soa_avx512::normalize<N>(a, r, n);
+            else
+                vec::detail::soa_loop::normalize(a, r, n);
+        }
+    };
+
+    // r = a.cross(b)
+    template <bool Wide>
+    struct cross_kernel
+    {
+        template <std::size_t N>
+        static void run(const_streams<float, N> a, const_streams<float, N> b, streams<float, N> r, float *,
+                        std::size_t n) noexcept
+        {
+            if constexpr (Wide)
+                vec::detail::soa_avx512::cross(a, b, r, n);
+            else
+                vec::detail::soa_loop::cross(a, b, r, n);
+        }
+    };
+
+    template <std::size_t N>
+    VectorArray<float, N> make_array(std::size_t n, std::uint64_t seed)
+    {
+        VectorArray<float, N> a{VectorArray<float, N>::uninitialized(n)};
+        vec::Philox4x32 rng{seed};
+        vec::generate(rng, vec::UniformBox<VectorN<float, N>>(-1.0f, 1.0f), a);
+        return a;
+    }
+
+    template <std::size_t N>
+    void bm_kernel(bench::State &state, kernel_fn<N> f)
+    {
+        const auto n{static_cast<std::size_t>(state.range(0))};
+        const VectorArray<float, N> a{make_array<N>(n, 1)};
+        const VectorArray<float, N> b{make_array<N>(n, 2)};
+        VectorArray<float, N> r{VectorArray<float, N>::uninitialized(n)};
+        std::vector<float> s(n);
+        const_streams<float, N> sa, sb;
+        streams<float, N> sr;
+        for (std::size_t c = 0; c < N; ++c)
+        {
+            sa[c] = a.data(c);
+            sb[c] = b.data(c);
+            sr[c] = r.data(c);
+        }
+        for (auto _ : state)
+        {
+            f(sa, sb, sr, s.data(), n);
+            bench::clobber_memory();
+        }
+        state.set_items_processed(static_cast<std::int64_t>(state.iterations() * n));
+    }
+
+    // Kernel K built for a level
+    template <std::size_t N, typename K>
+    kernel_fn<N> kernel_at(vec::simd_level level)
+    {
+        return vec::detail::kernel_for<K, const_streams<float, N>, const_streams<float, N>, streams<float, N>, float *,
+                                       std::size_t>(level);
+    }
+
+    // Portable loop at the baseline and AVX2 levels, then the AVX-512 kernel, as far as the CPU goes
+    template <std::size_t N, template <bool> typename K>
+    void register_kernel(const std::string &name)
+    {
+        const vec::simd_level cpu{vec::detect_simd_level()};
+        const std::pair<const char *, kernel_fn<N>> paths[] = {
+            {"baseline", kernel_at<N, K<false>>(vec::simd_level::baseline)},
+            {"avx2", cpu >= vec::simd_level::avx2 ? kernel_at<N, K<false>>(vec::simd_level::avx2) : nullptr},
+            {"avx512", cpu >= vec::simd_level::avx512 ? kernel_at<N, K<true>>(vec::simd_level::baseline) : nullptr}};
+        for (const std::int64_t n : counts)
+            for (const auto &[path, f] : paths)
+                if (f)
+                    bench::register_benchmark(name + "/" + path + "/" + std::to_string(n),
+                                              [f = f](bench::State &s) { bm_kernel<N>(s, f); }, {n});
+    }
+
+    bool register_all()
+    {
+        register_kernel<3, add_kernel>("BM_soa_add_Vector3f");
+        register_kernel<4, add_kernel>("BM_soa_add_Vector4f");
+        register_kernel<3, dot_kernel>("BM_soa_dot_Vector3f");
+        register_kernel<4, dot_kernel>("BM_soa_dot_Vector4f");
+        register_kernel<3, length_kernel>("BM_soa_length_Vector3f");
+        register_kernel<3, normalize_kernel>("BM_soa_normalize_Vector3f");
+        register_kernel<4, normalize_kernel>("BM_soa_normalize_Vector4f");
+        register_kernel<3, cross_kernel>("BM_soa_cross_Vector3f");
+        return true;
+    }
+
+    [[maybe_unused]] const bool registered = register_all();
+} // namespace
+#endif
@@ -0,0 +1,142 @@
+#include <benchmark.hpp>
+
+#include <cstdint>
+#include <vector>
+
+#include <spatial_index.hpp>
+#include <vector_random.hpp>
+
+/*
+ * 8 nearest neighbours of 1K queries among 100K Vector3d uniform in the
+ * unit cube: brute force over (a - b).norm_squared() against KdTree and
+ * HashGrid (cells of 0.05, about 12 points per cell), one query at a time
+ * and batched on the global pool. Items are queries; the build rows count
+ * points.
+ */
+namespace
+{
+    constexpr std::size_t count{100000};
+    constexpr std::size_t query_count{1000};
+    constexpr std::size_t k{8};
+
+    std::vector<Vector3d> make_points(std::size_t n, std::uint64_t seed)
+    {
+        std::vector<Vector3d> points(n);
+        vec::Philox4x32 rng{seed};
+        vec::generate(rng, vec::UniformBox<Vector3d>(0.0, 1.0), points.data(), n);
+        return points;
+    }
+
+    const std::vector<Vector3d> &points()
+    {
+        static const std::vector<Vector3d> p{make_points(count, 1)};
+        return p;
+    }
+
+    const std::vector<Vector3d> &queries()
+    {
+        static const std::vector<Vector3d> q{make_points(query_count, 2)};
+        return q;
+    }
+
+    const vec::KdTree<Vector3d> &tree()
+    {
+        static const vec::KdTree<Vector3d> t(points().data(), points().size());
+        return t;
+    }
+
+    vec::HashGrid<Vector3d> make_grid()
+    {
+        vec::HashGrid<Vector3d> grid(0.05);
+        for (const Vector3d &p : points())
+            grid.insert(p);
+        return grid;
+    }
+
+    const vec::HashGrid<Vector3d> &grid()
+    {
+        static const vec::HashGrid<Vector3d> g{make_grid()};
+        return g;
+    }
+
+    void finish(bench::State &state, std::size_t items)
+    {
+        state.set_items_processed(static_cast<std::int64_t>(state.iterations() * items));
+    }
+
+    void bm_brute_force(bench::State &state)
+    {
+        std::vector<vec::Neighbor<double>> found;
+        for (auto _ : state)
+        {
+            for (const Vector3d &q : queries())
+            {
+                vec::detail::nearest_heap<double> heap(k, found);
+                for (std::size_t i = 0; i < count; ++i)
+                    heap.push(i, (points()[i] - q).norm_squared());
+                heap.finish();
+                bench::do_not_optimize(found);
+            }
+        }
+        finish(state, query_count);
+    }
+
+    template <typename Index>
+    void bm_knn(bench::State &state, const Index &index)
+    {
+        std::vector<vec::Neighbor<double>> found;
+        for (auto _ : state)
+            for (const Vector3d &q : queries())
+            {
+                index.knn(q, k, found);
+                bench::do_not_optimize(found);
+            }
+        finish(state, query_count);
+    }
+
+    template <typename Index>
+    void bm_knn_many(bench::State &state, const Index &index)
+    {
+        std::vector<vec::Neighbor<double>> found(query_count * k);
+        for (auto _ : state)
+        {
+            index.knn_many(queries().data(), query_count, k, found.data());
+            bench::do_not_optimize(found);
+        }
+        finish(state, query_count);
+    }
+
+    void bm_kd_tree_build(bench::State &state)
+    {
+        for (auto _ : state)
+        {
+            vec::KdTree<Vector3d> t(points().data(), points().size());
+            bench::do_not_optimize(t);
+        }
+        finish(state, count);
+    }
+
+    void bm_hash_grid_build(bench::State &state)
+    {
+        for (auto _ : state)
+        {
+            vec::HashGrid<Vector3d> g{make_grid()};
+            bench::do_not_optimize(g);
+        }
+        finish(state, count);
+    }
+
+    bool register_all()
+    {
+        bench::register_benchmark("BM_knn_brute_force", bm_brute_force);
+        bench::register_benchmark("BM_knn_kd_tree", [](bench::State &s) { bm_knn(s, tree()); });
+        bench::register_benchmark("BM_knn_hash_grid", [](bench::State &s) { bm_knn(s, grid()); });
+        bench::register_benchmark("BM_knn_many_kd_tree", [](bench::State &s) { bm_knn_many(s, tree()); });
+        bench::register_benchmark("BM_knn_many_hash_grid", [](bench::State &s) { bm_knn_many(s, grid()); });
+        bench::register_benchmark("BM_kd_tree_build", bm_kd_tree_build);
+        bench::register_benchmark("BM_hash_grid_build", bm_hash_grid_build);
+        return true;
+    }
+
+    [[maybe_unused]] const bool registered = register_all();
+} // namespace
@@ -0,0 +1,191 @@
+#include <benchmark.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <vector_traits.hpp>
+
+/*
+ * Every operator and member function of Vector2/3/4 for int, float and double,
+ * of the padded Vector3A and of VectorN<float, 8> / VectorN<float, 16>
+ *
+ * <op>/single        one call on values the compiler cannot constant-fold
+ * <op>/bulk/<level>  out[i] = op(a[i], b[i]) over arrays whose combined size
+ *                    fits the named cache level (or spills to DRAM)
+ */
+namespace
+{
+    constexpr std::int64_t working_sets[] = {16 << 10, 256 << 10, 8 << 20, 128 << 20};
+    constexpr const char *working_set_names[] = {"L1", "L2", "L3", "DRAM"};
+
+    template <typename V>
+    constexpr bool is_padded = std::is_same_v<V, Vector3A<vec::detail::scalar_t<V>>>;
+
+    template <typename V>
+    std::string vector_name()
+    {
+        using T = vec::detail::scalar_t<V>;
+        const char suffix{std::is_same_v<T, int> ? 'i' : std::is_same_v<T, float> ? 'f'
+                                                                                   : 'd'};
+        return "Vector" + std::to_string(vec::detail::vector_traits<V>::size) + (is_padded<V> ? "A" : "") + suffix;
+    }
+
+    // Deterministic, non-zero components
+    template <typename V>
+    V make_value(std::size_t i)
+    {
+        using T = vec::detail::scalar_t<V>;
+        V v;
+        for (std::size_t c = 0; c < vec::detail::vector_traits<V>::size; ++c)
+            v[c] = static_cast<T>(1 + (i + c) % 7);
+        return v;
+    }
+
+    template <typename V>
+    constexpr bool is_floating = std::is_floating_point_v<vec::detail::scalar_t<V>>;
+
+    template <typename V>
+    constexpr bool is_3d = vec::detail::vector_traits<V>::size == 3;
+
+    // Operations: name, applicability and a call taking two vectors
+    namespace ops
+    {
+#define VECTORS_BENCH_OP(op_name, condition, ...)                        \
+        struct op_name                                                   \
+        {                                                                \
+            static constexpr const char *name = #op_name;                \
+            template <typename V>                                        \
+            static constexpr bool supported = condition;                 \
+            template <typename V>                                        \
+            static auto apply(const V &a, const V &b)                    \
+            {                                                            \
+                [[maybe_unused]] const vec::detail::scalar_t<V> s{b[0]}; \
+                return __VA_ARGS__;                                      \
+            }                                                            \
+        }
+
+        VECTORS_BENCH_OP(add, true, a + b);
+        VECTORS_BENCH_OP(sub, true, a - b);
+        VECTORS_BENCH_OP(mul, true, a * b);
+        VECTORS_BENCH_OP(div, true, a / b);
+        VECTORS_BENCH_OP(add_scalar, true, a + s);
+        VECTORS_BENCH_OP(sub_scalar, true, a - s);
+        VECTORS_BENCH_OP(mul_scalar, true, a * s);
+        VECTORS_BENCH_OP(div_scalar, true, a / s);
+        VECTORS_BENCH_OP(scalar_mul, true, s * a);
+        VECTORS_BENCH_OP(neg, true, -a);
+        VECTORS_BENCH_OP(add_assign, true, V(a) += b);
+        VECTORS_BENCH_OP(sub_assign, true, V(a) -= b);
+        VECTORS_BENCH_OP(mul_assign, true, V(a) *= b);
+        VECTORS_BENCH_OP(div_assign, true, V(a) /= b);
+        VECTORS_BENCH_OP(add_assign_scalar, true, V(a) += s);
+        VECTORS_BENCH_OP(sub_assign_scalar, true, V(a) -= s);
+        VECTORS_BENCH_OP(mul_assign_scalar, true, V(a) *= s);
+        VECTORS_BENCH_OP(div_assign_scalar, true, V(a) /= s);
+        VECTORS_BENCH_OP(equal, true, a == b);
+        VECTORS_BENCH_OP(dot, true, a.dot(b));
+        VECTORS_BENCH_OP(dot_fma, is_floating<V>, a.dot_fma(b));
+        VECTORS_BENCH_OP(cross, is_3d<V>, a.cross(b));
+        VECTORS_BENCH_OP(cross_fma, is_3d<V> && is_floating<V>, a.cross_fma(b));
+        VECTORS_BENCH_OP(norm, true, a.norm());
+        VECTORS_BENCH_OP(norm_double, is_floating<V>, a.template norm<double>());
+        VECTORS_BENCH_OP(length, true, a.length());
+        VECTORS_BENCH_OP(norm_squared, true, a.norm_squared());
+        VECTORS_BENCH_OP(normSquared, true, a.normSquared());
+        VECTORS_BENCH_OP(norm_squared_fma, is_floating<V>, a.norm_squared_fma());
+        VECTORS_BENCH_OP(normalize, true, a.normalize());
+        VECTORS_BENCH_OP(normalize_double, is_floating<V>, a.template normalize<double>());
+        VECTORS_BENCH_OP(normalize_fast, is_floating<V>, a.normalize_fast());
+        VECTORS_BENCH_OP(inv_norm_fast, is_floating<V>, a.inv_norm_fast());
+        VECTORS_BENCH_OP(sign, true, a.sign());
+        VECTORS_BENCH_OP(pow, true, a.pow(2));
+        VECTORS_BENCH_OP(convert, !is_padded<V>, static_cast<vec::detail::vector_of_t<double, vec::detail::vector_traits<V>::size>>(a));
+
+#undef VECTORS_BENCH_OP
+    } // namespace ops
+
+    template <typename V, typename Op>
+    void bm_single(bench::State &state)
+    {
+        V a{make_value<V>(1)};
+        V b{make_value<V>(2)};
+        for (auto _ : state)
+        {
+            bench::do_not_optimize(a);
+            bench::do_not_optimize(b);
+            auto r = Op::apply(a, b);
+            bench::do_not_optimize(r);
+        }
+        state.set_items_processed(static_cast<std::int64_t>(state.iterations()));
+    }
+
+    template <typename V, typename Op>
+    void bm_bulk(bench::State &state)
+    {
+        using R = decltype(Op::apply(std::declval<V>(), std::declval<V>()));
+        constexpr std::size_t bytes_per_element{2 * sizeof(V) + sizeof(R)};
+        const std::size_t n{static_cast<std::size_t>(state.range(0)) / bytes_per_element};
+
+        std::vector<V> a;
+        std::vector<V> b;
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            a.push_back(make_value<V>(i));
+            b.push_back(make_value<V>(i + 3));
+        }
+        const std::unique_ptr<R[]> out{new R[n]};
+
+        for (auto _ : state)
+        {
+            for (std::size_t i = 0; i < n; ++i)
+                out[i] = Op::apply(a[i], b[i]);
+            bench::clobber_memory();
+        }
+        const auto processed{static_cast<std::int64_t>(state.iterations() * n)};
+        state.set_items_processed(processed);
+        state.set_bytes_processed(processed * static_cast<std::int64_t>(bytes_per_element));
+    }
+
+    template <typename V, typename Op>
+    void register_op()
+    {
+        if constexpr (Op::template supported<V>)
+        {
+            const std::string base{"BM_" + vector_name<V>() + "_" + Op::name};
+            bench::register_benchmark(base + "/single", bm_single<V, Op>);
+            for (std::size_t k = 0; k < std::size(working_sets); ++k)
+                bench::register_benchmark(base + "/bulk/" + working_set_names[k], bm_bulk<V, Op>, {working_sets[k]});
+        }
+    }
+
+    template <typename... Ops>
+    bool register_all()
+    {
+        (register_op<Vector2i, Ops>(), ...);
+        (register_op<Vector2f, Ops>(), ...);
+        (register_op<Vector2d, Ops>(), ...);
+        (register_op<Vector3i, Ops>(), ...);
+        (register_op<Vector3f, Ops>(), ...);
+        (register_op<Vector3d, Ops>(), ...);
+        (register_op<Vector3Ai, Ops>(), ...);
+        (register_op<Vector3Af, Ops>(), ...);
+        (register_op<Vector3Ad, Ops>(), ...);
+        (register_op<Vector4i, Ops>(), ...);
+        (register_op<Vector4f, Ops>(), ...);
+        (register_op<Vector4d, Ops>(), ...);
+        (register_op<VectorN<float, 8>, Ops>(), ...);
+        (register_op<VectorN<float, 16>, Ops>(), ...);
+        return true;
+    }
+
+    [[maybe_unused]] const bool registered = register_all<
+        ops::add, ops::sub, ops::mul, ops::div, ops::add_scalar, ops::sub_scalar, ops::mul_scalar, ops::div_scalar,
+        ops::scalar_mul, ops::neg, ops::add_assign, ops::sub_assign, ops::mul_assign, ops::div_assign,
+        ops::add_assign_scalar, ops::sub_assign_scalar, ops::mul_assign_scalar, ops::div_assign_scalar,
+        ops::equal, ops::dot, ops::dot_fma, ops::cross, ops::cross_fma, ops::norm, ops::norm_double, ops::length,
+        ops::norm_squared, ops::normSquared, ops::norm_squared_fma, ops::normalize, ops::normalize_double,
+        ops::normalize_fast, ops::inv_norm_fast, ops::sign, ops::pow, ops::convert>();
+} // namespace
@@ -0,0 +1,397 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+#include <simd.hpp>
+
+/*
+ * Minimal Google-Benchmark-style harness
+ *
+ * Benchmarks are functions taking a State and timing a `for (auto _ : state)`
+ * loop. The runner grows the iteration count until a run lasts at least
+ * --benchmark_min_time seconds and reports time per iteration. The JSON
+ * output follows the Google Benchmark schema, so its compare.py tooling can
+ * diff two runs.
+ *
+ * Flags: --benchmark_filter=<regex> --benchmark_min_time=<seconds>
+ *        --benchmark_format=<console|json> --benchmark_out=<file.json>
+ *        --benchmark_list_tests
+ */
+namespace bench
+{
+    // Prevent the compiler from optimizing a value away or assuming it is unchanged
+    template <typename T>
+    inline void do_not_optimize(T &value)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : "+m"(value) : : "memory");
+#else
+        static volatile const void *sink;
+        sink = &value;
+        _ReadWriteBarrier();
+#endif
+    }
+
+    template <typename T>
+    inline void do_not_optimize(const T &value)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "m"(value) : "memory");
+#else
+        static volatile const void *sink;
+        sink = &value;
+        _ReadWriteBarrier();
+#endif
+    }
+
+    // Force pending memory writes to be considered observable
+    inline void clobber_memory()
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : : "memory");
+#else
+        _ReadWriteBarrier();
+#endif
+    }
+
+    /**
+     * @brief Iteration state of one benchmark run
+     */
+    class State
+    {
+    public:
+        State(std::uint64_t iterations, std::vector<std::int64_t> args, int threads = 1)
+            : iterations_(iterations), args_(std::move(args)), threads_(threads) {}
+
+        class iterator
+        {
+        public:
+            // Loop variable type, marked so `for (auto _ : state)` does not warn
+            struct [[maybe_unused]] value
+            {
+            };
+
+            iterator(State *state, std::uint64_t remaining) noexcept : state_(state), remaining_(remaining) {}
+
+            bool operator!=(const iterator &) noexcept
+            {
+                if (remaining_ != 0)
+                    return true;
+                state_->stop_timer();
+                return false;
+            }
+            void operator++() noexcept { --remaining_; }
+            value operator*() const noexcept { return {}; }
+
+        private:
+            State *state_;
+            std::uint64_t remaining_;
+        };
+
+        iterator begin()
+        {
+            start_timer();
+            return iterator(this, iterations_);
+        }
+        iterator end() { return iterator(this, 0); }
+
+        // Exclude a section of the loop body from the measurement
+        void pause_timing() { stop_timer(); }
+        void resume_timing() { start_timer(); }
+
+        [[nodiscard]] std::int64_t range(std::size_t i = 0) const { return args_.at(i); }
+        [[nodiscard]] std::uint64_t iterations() const noexcept { return iterations_; }
+        [[nodiscard]] int threads() const noexcept { return threads_; }
+
+        void set_items_processed(std::int64_t items) noexcept { items_ = items; }
+        void set_bytes_processed(std::int64_t bytes) noexcept { bytes_ = bytes; }
+        void set_label(std::string label) { label_ = std::move(label); }
+
+        // Custom counter reported next to the timings
+        void set_counter(const std::string &name, double value) { counters_.emplace_back(name, value); }
+
+        [[nodiscard]] double real_seconds() const noexcept { return real_; }
+        [[nodiscard]] double cpu_seconds() const noexcept { return cpu_; }
+        [[nodiscard]] std::int64_t items_processed() const noexcept { return items_; }
+        [[nodiscard]] std::int64_t bytes_processed() const noexcept { return bytes_; }
+        [[nodiscard]] const std::string &label() const noexcept { return label_; }
+        [[nodiscard]] const std::vector<std::pair<std::string, double>> &counters() const noexcept { return counters_; }
+
+    private:
+        void start_timer()
+        {
+            running_ = true;
+            real_start_ = std::chrono::steady_clock::now();
+            cpu_start_ = std::clock();
+        }
+
+        void stop_timer()
+        {
+            if (!running_)
+                return;
+            running_ = false;
+            real_ += std::chrono::duration<double>(std::chrono::steady_clock::now() - real_start_).count();
+            cpu_ += static_cast<double>(std::clock() - cpu_start_) / CLOCKS_PER_SEC;
+        }
+
+        std::uint64_t iterations_;
+        std::vector<std::int64_t> args_;
+        int threads_;
+        bool running_{false};
+        std::chrono::steady_clock::time_point real_start_{};
+        std::clock_t cpu_start_{};
+        double real_{0.0};
+        double cpu_{0.0};
+        std::int64_t items_{0};
+        std::int64_t bytes_{0};
+        std::string label_{};
+        std::vector<std::pair<std::string, double>> counters_{};
+    };
+
+    struct Benchmark
+    {
+        std::string name;
+        std::function<void(State &)> fn;
+        std::vector<std::int64_t> args;
+    };
+
+    inline std::vector<Benchmark> &registry()
+    {
+        static std::vector<Benchmark> benchmarks;
+        return benchmarks;
+    }
+
+    inline bool register_benchmark(std::string name, std::function<void(State &)> fn, std::vector<std::int64_t> args = {})
+    {
+        registry().push_back({std::move(name), std::move(fn), std::move(args)});
+        return true;
+    }
+
+    // Register a plain function under its own name
+#define BENCHMARK(fn) static const bool fn##_registered = ::bench::register_benchmark(#fn, fn)
+
+    namespace detail
+    {
+        struct Result
+        {
+            std::string name;
+            std::uint64_t iterations;
+            double real_ns;
+            double cpu_ns;
+            double items_per_second;
+            double bytes_per_second;
+            std::string label;
+            std::vector<std::pair<std::string, double>> counters;
+        };
+
+        inline std::string json_escape(const std::string &s)
+        {
+            std::string out;
+            for (const char c : s)
+            {
+                if (c == '"' || c == '\\')
+                    out += '\\';
+                out += c;
+            }
+            return out;
+        }
+
+        inline std::string simd_backend()
+        {
+#if defined(VECTORS_SIMD_AVX)
+            return "avx";
+#elif defined(VECTORS_SIMD_SSE2)
+            return "sse2";
+#else
+            return "scalar";
+#endif
+        }
+
+        inline void write_json(std::ostream &os, const std::vector<Result> &results, const char *executable)
+        {
+            char date[64]{};
+            const std::time_t now{std::time(nullptr)};
+            std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+            os << "{\n  \"context\": {\n";
+            os << "    \"date\": \"" << date << "\",\n";
+            os << "    \"executable\": \"" << json_escape(executable) << "\",\n";
+            os << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n";
+            os << "    \"vectors_simd\": \"" << simd_backend() << "\",\n";
+#if defined(NDEBUG)
+            os << "    \"library_build_type\": \"release\"\n";
+#else
+            os << "    \"library_build_type\": \"debug\"\n";
+#endif
+            os << "  },\n  \"benchmarks\": [\n";
+            for (std::size_t i = 0; i < results.size(); ++i)
+            {
+                const Result &r{results[i]};
+                os << "    {\n";
+                os << "      \"name\": \"" << json_escape(r.name) << "\",\n";
+                os << "      \"run_name\": \"" << json_escape(r.name) << "\",\n";
+                os << "      \"run_type\": \"iteration\",\n";
+                os << "      \"iterations\": " << r.iterations << ",\n";
+                os << "      \"real_time\": " << r.real_ns << ",\n";
+                os << "      \"cpu_time\": " << r.cpu_ns << ",\n";
+                os << "      \"time_unit\": \"ns\"";
+                if (r.items_per_second > 0)
+                    os << ",\n      \"items_per_second\": " << r.items_per_second;
+                if (r.bytes_per_second > 0)
+                    os << ",\n      \"bytes_per_second\": " << r.bytes_per_second;
+                for (const auto &[name, value] : r.counters)
+                    os << ",\n      \"" << json_escape(name) << "\": " << value;
+                if (!r.label.empty())
+                    os << ",\n      \"label\": \"" << json_escape(r.label) << "\"";
+                os << "\n    }" << (i + 1 < results.size() ? "," : "") << "\n";
+            }
+            os << "  ]\n}\n";
+        }
+
+        inline std::string human(double value, const char *unit)
+        {
+            const char *prefixes[] = {"", "k", "M", "G", "T"};
+            int p{0};
+            while (value >= 1000.0 && p < 4)
+            {
+                value /= 1000.0;
+                ++p;
+            }
+            char buf[64];
+            std::snprintf(buf, sizeof(buf), "%.3g%s%s", value, prefixes[p], unit);
+            return buf;
+        }
+
+        inline void print_console(const Result &r)
+        {
+            std::printf("%-52s %12.2f ns %12.2f ns %12llu", r.name.c_str(), r.real_ns, r.cpu_ns,
+                        static_cast<unsigned long long>(r.iterations));
+            if (r.items_per_second > 0)
+                std::printf(" items/s=%s", human(r.items_per_second, "").c_str());
+            if (r.bytes_per_second > 0)
+                std::printf(" bytes/s=%s", human(r.bytes_per_second, "B").c_str());
+            for (const auto &[name, value] : r.counters)
+                std::printf(" %s=%s", name.c_str(), human(value, "").c_str());
+            if (!r.label.empty())
+                std::printf(" %s", r.label.c_str());
+            std::printf("\n");
+            std::fflush(stdout);
+        }
+
+        inline Result run_one(const Benchmark &b, double min_time)
+        {
+            std::uint64_t iterations{1};
+            for (;;)
+            {
+                State state(iterations, b.args);
+                b.fn(state);
+                const double elapsed{state.real_seconds()};
+                if (elapsed >= min_time || iterations >= 1000000000ULL)
+                {
+                    const double seconds{elapsed > 0 ? elapsed : 1e-9};
+                    return {b.name,
+                            iterations,
+                            elapsed * 1e9 / static_cast<double>(iterations),
+                            state.cpu_seconds() * 1e9 / static_cast<double>(iterations),
+                            static_cast<double>(state.items_processed()) / seconds,
+                            static_cast<double>(state.bytes_processed()) / seconds,
+                            state.label(),
+                            state.counters()};
+                }
+                // Aim slightly past min_time, growing at most 10x per attempt
+                const double scale{elapsed > 0 ? 1.4 * min_time / elapsed : 10.0};
+                iterations = static_cast<std::uint64_t>(static_cast<double>(iterations) * (scale < 10.0 ? scale : 10.0)) + 1;
+            }
+        }
+
+        inline bool flag(const char *arg, const char *name, std::string &value)
+        {
+            const std::size_t n{std::strlen(name)};
+            if (std::strncmp(arg, name, n) != 0 || arg[n] != '=')
+                return false;
+            value = arg + n + 1;
+            return true;
+        }
+    } // namespace detail
+
+    // Run the registered benchmarks selected by the command line
+    inline int run(int argc, char **argv)
+    {
+        std::string filter{".*"};
+        std::string format{"console"};
+        std::string out_path{};
+        double min_time{0.1};
+        bool list_only{false};
+
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string value;
+            if (detail::flag(argv[i], "--benchmark_filter", value))
+                filter = value;
+            else if (detail::flag(argv[i], "--benchmark_min_time", value))
+                min_time = std::stod(value);
+            else if (detail::flag(argv[i], "--benchmark_format", value))
+                format = value;
+            else if (detail::flag(argv[i], "--benchmark_out", value))
+                out_path = value;
+            else if (std::strcmp(argv[i], "--benchmark_list_tests") == 0)
+                list_only = true;
+            else
+            {
+                std::fprintf(stderr, "unknown argument: %s\n", argv[i]);
+                return 1;
+            }
+        }
+
+        const std::regex selected{filter};
+        std::vector<detail::Result> results;
+        const bool console{format != "json"};
+        if (console && !list_only)
+            std::printf("%-52s %15s %15s %12s\n", "Benchmark", "Time", "CPU", "Iterations");
+
+        for (const Benchmark &b : registry())
+        {
+            if (!std::regex_search(b.name, selected))
+                continue;
+            if (list_only)
+            {
+                std::printf("%s\n", b.name.c_str());
+                continue;
+            }
+            results.push_back(detail::run_one(b, min_time));
+            if (console)
+                detail::print_console(results.back());
+        }
+
+        if (!console)
+            detail::write_json(std::cout, results, argv[0]);
+        if (!out_path.empty())
+        {
+            std::ofstream file{out_path};
+            if (!file)
+            {
+                std::fprintf(stderr, "cannot open %s\n", out_path.c_str());
+                return 1;
+            }
+            detail::write_json(file, results, argv[0]);
+        }
+        return 0;
+    }
+} // namespace bench
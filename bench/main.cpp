@@ -0,0 +1,7 @@
+#include <benchmark.hpp>
+
+// Runs every benchmark registered by the bench_*.cpp files
+int main(int argc, char **argv)
+{
+    return bench::run(argc, argv);
+}
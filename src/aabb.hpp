@@ -0,0 +1,224 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iostream>
+#include <limits>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include "simd.hpp"
+#include "vector_kernels.hpp"
+#include "vector_traits.hpp"
+
+namespace vec::detail
+{
+    // Corners of an empty box: merging anything into it yields that thing
+    template <typename T>
+    constexpr T empty_min() noexcept
+    {
+        return std::numeric_limits<T>::has_infinity ? std::numeric_limits<T>::infinity() : std::numeric_limits<T>::max();
+    }
+
+    template <typename T>
+    constexpr T empty_max() noexcept
+    {
+        return std::numeric_limits<T>::has_infinity ? -std::numeric_limits<T>::infinity() : std::numeric_limits<T>::lowest();
+    }
+
+    // a[c] <= b[c] for every component
+    template <typename V>
+    constexpr bool all_less_equal(const V &a, const V &b) noexcept
+    {
+        for (std::size_t c = 0; c < vector_traits<V>::size; ++c)
+            if (!(a[c] <= b[c]))
+                return false;
+        return true;
+    }
+} // namespace vec::detail
+
+/**
+ * @brief Axis-aligned bounding box [min, max] of Vector2/3/4 or Vector3A
+ *
+ * Default-constructed boxes are empty (min above max), so merging points
+ * into one grows it from nothing. Merging uses the component-wise min/max
+ * members, which ignore NaN components of the merged point.
+ */
+template <typename V>
+class AABB
+{
+public:
+    using vector_type = V;
+    using value_type = vec::detail::scalar_t<V>;
+
+    // Constructors (default: empty box)
+    explicit constexpr AABB() noexcept
+        : min_(splat(vec::detail::empty_min<value_type>())), max_(splat(vec::detail::empty_max<value_type>()))
+    {
+    }
+    explicit constexpr AABB(const V &min, const V &max) noexcept : min_(min), max_(max) {}
+    explicit constexpr AABB(const V &point) noexcept : min_(point), max_(point) {}
+
+    // Corners
+    [[nodiscard]] constexpr const V &min() const noexcept { return min_; }
+    [[nodiscard]] constexpr const V &max() const noexcept { return max_; }
+
+    // True when no point is inside (some min component above max)
+    [[nodiscard]] constexpr bool empty() const noexcept { return !vec::detail::all_less_equal(min_, max_); }
+
+    [[nodiscard]] constexpr V center() const noexcept { return (min_ + max_) / static_cast<value_type>(2); }
+    [[nodiscard]] constexpr V extent() const noexcept { return max_ - min_; }
+
+    // Comparison
+    constexpr bool operator==(const AABB &o) const noexcept { return min_ == o.min_ && max_ == o.max_; }
+    constexpr bool operator!=(const AABB &o) const noexcept { return !(*this == o); }
+
+    // Grow to include a point or another box
+    constexpr AABB &merge(const V &point) noexcept
+    {
+        min_ = min_.min(point);
+        max_ = max_.max(point);
+        return *this;
+    }
+    constexpr AABB &merge(const AABB &o) noexcept
+    {
+        min_ = min_.min(o.min_);
+        max_ = max_.max(o.max_);
+        return *this;
+    }
+
+    // Containment and overlap, boundaries included
+    [[nodiscard]] constexpr bool contains(const V &point) const noexcept
+    {
+        return vec::detail::all_less_equal(min_, point) && vec::detail::all_less_equal(point, max_);
+    }
+    [[nodiscard]] constexpr bool contains(const AABB &o) const noexcept
+    {
+        return vec::detail::all_less_equal(min_, o.min_) && vec::detail::all_less_equal(o.max_, max_);
+    }
+    [[nodiscard]] constexpr bool intersects(const AABB &o) const noexcept
+    {
+        return vec::detail::all_less_equal(min_, o.max_) && vec::detail::all_less_equal(o.min_, max_);
+    }
+
+    /**
+     * @brief Entry and exit distances of the ray origin + t * direction
+     *
+     * Slab test over t in [0, t_max], given 1 / direction per component
+     * (infinite for axis-parallel rays). Returns nullopt on a miss; a ray
+     * starting inside enters at 0. Rays lying in the plane of a face count
+     * as hitting it.
+     */
+    [[nodiscard]] constexpr std::optional<std::pair<value_type, value_type>> intersect(
+        const V &origin, const V &inv_direction,
+        value_type t_max = std::numeric_limits<value_type>::infinity()) const noexcept
+    {
+        static_assert(std::is_floating_point_v<value_type>, "ray intersection requires floating-point vectors");
+        const V t0{(min_ - origin) * inv_direction};
+        const V t1{(max_ - origin) * inv_direction};
+
+        value_type enter{0};
+        value_type exit{t_max};
+        for (std::size_t c = 0; c < vec::detail::vector_traits<V>::size; ++c)
+        {
+            // 0 * inf: the ray lies in the plane of a face, inside that slab
+            if (t0[c] != t0[c] || t1[c] != t1[c])
+                continue;
+            enter = std::max(enter, std::min(t0[c], t1[c]));
+            exit = std::min(exit, std::max(t0[c], t1[c]));
+        }
+        if (!(enter <= exit))
+            return std::nullopt;
+        return std::make_pair(enter, exit);
+    }
+
+    friend std::ostream &operator<<(std::ostream &os, const AABB &b) noexcept
+    {
+        os << "AABB(min=" << b.min_ << ", max=" << b.max_ << ")";
+        return os;
+    }
+
+private:
+    static constexpr V splat(value_type s) noexcept
+    {
+        V v{};
+        for (std::size_t c = 0; c < vec::detail::vector_traits<V>::size; ++c)
+            v[c] = s;
+        return v;
+    }
+
+    V min_;
+    V max_;
+};
+
+// Type aliases
+template <typename T>
+using AABB2 = AABB<Vector2<T>>;
+template <typename T>
+using AABB3 = AABB<Vector3<T>>;
+
+using AABB2f = AABB2<float>;
+using AABB2d = AABB2<double>;
+using AABB3f = AABB3<float>;
+using AABB3d = AABB3<double>;
+
+namespace vec
+{
+    /**
+     * @brief Bounding box of n vectors
+     *
+     * Float and double arrays of Vector2/3/4 are reduced four vectors at a
+     * time: N registers of minima and N of maxima, where lane l of register
+     * k tracks component (4k + l) % N of the interleaved array, folded into
+     * one box at the end. NaN components are ignored. Empty for n == 0.
+     */
+    template <typename V>
+    AABB<V> bounds_of(const V *in, std::size_t n) noexcept
+    {
+        using T = detail::scalar_t<V>;
+        using S = detail::simd4<T>;
+        constexpr std::size_t N{detail::vector_traits<V>::size};
+
+        AABB<V> box;
+        std::size_t i{0};
+        if constexpr (S::enabled && sizeof(V) == N * sizeof(T))
+        {
+            const T *s{detail::scalars(in)};
+            typename S::reg lo[N];
+            typename S::reg hi[N];
+            for (std::size_t k = 0; k < N; ++k)
+            {
+                lo[k] = S::set1(detail::empty_min<T>());
+                hi[k] = S::set1(detail::empty_max<T>());
+            }
+            // min(x, acc) returns acc when x is NaN
+            for (; i + 4 <= n; i += 4, s += 4 * N)
+                for (std::size_t k = 0; k < N; ++k)
+                {
+                    const typename S::reg x{S::load(s + 4 * k)};
+                    lo[k] = S::min(x, lo[k]);
+                    hi[k] = S::max(x, hi[k]);
+                }
+
+            T lanes_lo[4 * N];
+            T lanes_hi[4 * N];
+            for (std::size_t k = 0; k < N; ++k)
+            {
+                S::store(lanes_lo + 4 * k, lo[k]);
+                S::store(lanes_hi + 4 * k, hi[k]);
+            }
+            V min{box.min()};
+            V max{box.max()};
+            for (std::size_t j = 0; j < 4 * N; ++j)
+            {
+                min[j % N] = std::min(min[j % N], lanes_lo[j]);
+                max[j % N] = std::max(max[j % N], lanes_hi[j]);
+            }
+            box = AABB<V>(min, max);
+        }
+        for (; i < n; ++i)
+            box.merge(in[i]);
+        return box;
+    }
+} // namespace vec
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace vec
+{
+    /**
+     * @brief Allocator returning storage aligned to Align bytes
+     *
+     * Elements are default-initialized rather than value-initialized, so
+     * resizing a buffer that is about to be overwritten does not cost an
+     * extra pass over memory. Pass an explicit value to resize() when zeroed
+     * storage is needed.
+     */
+    template <typename T, std::size_t Align = 64>
+    struct aligned_allocator
+    {
+        using value_type = T;
+
+        template <typename U>
+        struct rebind
+        {
+            using other = aligned_allocator<U, Align>;
+        };
+
+        aligned_allocator() noexcept = default;
+
+        template <typename U>
+        aligned_allocator(const aligned_allocator<U, Align> &) noexcept {}
+
+        [[nodiscard]] T *allocate(std::size_t n)
+        {
+            return static_cast<T *>(::operator new(n * sizeof(T), std::align_val_t{Align}));
+        }
+
+        void deallocate(T *p, std::size_t) noexcept
+        {
+            ::operator delete(p, std::align_val_t{Align});
+        }
+
+        // Default-initialization for value-less construction
+        template <typename U>
+        void construct(U *p) noexcept
+        {
+            ::new (static_cast<void *>(p)) U;
+        }
+
+        template <typename U, typename... Args>
+        void construct(U *p, Args &&...args)
+        {
+            ::new (static_cast<void *>(p)) U(std::forward<Args>(args)...);
+        }
+
+        friend bool operator==(const aligned_allocator &, const aligned_allocator &) noexcept { return true; }
+        friend bool operator!=(const aligned_allocator &, const aligned_allocator &) noexcept { return false; }
+    };
+
+    // Cache-line aligned std::vector
+    template <typename T>
+    using aligned_vector = std::vector<T, aligned_allocator<T>>;
+} // namespace vec
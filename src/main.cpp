@@ -24,7 +24,7 @@ int main()
     double dot = v3.dot(v2);
     Vector3d v8 = v6.cross(v7);
     Vector3d v9 = v8.normalize();
-    Vector3d v10 = v8.pow(2);
+    Vector3d v10 = v8.pow<2>();
 
     // Print
     std::cout << "Vector v10 is: " << v10 << std::endl;
@@ -0,0 +1,364 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iostream>
+#include <type_traits>
+
+#include "vector2.hpp"
+#include "vector3.hpp"
+#include "vector4.hpp"
+#include "vector_kernels.hpp"
+#include "vector_n.hpp"
+
+/**
+ * @brief Square N x N matrix (N = 2, 3, 4), column-major
+ *
+ * Stored as N column vectors, so m * v is a sum of columns scaled by the
+ * components of v and runs on the SIMD backend of the column type (float
+ * and double Matrix4). Element (row, col) is m(row, col); m[col] is a
+ * column. Vectors are columns: (a * b) * v == a * (b * v).
+ */
+template <typename T, std::size_t N>
+class MatrixN
+{
+    static_assert(N >= 2 && N <= 4, "MatrixN supports 2x2, 3x3 and 4x4 matrices");
+
+public:
+    using value_type = T;
+    using column_type = VectorN<T, N>;
+
+    // Constructors (default: all zeros)
+    explicit constexpr MatrixN() noexcept = default;
+    template <typename... C,
+              std::enable_if_t<sizeof...(C) == N && (std::is_same_v<C, column_type> && ...), int> = 0>
+    explicit constexpr MatrixN(const C &...columns) noexcept : columns_{columns...} {}
+
+    [[nodiscard]] static constexpr MatrixN identity() noexcept
+    {
+        MatrixN m;
+        for (std::size_t i = 0; i < N; ++i)
+            m(i, i) = 1;
+        return m;
+    }
+
+    // Element access
+    [[nodiscard]] constexpr T &operator()(std::size_t row, std::size_t col) noexcept { return columns_[col][row]; }
+    [[nodiscard]] constexpr const T &operator()(std::size_t row, std::size_t col) const noexcept
+    {
+        return columns_[col][row];
+    }
+
+    // Column access
+    [[nodiscard]] constexpr column_type &operator[](std::size_t col) noexcept { return columns_[col]; }
+    [[nodiscard]] constexpr const column_type &operator[](std::size_t col) const noexcept { return columns_[col]; }
+
+    [[nodiscard]] constexpr column_type row(std::size_t r) const noexcept
+    {
+        column_type v;
+        for (std::size_t c = 0; c < N; ++c)
+            v[c] = (*this)(r, c);
+        return v;
+    }
+
+    // N * N elements, column after column
+    [[nodiscard]] T *data() noexcept { return columns_[0].data(); }
+    [[nodiscard]] const T *data() const noexcept { return columns_[0].data(); }
+
+    [[nodiscard]] static constexpr std::size_t size() noexcept { return N; }
+
+    // Comparison
+    constexpr bool operator==(const MatrixN &o) const noexcept
+    {
+        for (std::size_t c = 0; c < N; ++c)
+            if (!(columns_[c] == o.columns_[c]))
+                return false;
+        return true;
+    }
+
+    // Unary
+    constexpr MatrixN operator+() const noexcept { return *this; }
+    constexpr MatrixN operator-() const noexcept
+    {
+        MatrixN m;
+        for (std::size_t c = 0; c < N; ++c)
+            m.columns_[c] = -columns_[c];
+        return m;
+    }
+
+    // Matrix - Matrix operations
+    constexpr MatrixN operator+(const MatrixN &o) const noexcept
+    {
+        MatrixN m;
+        for (std::size_t c = 0; c < N; ++c)
+            m.columns_[c] = columns_[c] + o.columns_[c];
+        return m;
+    }
+    constexpr MatrixN operator-(const MatrixN &o) const noexcept
+    {
+        MatrixN m;
+        for (std::size_t c = 0; c < N; ++c)
+            m.columns_[c] = columns_[c] - o.columns_[c];
+        return m;
+    }
+
+    // Matrix product: column c of the result is *this * o[c]
+    constexpr MatrixN operator*(const MatrixN &o) const noexcept
+    {
+        MatrixN m;
+        for (std::size_t c = 0; c < N; ++c)
+            m.columns_[c] = *this * o.columns_[c];
+        return m;
+    }
+
+    // Matrix - Vector product, summed in column order: ((m[0] * v.x + m[1] * v.y) + m[2] * v.z) + ...
+    constexpr column_type operator*(const column_type &v) const noexcept
+    {
+        column_type r{columns_[0] * v[0]};
+        for (std::size_t c = 1; c < N; ++c)
+            r += columns_[c] * v[c];
+        return r;
+    }
+
+    // Matrix - Scalar operations
+    constexpr MatrixN operator*(T s) const noexcept
+    {
+        MatrixN m;
+        for (std::size_t c = 0; c < N; ++c)
+            m.columns_[c] = columns_[c] * s;
+        return m;
+    }
+    constexpr MatrixN operator/(T s) const noexcept
+    {
+        MatrixN m;
+        for (std::size_t c = 0; c < N; ++c)
+            m.columns_[c] = columns_[c] / s;
+        return m;
+    }
+
+    // Compound assignment
+    constexpr MatrixN &operator+=(const MatrixN &o) noexcept { return *this = *this + o; }
+    constexpr MatrixN &operator-=(const MatrixN &o) noexcept { return *this = *this - o; }
+    constexpr MatrixN &operator*=(const MatrixN &o) noexcept { return *this = *this * o; }
+    constexpr MatrixN &operator*=(T s) noexcept { return *this = *this * s; }
+    constexpr MatrixN &operator/=(T s) noexcept { return *this = *this / s; }
+
+    // Transpose
+    [[nodiscard]] constexpr MatrixN transpose() const noexcept
+    {
+        MatrixN m;
+        for (std::size_t c = 0; c < N; ++c)
+            m.columns_[c] = row(c);
+        return m;
+    }
+
+    [[nodiscard]] constexpr T trace() const noexcept
+    {
+        T t{(*this)(0, 0)};
+        for (std::size_t i = 1; i < N; ++i)
+            t += (*this)(i, i);
+        return t;
+    }
+
+    // Determinant by cofactor expansion along the first column (exact for integer matrices)
+    [[nodiscard]] constexpr T determinant() const noexcept
+    {
+        T d{(*this)(0, 0) * cofactor(0, 0)};
+        for (std::size_t r = 1; r < N; ++r)
+            d += (*this)(r, 0) * cofactor(r, 0);
+        return d;
+    }
+
+    /**
+     * @brief Inverse matrix
+     *
+     * Adjugate divided by the determinant. Singular matrices give infinite
+     * or NaN elements; check determinant() first when that is possible.
+     */
+    [[nodiscard]] constexpr MatrixN inverse() const noexcept
+    {
+        static_assert(std::is_floating_point_v<T>, "inverse requires a floating-point matrix");
+        MatrixN adjugate;
+        for (std::size_t r = 0; r < N; ++r)
+            for (std::size_t c = 0; c < N; ++c)
+                adjugate(c, r) = cofactor(r, c);
+        T d{(*this)(0, 0) * adjugate(0, 0)};
+        for (std::size_t r = 1; r < N; ++r)
+            d += (*this)(r, 0) * adjugate(0, r);
+        return adjugate / d;
+    }
+
+    // Stream output, rows in order, e.g. "Matrix2((1, 2), (3, 4))"
+    friend std::ostream &operator<<(std::ostream &os, const MatrixN &m) noexcept
+    {
+        os << "Matrix" << N << "(";
+        for (std::size_t r = 0; r < N; ++r)
+        {
+            os << (r > 0 ? ", (" : "(");
+            for (std::size_t c = 0; c < N; ++c)
+                os << (c > 0 ? ", " : "") << m(r, c);
+            os << ")";
+        }
+        os << ")";
+        return os;
+    }
+
+    // Conversion to a matrix of another scalar type
+    template <typename K>
+    explicit constexpr operator MatrixN<K, N>() const noexcept
+    {
+        MatrixN<K, N> m;
+        for (std::size_t c = 0; c < N; ++c)
+            m[c] = static_cast<VectorN<K, N>>(columns_[c]);
+        return m;
+    }
+
+private:
+    // (-1)^(r + c) times the determinant of the matrix without row r and column c
+    constexpr T cofactor(std::size_t r, std::size_t c) const noexcept
+    {
+        T m[N - 1][N - 1]{};
+        for (std::size_t i = 0, mi = 0; i < N; ++i)
+        {
+            if (i == r)
+                continue;
+            for (std::size_t j = 0, mj = 0; j < N; ++j)
+                if (j != c)
+                    m[mi][mj++] = (*this)(i, j);
+            ++mi;
+        }
+        T d{};
+        if constexpr (N == 2)
+            d = m[0][0];
+        else if constexpr (N == 3)
+            d = m[0][0] * m[1][1] - m[0][1] * m[1][0];
+        else
+            d = m[0][0] * (m[1][1] * m[2][2] - m[1][2] * m[2][1]) -
+                m[0][1] * (m[1][0] * m[2][2] - m[1][2] * m[2][0]) +
+                m[0][2] * (m[1][0] * m[2][1] - m[1][1] * m[2][0]);
+        return (r + c) % 2 == 0 ? d : -d;
+    }
+
+    column_type columns_[N];
+};
+
+// Scalar * matrix
+template <typename T, std::size_t N>
+constexpr MatrixN<T, N> operator*(T s, const MatrixN<T, N> &m) noexcept
+{
+    return m * s;
+}
+
+template <typename T>
+using Matrix2 = MatrixN<T, 2>;
+template <typename T>
+using Matrix3 = MatrixN<T, 3>;
+template <typename T>
+using Matrix4 = MatrixN<T, 4>;
+
+// Type aliases
+using Matrix2i = Matrix2<int>;
+using Matrix2f = Matrix2<float>;
+using Matrix2d = Matrix2<double>;
+using Matrix3i = Matrix3<int>;
+using Matrix3f = Matrix3<float>;
+using Matrix3d = Matrix3<double>;
+using Matrix4i = Matrix4<int>;
+using Matrix4f = Matrix4<float>;
+using Matrix4d = Matrix4<double>;
+
+/*
+ * Batch transforms
+ *
+ * The columns of the matrix are held in four-lane registers for the whole
+ * array, so each element costs one broadcast and one multiply-add per input
+ * component and a single four-lane store. Results match m * v element by
+ * element. out may alias in.
+ */
+namespace vec
+{
+    namespace detail
+    {
+        // d = m * (x, s[1], ..., s[K - 1]) on scalars, with x passed separately
+        template <bool Affine, std::size_t K, typename T, std::size_t N>
+        void transform_element(const MatrixN<T, N> &m, T x, const T *s, T *d) noexcept
+        {
+            T v[K]{x};
+            for (std::size_t c = 1; c < K; ++c)
+                v[c] = s[c];
+            for (std::size_t r = 0; r < K; ++r)
+            {
+                T sum{m(r, 0) * v[0]};
+                for (std::size_t c = 1; c < K; ++c)
+                    sum += m(r, c) * v[c];
+                if constexpr (Affine)
+                    sum += m(r, K);
+                d[r] = sum;
+            }
+        }
+
+        /**
+         * @brief dst[i] = m * src[i] over n interleaved elements of K components
+         *
+         * Uses the first K columns and rows of m, plus column K as a translation
+         * when Affine. For K = 3 the four-lane store spills into the x of the
+         * next element, so that x is read before the store and the next
+         * iteration rewrites it; the last element is computed on scalars.
+         */
+        template <bool Affine, std::size_t K, typename T, std::size_t N>
+        void transform_stream(const MatrixN<T, N> &m, const T *src, T *dst, std::size_t n) noexcept
+        {
+            using simd = simd4<T>;
+            if constexpr (simd::enabled && (K == 3 || K == 4))
+            {
+                if (n == 0)
+                    return;
+                typename simd::reg columns[K + Affine];
+                for (std::size_t c = 0; c < K + Affine; ++c)
+                {
+                    T lanes[4]{};
+                    for (std::size_t r = 0; r < K; ++r)
+                        lanes[r] = m(r, c);
+                    columns[c] = simd::load(lanes);
+                }
+                T x{src[0]};
+                for (std::size_t i = 0; i + 1 < n; ++i)
+                {
+                    const T *s{src + i * K};
+                    auto r{simd::mul(columns[0], simd::set1(x))};
+                    for (std::size_t c = 1; c < K; ++c)
+                        r = simd::add(r, simd::mul(columns[c], simd::set1(s[c])));
+                    if constexpr (Affine)
+                        r = simd::add(r, columns[K]);
+                    x = s[K];
+                    simd::store(dst + i * K, r);
+                }
+                transform_element<Affine, K>(m, x, src + (n - 1) * K, dst + (n - 1) * K);
+            }
+            else
+            {
+                for (std::size_t i = 0; i < n; ++i)
+                    transform_element<Affine, K>(m, src[i * K], src + i * K, dst + i * K);
+            }
+        }
+    } // namespace detail
+
+    // out[i] = m * in[i]
+    template <typename T, std::size_t N>
+    void transform_many(const MatrixN<T, N> &m, const VectorN<T, N> *in, VectorN<T, N> *out, std::size_t n) noexcept
+    {
+        detail::transform_stream<false, N>(m, detail::scalars(in), detail::scalars(out), n);
+    }
+
+    /**
+     * @brief Transform n points by an affine 4x4 matrix
+     *
+     * out[i] is the x, y, z of m * Vector4(in[i], 1); the bottom row of m is
+     * ignored (no perspective divide).
+     */
+    template <typename T>
+    void transform_points(const Matrix4<T> &m, const Vector3<T> *in, Vector3<T> *out, std::size_t n) noexcept
+    {
+        detail::transform_stream<true, 3>(m, detail::scalars(in), detail::scalars(out), n);
+    }
+} // namespace vec
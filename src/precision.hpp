@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+namespace vec
+{
+    /**
+     * @brief Floating-point type used for norms of vectors of T
+     *
+     * float vectors compute norms in float (sqrtf), long double vectors in
+     * long double, everything else (double, integers) in double. Callers can
+     * still request another precision explicitly, e.g. v.norm<double>().
+     */
+    template <typename T>
+    struct norm_precision
+    {
+        using type = double;
+    };
+
+    template <>
+    struct norm_precision<float>
+    {
+        using type = float;
+    };
+
+    template <>
+    struct norm_precision<long double>
+    {
+        using type = long double;
+    };
+
+    template <typename T>
+    using norm_precision_t = typename norm_precision<T>::type;
+
+    /**
+     * @brief Integer type holding products of two T exactly
+     *
+     * std::int64_t for signed integers of up to 32 bits, std::uint64_t for
+     * unsigned ones; 64-bit integers and floating-point types are their own
+     * wide type. Sums of up to four such products are exact for components
+     * within +-2^30 (signed) or below 2^31 (unsigned), which covers Vector2i,
+     * Vector3i and Vector4i dot products and squared norms on grid
+     * coordinates.
+     */
+    template <typename T>
+    struct wide_integer
+    {
+        using type = std::conditional_t<std::is_integral_v<T> && (sizeof(T) < sizeof(std::int64_t)),
+                                        std::conditional_t<std::is_signed_v<T>, std::int64_t, std::uint64_t>, T>;
+    };
+
+    template <typename T>
+    using wide_t = typename wide_integer<T>::type;
+
+    /**
+     * @brief Unsigned integer type holding squared norms of integer vectors of T
+     *
+     * The unsigned counterpart of wide_t<T>. Squares are never negative, so
+     * three full-range squares of 32-bit integers sum exactly (3 * 2^62 <
+     * 2^64), and so do four unless every component is INT_MIN, whose sum
+     * wraps to zero. Floating-point types are their own norm type.
+     */
+    template <typename T, bool = std::is_integral_v<T>>
+    struct wide_norm
+    {
+        using type = T;
+    };
+
+    template <typename T>
+    struct wide_norm<T, true>
+    {
+        using type = std::make_unsigned_t<wide_t<T>>;
+    };
+
+    template <typename T>
+    using wide_norm_t = typename wide_norm<T>::type;
+} // namespace vec
@@ -0,0 +1,486 @@
+#pragma once
+
+#include <cfloat>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+/*
+ * SIMD backend selection
+ *
+ * The backend is chosen at compile time from the target flags. SSE2 is part
+ * of the x86-64 baseline, AVX is only used when the compiler is allowed to
+ * emit it (e.g. -mavx / -march=native / /arch:AVX). Define VECTORS_NO_SIMD
+ * to force the portable scalar code everywhere.
+ */
+#if !defined(VECTORS_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define VECTORS_SIMD_SSE2 1
+#if defined(__AVX__)
+#define VECTORS_SIMD_AVX 1
+#endif
+#include <immintrin.h>
+#endif
+
+/*
+ * Fused multiply-add
+ *
+ * Defined when std::fma compiles to a single instruction (e.g. -mfma /
+ * -march=native / /arch:AVX2). Without it std::fma is emulated in software
+ * and far slower than a separate multiply and add.
+ */
+#if defined(__FMA__) || defined(__AVX2__) || defined(FP_FAST_FMA)
+#define VECTORS_HAS_FMA 1
+#endif
+
+/*
+ * Constant evaluation detection
+ *
+ * Vector operations stay constexpr: intrinsics are only used when the call is
+ * not part of a constant expression. Compilers that cannot tell the two apart
+ * always take the scalar path.
+ */
+#if defined(__cpp_lib_is_constant_evaluated)
+#define VECTORS_CONSTANT_EVALUATED() std::is_constant_evaluated()
+#elif defined(__has_builtin)
+#if __has_builtin(__builtin_is_constant_evaluated)
+#define VECTORS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#endif
+#elif (defined(__GNUC__) && __GNUC__ >= 9) || (defined(_MSC_VER) && _MSC_VER >= 1925)
+#define VECTORS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#endif
+
+#ifndef VECTORS_CONSTANT_EVALUATED
+#define VECTORS_CONSTANT_EVALUATED() true
+#endif
+
+namespace vec::detail
+{
+    /**
+     * @brief Four-lane register operations for a scalar type
+     *
+     * The primary template is the scalar fallback: `enabled` is false and
+     * vector classes use their plain component-wise code.
+     */
+    template <typename T>
+    struct simd4
+    {
+        static constexpr bool enabled = false;
+        struct reg
+        {
+        };
+    };
+
+    /**
+     * @brief Alignment of a vector of N components of type T
+     *
+     * Float, double and 32-bit integer vectors whose size is a multiple of
+     * four lanes are aligned to the four-lane width. Depends on T and N only (not on the
+     * selected backend) so that translation units built with different flags
+     * agree on the layout.
+     */
+    template <typename T, std::size_t N>
+    inline constexpr std::size_t simd_alignment =
+        (std::is_same_v<T, float> || std::is_same_v<T, double> || std::is_same_v<T, std::int32_t>) && N % 4 == 0
+            ? 4 * sizeof(T)
+            : alignof(T);
+
+#if defined(VECTORS_SIMD_SSE2)
+    template <>
+    struct simd4<float>
+    {
+        static constexpr bool enabled = true;
+        using reg = __m128;
+
+        static reg load(const float *p) noexcept { return _mm_loadu_ps(p); }
+        static void store(float *p, reg a) noexcept { _mm_storeu_ps(p, a); }
+        static reg load_aligned(const float *p) noexcept { return _mm_load_ps(p); }
+        static void store_aligned(float *p, reg a) noexcept { _mm_store_ps(p, a); }
+        static reg set1(float s) noexcept { return _mm_set1_ps(s); }
+
+        static reg add(reg a, reg b) noexcept { return _mm_add_ps(a, b); }
+        static reg sub(reg a, reg b) noexcept { return _mm_sub_ps(a, b); }
+        static reg mul(reg a, reg b) noexcept { return _mm_mul_ps(a, b); }
+        static reg div(reg a, reg b) noexcept { return _mm_div_ps(a, b); }
+        static reg neg(reg a) noexcept { return _mm_xor_ps(a, _mm_set1_ps(-0.0f)); }
+        static reg abs(reg a) noexcept { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+
+        // a < b ? a : b and a > b ? a : b per lane (b when either is NaN)
+        static reg min(reg a, reg b) noexcept { return _mm_min_ps(a, b); }
+        static reg max(reg a, reg b) noexcept { return _mm_max_ps(a, b); }
+
+        // Lanes x, y, z of a with the fourth lane cleared
+        static reg zero_w(reg a) noexcept { return _mm_and_ps(a, _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1))); }
+
+        // Lanes (a[I0], a[I1], a[I2], a[I3]) in a single shuffle
+        template <int I0, int I1, int I2, int I3>
+        static reg shuffle(reg a) noexcept { return _mm_shuffle_ps(a, a, _MM_SHUFFLE(I3, I2, I1, I0)); }
+
+        static bool equal(reg a, reg b) noexcept { return _mm_movemask_ps(_mm_cmpeq_ps(a, b)) == 0xF; }
+
+        // Horizontal sum of the four lanes
+        static float hsum(reg a) noexcept
+        {
+            const __m128 shuf{_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1))};
+            const __m128 sums{_mm_add_ps(a, shuf)};
+            return _mm_cvtss_f32(_mm_add_ss(sums, _mm_movehl_ps(shuf, sums)));
+        }
+
+        static float dot(reg a, reg b) noexcept { return hsum(mul(a, b)); }
+
+        // Sum of squares accumulated in double precision
+        static double norm_squared_double(reg a) noexcept
+        {
+            const __m128d lo{_mm_cvtps_pd(a)};
+            const __m128d hi{_mm_cvtps_pd(_mm_movehl_ps(a, a))};
+            const __m128d sums{_mm_add_pd(_mm_mul_pd(lo, lo), _mm_mul_pd(hi, hi))};
+            return _mm_cvtsd_f64(_mm_add_sd(sums, _mm_unpackhi_pd(sums, sums)));
+        }
+    };
+
+#if defined(VECTORS_SIMD_AVX)
+    template <>
+    struct simd4<double>
+    {
+        static constexpr bool enabled = true;
+        using reg = __m256d;
+
+        static reg load(const double *p) noexcept { return _mm256_loadu_pd(p); }
+        static void store(double *p, reg a) noexcept { _mm256_storeu_pd(p, a); }
+        static reg load_aligned(const double *p) noexcept { return _mm256_load_pd(p); }
+        static void store_aligned(double *p, reg a) noexcept { _mm256_store_pd(p, a); }
+        static reg set1(double s) noexcept { return _mm256_set1_pd(s); }
+
+        static reg add(reg a, reg b) noexcept { return _mm256_add_pd(a, b); }
+        static reg sub(reg a, reg b) noexcept { return _mm256_sub_pd(a, b); }
+        static reg mul(reg a, reg b) noexcept { return _mm256_mul_pd(a, b); }
+        static reg div(reg a, reg b) noexcept { return _mm256_div_pd(a, b); }
+        static reg neg(reg a) noexcept { return _mm256_xor_pd(a, _mm256_set1_pd(-0.0)); }
+        static reg abs(reg a) noexcept { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a); }
+        static reg min(reg a, reg b) noexcept { return _mm256_min_pd(a, b); }
+        static reg max(reg a, reg b) noexcept { return _mm256_max_pd(a, b); }
+
+        static reg zero_w(reg a) noexcept { return _mm256_blend_pd(a, _mm256_setzero_pd(), 0x8); }
+
+        template <int I0, int I1, int I2, int I3>
+        static reg shuffle(reg a) noexcept
+        {
+#if defined(__AVX2__)
+            return _mm256_permute4x64_pd(a, _MM_SHUFFLE(I3, I2, I1, I0));
+#else
+            // AVX only permutes within 128-bit halves: pick each lane from
+            // the duplicated low or high half
+            constexpr int within{(I0 & 1) | (I1 & 1) << 1 | (I2 & 1) << 2 | (I3 & 1) << 3};
+            constexpr int high{(I0 >> 1) | (I1 >> 1) << 1 | (I2 >> 1) << 2 | (I3 >> 1) << 3};
+            const reg lo{_mm256_permute_pd(_mm256_permute2f128_pd(a, a, 0x00), within)};
+            const reg hi{_mm256_permute_pd(_mm256_permute2f128_pd(a, a, 0x11), within)};
+            return _mm256_blend_pd(lo, hi, high);
+#endif
+        }
+
+        static bool equal(reg a, reg b) noexcept { return _mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_EQ_OQ)) == 0xF; }
+
+        static double hsum(reg a) noexcept
+        {
+            const __m128d sums{_mm_add_pd(_mm256_castpd256_pd128(a), _mm256_extractf128_pd(a, 1))};
+            return _mm_cvtsd_f64(_mm_add_sd(sums, _mm_unpackhi_pd(sums, sums)));
+        }
+
+        static double dot(reg a, reg b) noexcept { return hsum(mul(a, b)); }
+    };
+#else
+    template <>
+    struct simd4<double>
+    {
+        static constexpr bool enabled = true;
+
+        // Without AVX a four-lane double vector spans two SSE2 registers
+        struct reg
+        {
+            __m128d lo;
+            __m128d hi;
+        };
+
+        static reg load(const double *p) noexcept { return {_mm_loadu_pd(p), _mm_loadu_pd(p + 2)}; }
+        static void store(double *p, reg a) noexcept
+        {
+            _mm_storeu_pd(p, a.lo);
+            _mm_storeu_pd(p + 2, a.hi);
+        }
+        static reg load_aligned(const double *p) noexcept { return {_mm_load_pd(p), _mm_load_pd(p + 2)}; }
+        static void store_aligned(double *p, reg a) noexcept
+        {
+            _mm_store_pd(p, a.lo);
+            _mm_store_pd(p + 2, a.hi);
+        }
+        static reg set1(double s) noexcept { return {_mm_set1_pd(s), _mm_set1_pd(s)}; }
+
+        static reg add(reg a, reg b) noexcept { return {_mm_add_pd(a.lo, b.lo), _mm_add_pd(a.hi, b.hi)}; }
+        static reg sub(reg a, reg b) noexcept { return {_mm_sub_pd(a.lo, b.lo), _mm_sub_pd(a.hi, b.hi)}; }
+        static reg mul(reg a, reg b) noexcept { return {_mm_mul_pd(a.lo, b.lo), _mm_mul_pd(a.hi, b.hi)}; }
+        static reg div(reg a, reg b) noexcept { return {_mm_div_pd(a.lo, b.lo), _mm_div_pd(a.hi, b.hi)}; }
+        static reg neg(reg a) noexcept
+        {
+            const __m128d sign{_mm_set1_pd(-0.0)};
+            return {_mm_xor_pd(a.lo, sign), _mm_xor_pd(a.hi, sign)};
+        }
+        static reg abs(reg a) noexcept
+        {
+            const __m128d sign{_mm_set1_pd(-0.0)};
+            return {_mm_andnot_pd(sign, a.lo), _mm_andnot_pd(sign, a.hi)};
+        }
+        static reg min(reg a, reg b) noexcept { return {_mm_min_pd(a.lo, b.lo), _mm_min_pd(a.hi, b.hi)}; }
+        static reg max(reg a, reg b) noexcept { return {_mm_max_pd(a.lo, b.lo), _mm_max_pd(a.hi, b.hi)}; }
+
+        static reg zero_w(reg a) noexcept { return {a.lo, _mm_move_sd(_mm_setzero_pd(), a.hi)}; }
+
+        template <int I0, int I1, int I2, int I3>
+        static reg shuffle(reg a) noexcept
+        {
+            return {pair<I0, I1>(a), pair<I2, I3>(a)};
+        }
+
+        static bool equal(reg a, reg b) noexcept
+        {
+            return (_mm_movemask_pd(_mm_cmpeq_pd(a.lo, b.lo)) & _mm_movemask_pd(_mm_cmpeq_pd(a.hi, b.hi))) == 0x3;
+        }
+
+        static double hsum(reg a) noexcept
+        {
+            const __m128d sums{_mm_add_pd(a.lo, a.hi)};
+            return _mm_cvtsd_f64(_mm_add_sd(sums, _mm_unpackhi_pd(sums, sums)));
+        }
+
+        static double dot(reg a, reg b) noexcept { return hsum(mul(a, b)); }
+
+    private:
+        // (a[I], a[J]) from the halves holding them
+        template <int I, int J>
+        static __m128d pair(reg a) noexcept
+        {
+            return _mm_shuffle_pd(I < 2 ? a.lo : a.hi, J < 2 ? a.lo : a.hi, (I & 1) | (J & 1) << 1);
+        }
+    };
+#endif
+
+    /**
+     * @brief Four 32-bit integer lanes
+     *
+     * SSE2 everywhere; multiplies, minima/maxima and absolute values use the
+     * single SSE4.1 / SSSE3 instructions when the target has them. Additions
+     * and products wrap around like unsigned arithmetic.
+     */
+    template <>
+    struct simd4<std::int32_t>
+    {
+        static constexpr bool enabled = true;
+        using reg = __m128i;
+
+        static reg load(const std::int32_t *p) noexcept { return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p)); }
+        static void store(std::int32_t *p, reg a) noexcept { _mm_storeu_si128(reinterpret_cast<__m128i *>(p), a); }
+        static reg load_aligned(const std::int32_t *p) noexcept { return _mm_load_si128(reinterpret_cast<const __m128i *>(p)); }
+        static void store_aligned(std::int32_t *p, reg a) noexcept { _mm_store_si128(reinterpret_cast<__m128i *>(p), a); }
+        static reg set1(std::int32_t s) noexcept { return _mm_set1_epi32(s); }
+
+        static reg add(reg a, reg b) noexcept { return _mm_add_epi32(a, b); }
+        static reg sub(reg a, reg b) noexcept { return _mm_sub_epi32(a, b); }
+        static reg mul(reg a, reg b) noexcept
+        {
+#if defined(__SSE4_1__)
+            return _mm_mullo_epi32(a, b);
+#else
+            // Lanes 0, 2 and 1, 3 as 64-bit products, low halves interleaved back
+            const __m128i even{_mm_mul_epu32(a, b)};
+            const __m128i odd{_mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32))};
+            return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                                      _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+#endif
+        }
+
+        // Quotients truncated toward zero. Through double, which cannot round a
+        // quotient of 32-bit integers across an integer; x / 0 gives INT_MIN.
+        static reg div(reg a, reg b) noexcept
+        {
+#if defined(VECTORS_SIMD_AVX)
+            return _mm256_cvttpd_epi32(_mm256_div_pd(_mm256_cvtepi32_pd(a), _mm256_cvtepi32_pd(b)));
+#else
+            const __m128i a_hi{_mm_shuffle_epi32(a, _MM_SHUFFLE(1, 0, 3, 2))};
+            const __m128i b_hi{_mm_shuffle_epi32(b, _MM_SHUFFLE(1, 0, 3, 2))};
+            const __m128d lo{_mm_div_pd(_mm_cvtepi32_pd(a), _mm_cvtepi32_pd(b))};
+            const __m128d hi{_mm_div_pd(_mm_cvtepi32_pd(a_hi), _mm_cvtepi32_pd(b_hi))};
+            return _mm_unpacklo_epi64(_mm_cvttpd_epi32(lo), _mm_cvttpd_epi32(hi));
+#endif
+        }
+
+        static reg neg(reg a) noexcept { return _mm_sub_epi32(_mm_setzero_si128(), a); }
+        static reg abs(reg a) noexcept
+        {
+#if defined(__SSSE3__)
+            return _mm_abs_epi32(a);
+#else
+            const __m128i sign{_mm_srai_epi32(a, 31)};
+            return _mm_sub_epi32(_mm_xor_si128(a, sign), sign);
+#endif
+        }
+
+        static reg min(reg a, reg b) noexcept
+        {
+#if defined(__SSE4_1__)
+            return _mm_min_epi32(a, b);
+#else
+            const __m128i b_less{_mm_cmpgt_epi32(a, b)};
+            return _mm_or_si128(_mm_and_si128(b_less, b), _mm_andnot_si128(b_less, a));
+#endif
+        }
+        static reg max(reg a, reg b) noexcept
+        {
+#if defined(__SSE4_1__)
+            return _mm_max_epi32(a, b);
+#else
+            const __m128i b_greater{_mm_cmpgt_epi32(b, a)};
+            return _mm_or_si128(_mm_and_si128(b_greater, b), _mm_andnot_si128(b_greater, a));
+#endif
+        }
+
+        static reg zero_w(reg a) noexcept { return _mm_and_si128(a, _mm_set_epi32(0, -1, -1, -1)); }
+
+        template <int I0, int I1, int I2, int I3>
+        static reg shuffle(reg a) noexcept { return _mm_shuffle_epi32(a, _MM_SHUFFLE(I3, I2, I1, I0)); }
+
+        static bool equal(reg a, reg b) noexcept { return _mm_movemask_epi8(_mm_cmpeq_epi32(a, b)) == 0xFFFF; }
+
+        static std::int32_t hsum(reg a) noexcept
+        {
+            const __m128i sums{_mm_add_epi32(a, _mm_shuffle_epi32(a, _MM_SHUFFLE(1, 0, 3, 2)))};
+            return _mm_cvtsi128_si32(_mm_add_epi32(sums, _mm_shuffle_epi32(sums, _MM_SHUFFLE(2, 3, 0, 1))));
+        }
+
+        static std::int32_t dot(reg a, reg b) noexcept { return hsum(mul(a, b)); }
+
+        // Exact signed 64-bit products of lanes 0 and 2
+        static reg mul_wide(reg a, reg b) noexcept
+        {
+#if defined(__SSE4_1__)
+            return _mm_mul_epi32(a, b);
+#else
+            // |a| * |b| unsigned, negated where the signs differ
+            const __m128i p{_mm_mul_epu32(abs(a), abs(b))};
+            const __m128i sign{_mm_shuffle_epi32(_mm_srai_epi32(_mm_xor_si128(a, b), 31), _MM_SHUFFLE(2, 2, 0, 0))};
+            return _mm_sub_epi64(_mm_xor_si128(p, sign), sign);
+#endif
+        }
+    };
+#endif
+
+    /**
+     * @brief Approximate 1 / sqrt(a) for a > 0
+     *
+     * Hardware estimate (rsqrtss, relative error <= 1.5 * 2^-12) refined by
+     * one Newton-Raphson step. The result is within 1e-6 relative error of
+     * the exact value (about 2e-7 in practice). Without SSE the exact value
+     * is returned, as it is for subnormal or infinite a, where the estimate
+     * overflows or the Newton step gives NaN. Doubles go through the float
+     * estimate when in float range.
+     */
+    inline float rsqrt_approx(float a) noexcept
+    {
+#if defined(VECTORS_SIMD_SSE2)
+        if (a >= FLT_MIN && a <= FLT_MAX)
+        {
+            const float r{_mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(a)))};
+            return r * (1.5f - 0.5f * a * r * r);
+        }
+#endif
+        return 1.0f / std::sqrt(a);
+    }
+
+    inline double rsqrt_approx(double a) noexcept
+    {
+#if defined(VECTORS_SIMD_SSE2)
+        if (a >= FLT_MIN && a <= FLT_MAX)
+        {
+            const double r{_mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(static_cast<float>(a))))};
+            return r * (1.5 - 0.5 * a * r * r);
+        }
+#endif
+        return 1.0 / std::sqrt(a);
+    }
+
+    inline long double rsqrt_approx(long double a) noexcept
+    {
+        return 1.0L / std::sqrt(a);
+    }
+
+#if defined(VECTORS_SIMD_SSE2)
+    // Four lanes of rsqrt_approx(float); lanes outside [FLT_MIN, FLT_MAX]
+    // are blended in from the exact 1 / sqrt(a)
+    inline __m128 rsqrt_approx(__m128 a) noexcept
+    {
+        const __m128 r{_mm_rsqrt_ps(a)};
+        const __m128 arr{_mm_mul_ps(_mm_mul_ps(a, r), r)};
+        const __m128 refined{_mm_mul_ps(r, _mm_sub_ps(_mm_set1_ps(1.5f), _mm_mul_ps(_mm_set1_ps(0.5f), arr)))};
+        const __m128 in_range{_mm_and_ps(_mm_cmpge_ps(a, _mm_set1_ps(FLT_MIN)), _mm_cmple_ps(a, _mm_set1_ps(FLT_MAX)))};
+        if (_mm_movemask_ps(in_range) == 0xF)
+            return refined;
+        const __m128 exact{_mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(a))};
+        return _mm_or_ps(_mm_and_ps(in_range, refined), _mm_andnot_ps(in_range, exact));
+    }
+#endif
+
+    // In-place square roots of m non-negative values. Explicit SIMD since
+    // std::sqrt may set errno, which keeps the compiler from vectorizing it.
+    inline void sqrt_block(float *v, std::size_t m) noexcept
+    {
+        std::size_t j{0};
+#if defined(VECTORS_SIMD_SSE2)
+        for (; j + 4 <= m; j += 4)
+            _mm_storeu_ps(v + j, _mm_sqrt_ps(_mm_loadu_ps(v + j)));
+#endif
+        for (; j < m; ++j)
+            v[j] = std::sqrt(v[j]);
+    }
+
+    inline void sqrt_block(double *v, std::size_t m) noexcept
+    {
+        std::size_t j{0};
+#if defined(VECTORS_SIMD_SSE2)
+        for (; j + 2 <= m; j += 2)
+            _mm_storeu_pd(v + j, _mm_sqrt_pd(_mm_loadu_pd(v + j)));
+#endif
+        for (; j < m; ++j)
+            v[j] = std::sqrt(v[j]);
+    }
+
+    template <typename T>
+    void sqrt_block(T *v, std::size_t m) noexcept
+    {
+        for (std::size_t j = 0; j < m; ++j)
+            v[j] = std::sqrt(v[j]);
+    }
+
+    // In-place rsqrt_approx of m values, mapping zero to one
+    inline void rsqrt_approx_block(float *v, std::size_t m) noexcept
+    {
+        std::size_t j{0};
+#if defined(VECTORS_SIMD_SSE2)
+        const __m128 zero{_mm_setzero_ps()};
+        const __m128 one{_mm_set1_ps(1.0f)};
+        for (; j + 4 <= m; j += 4)
+        {
+            const __m128 a{_mm_loadu_ps(v + j)};
+            const __m128 is_zero{_mm_cmpeq_ps(a, zero)};
+            const __m128 r{rsqrt_approx(a)};
+            _mm_storeu_ps(v + j, _mm_or_ps(_mm_and_ps(is_zero, one), _mm_andnot_ps(is_zero, r)));
+        }
+#endif
+        for (; j < m; ++j)
+            v[j] = v[j] != 0 ? rsqrt_approx(v[j]) : 1.0f;
+    }
+
+    template <typename T>
+    void rsqrt_approx_block(T *v, std::size_t m) noexcept
+    {
+        for (std::size_t j = 0; j < m; ++j)
+            v[j] = v[j] != 0 ? rsqrt_approx(v[j]) : static_cast<T>(1);
+    }
+} // namespace vec::detail
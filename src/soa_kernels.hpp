@@ -0,0 +1,371 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+#include "simd.hpp"
+#include "vector_dispatch.hpp"
+#include "vector_n.hpp"
+#include "vector_traits.hpp"
+
+/*
+ * Element-wise kernels over component streams (structure of arrays)
+ *
+ * The loops behind VectorArray's bulk operations, on one pointer per
+ * component. soa_loop holds the portable versions: plain loops the compiler
+ * vectorizes at the width of the build flags (or of a vec::dispatched
+ * level). soa_avx512 holds hand-written versions for float streams,
+ * sixteen elements per instruction, with masked loads and stores for the
+ * last partial register so nothing past n is read or written. They are
+ * compiled with target attributes in every GCC/Clang x86 build and run
+ * when active_simd_level() is avx512; the soa_* entry points choose.
+ *
+ * Products in the AVX-512 kernels are explicitly rounded multiplies, which
+ * the compiler cannot contract into FMAs, so both versions give the
+ * results of the Vector2/3/4 members built without FMA contraction.
+ */
+namespace vec::detail
+{
+    template <typename T, std::size_t N>
+    using const_streams = std::array<const T *, N>;
+
+    template <typename T, std::size_t N>
+    using streams = std::array<T *, N>;
+
+    namespace soa_loop
+    {
+        // r[i] = op(a[i], b[i]); r may be a or b
+        template <typename Op, typename T>
+        void zip(const T *a, const T *b, T *r, std::size_t n, Op op) noexcept
+        {
+            for (std::size_t i = 0; i < n; ++i)
+                r[i] = static_cast<T>(op(a[i], b[i]));
+        }
+
+        // r[i] = op(a[i], b); r may be a
+        template <typename Op, typename T>
+        void zip_scalar(const T *a, T b, T *r, std::size_t n, Op op) noexcept
+        {
+            for (std::size_t i = 0; i < n; ++i)
+                r[i] = static_cast<T>(op(a[i], b));
+        }
+
+        // r[i] = op(a[i]); r may be a
+        template <typename Op, typename T>
+        void map(const T *a, T *r, std::size_t n, Op op) noexcept
+        {
+            for (std::size_t i = 0; i < n; ++i)
+                r[i] = static_cast<T>(op(a[i]));
+        }
+
+        // Same summation order as the element type: ((x*x' + y*y') + z*z') + ...
+        template <typename T, std::size_t N, std::size_t... I>
+        void dot(const const_streams<T, N> &a, const const_streams<T, N> &b, T *out, std::size_t n,
+                 std::index_sequence<I...>) noexcept
+        {
+            for (std::size_t i = 0; i < n; ++i)
+                out[i] = (... + (a[I][i] * b[I][i]));
+        }
+
+        template <typename R, typename T, std::size_t N, std::size_t... I>
+        void norm_squared(const const_streams<T, N> &a, R *out, std::size_t n, std::index_sequence<I...>) noexcept
+        {
+            for (std::size_t i = 0; i < n; ++i)
+                out[i] = (... + (static_cast<R>(a[I][i]) * a[I][i]));
+        }
+
+        // Divided by the norm block by block; zero vectors are copied unchanged. Integer
+        // vectors take the exact path of the members: 64-bit squared norms and integer roots
+        template <typename T, std::size_t N>
+        void normalize(const const_streams<T, N> &a, const streams<T, N> &r, std::size_t n) noexcept
+        {
+            using R = std::conditional_t<integer_normalize<T, N>, std::uint64_t, norm_t<vector_of_t<T, N>>>;
+            R norms[kernel_block];
+            for (std::size_t i = 0; i < n; i += kernel_block)
+            {
+                const std::size_t m{std::min(kernel_block, n - i)};
+                const_streams<T, N> block;
+                for (std::size_t c = 0; c < N; ++c)
+                    block[c] = a[c] + i;
+                norm_squared(block, norms, m, std::make_index_sequence<N>{});
+                if constexpr (integer_normalize<T, N>)
+                {
+                    for (std::size_t j = 0; j < m; ++j)
+                        norms[j] = integer_sqrt(norms[j]);
+                    for (std::size_t c = 0; c < N; ++c)
+                        for (std::size_t j = 0; j < m; ++j)
+                            r[c][i + j] = divide_by_norm(a[c][i + j], norms[j]);
+                }
+                else
+                {
+                    sqrt_block(norms, m);
+                    for (std::size_t c = 0; c < N; ++c)
+                        for (std::size_t j = 0; j < m; ++j)
+                        {
+                            // Dividing by one keeps zero vectors unchanged without a branch
+                            const T d{norms[j] != 0 ? static_cast<T>(norms[j]) : static_cast<T>(1)};
+                            r[c][i + j] = a[c][i + j] / d;
+                        }
+                }
+            }
+        }
+
+        // r = a x b; r must not alias a or b
+        template <typename T>
+        void cross(const const_streams<T, 3> &a, const const_streams<T, 3> &b, const streams<T, 3> &r,
+                   std::size_t n) noexcept
+        {
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                r[0][i] = a[1][i] * b[2][i] - a[2][i] * b[1][i];
+                r[1][i] = a[2][i] * b[0][i] - a[0][i] * b[2][i];
+                r[2][i] = a[0][i] * b[1][i] - a[1][i] * b[0][i];
+            }
+        }
+    } // namespace soa_loop
+
+#if defined(VECTORS_DISPATCH)
+    namespace soa_avx512
+    {
+        // Whether the kernels run: on an AVX-512 CPU, unless VECTORS_SIMD_LEVEL says otherwise
+        inline bool active() noexcept
+        {
+            return active_simd_level() == simd_level::avx512;
+        }
+
+        // Scalar types and binary operations with an AVX-512 kernel
+        template <typename T>
+        inline constexpr bool scalar{std::is_same_v<T, float>};
+
+        template <typename Op>
+        inline constexpr bool supports{std::is_same_v<Op, plus_op> || std::is_same_v<Op, minus_op> ||
+                                       std::is_same_v<Op, multiplies_op> || std::is_same_v<Op, divides_op>};
+
+        // Lanes of the register at element i that are below n
+        VECTORS_TARGET_AVX512 inline __mmask16 lanes(std::size_t i, std::size_t n) noexcept
+        {
+            return n - i >= 16 ? static_cast<__mmask16>(0xFFFF) : static_cast<__mmask16>((1u << (n - i)) - 1);
+        }
+
+        VECTORS_TARGET_AVX512 inline __m512 load(__mmask16 k, const float *p) noexcept
+        {
+            return _mm512_maskz_loadu_ps(k, p);
+        }
+
+        VECTORS_TARGET_AVX512 inline void store(__mmask16 k, float *p, __m512 a) noexcept
+        {
+            _mm512_mask_storeu_ps(p, k, a);
+        }
+
+        // Rounded on its own, never fused with a neighbouring add. The
+        // zero-masked forms of mul and sqrt avoid GCC's false
+        // -Wmaybe-uninitialized on the unmasked ones.
+        VECTORS_TARGET_AVX512 inline __m512 mul(__m512 a, __m512 b) noexcept
+        {
+            return _mm512_maskz_mul_round_ps(static_cast<__mmask16>(0xFFFF), a, b,
+                                             _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+        }
+
+        VECTORS_TARGET_AVX512 inline __m512 sqrt(__m512 a) noexcept
+        {
+            return _mm512_maskz_sqrt_ps(static_cast<__mmask16>(0xFFFF), a);
+        }
+
+        template <typename Op>
+        VECTORS_TARGET_AVX512 inline __m512 apply(__m512 a, __m512 b) noexcept
+        {
+            if constexpr (std::is_same_v<Op, plus_op>)
+                return _mm512_add_ps(a, b);
+            else if constexpr (std::is_same_v<Op, minus_op>)
+                return _mm512_sub_ps(a, b);
+            else if constexpr (std::is_same_v<Op, multiplies_op>)
+                return mul(a, b);
+            else
+                return _mm512_div_ps(a, b);
+        }
+
+        template <typename Op>
+        VECTORS_TARGET_AVX512 void zip(const float *a, const float *b, float *r, std::size_t n) noexcept
+        {
+            for (std::size_t i = 0; i < n; i += 16)
+            {
+                const __mmask16 k{lanes(i, n)};
+                store(k, r + i, apply<Op>(load(k, a + i), load(k, b + i)));
+            }
+        }
+
+        template <typename Op>
+        VECTORS_TARGET_AVX512 void zip_scalar(const float *a, float b, float *r, std::size_t n) noexcept
+        {
+            const __m512 s{_mm512_set1_ps(b)};
+            for (std::size_t i = 0; i < n; i += 16)
+            {
+                const __mmask16 k{lanes(i, n)};
+                store(k, r + i, apply<Op>(load(k, a + i), s));
+            }
+        }
+
+        // Negation, the one unary operation: flips the sign bit as -a does
+        template <typename Op>
+        VECTORS_TARGET_AVX512 void map(const float *a, float *r, std::size_t n) noexcept
+        {
+            static_assert(std::is_same_v<Op, negate_op>, "no AVX-512 kernel for this operation");
+            const __m512 sign{_mm512_set1_ps(-0.0f)};
+            for (std::size_t i = 0; i < n; i += 16)
+            {
+                const __mmask16 k{lanes(i, n)};
+                store(k, r + i, _mm512_xor_ps(load(k, a + i), sign));
+            }
+        }
+
+        // Sum over components of a[c] * b[c] at element i, in component order
+        template <std::size_t N>
+        VECTORS_TARGET_AVX512 inline __m512 dot(const const_streams<float, N> &a, const const_streams<float, N> &b,
+                                                __mmask16 k, std::size_t i) noexcept
+        {
+            __m512 s{mul(load(k, a[0] + i), load(k, b[0] + i))};
+            for (std::size_t c = 1; c < N; ++c)
+                s = _mm512_add_ps(s, mul(load(k, a[c] + i), load(k, b[c] + i)));
+            return s;
+        }
+
+        template <std::size_t N>
+        VECTORS_TARGET_AVX512 void dot(const const_streams<float, N> &a, const const_streams<float, N> &b, float *out,
+                                       std::size_t n) noexcept
+        {
+            for (std::size_t i = 0; i < n; i += 16)
+            {
+                const __mmask16 k{lanes(i, n)};
+                store(k, out + i, dot<N>(a, b, k, i));
+            }
+        }
+
+        // Squared norms, or norms when root is set
+        template <std::size_t N>
+        VECTORS_TARGET_AVX512 void norm_squared(const const_streams<float, N> &a, float *out, std::size_t n,
+                                                bool root) noexcept
+        {
+            for (std::size_t i = 0; i < n; i += 16)
+            {
+                const __mmask16 k{lanes(i, n)};
+                const __m512 s{dot<N>(a, a, k, i)};
+                store(k, out + i, root ? sqrt(s) : s);
+            }
+        }
+
+        template <std::size_t N>
+        VECTORS_TARGET_AVX512 void normalize(const const_streams<float, N> &a, const streams<float, N> &r,
+                                             std::size_t n) noexcept
+        {
+            const __m512 one{_mm512_set1_ps(1.0f)};
+            for (std::size_t i = 0; i < n; i += 16)
+            {
+                const __mmask16 k{lanes(i, n)};
+                const __m512 norm{sqrt(dot<N>(a, a, k, i))};
+                const __m512 d{_mm512_mask_blend_ps(_mm512_cmpneq_ps_mask(norm, _mm512_setzero_ps()), one, norm)};
+                for (std::size_t c = 0; c < N; ++c)
+                    store(k, r[c] + i, _mm512_div_ps(load(k, a[c] + i), d));
+            }
+        }
+
+        VECTORS_TARGET_AVX512 inline void cross(const const_streams<float, 3> &a, const const_streams<float, 3> &b,
+                                                const streams<float, 3> &r, std::size_t n) noexcept
+        {
+            for (std::size_t i = 0; i < n; i += 16)
+            {
+                const __mmask16 k{lanes(i, n)};
+                const __m512 ax{load(k, a[0] + i)}, ay{load(k, a[1] + i)}, az{load(k, a[2] + i)};
+                const __m512 bx{load(k, b[0] + i)}, by{load(k, b[1] + i)}, bz{load(k, b[2] + i)};
+                store(k, r[0] + i, _mm512_sub_ps(mul(ay, bz), mul(az, by)));
+                store(k, r[1] + i, _mm512_sub_ps(mul(az, bx), mul(ax, bz)));
+                store(k, r[2] + i, _mm512_sub_ps(mul(ax, by), mul(ay, bx)));
+            }
+        }
+    } // namespace soa_avx512
+#endif
+
+    template <typename Op, typename T>
+    void soa_zip(const T *a, const T *b, T *r, std::size_t n, Op op) noexcept
+    {
+#if defined(VECTORS_DISPATCH)
+        if constexpr (soa_avx512::scalar<T> && soa_avx512::supports<Op>)
+            if (soa_avx512::active())
+                return soa_avx512::zip<Op>(a, b, r, n);
+#endif
+        soa_loop::zip(a, b, r, n, op);
+    }
+
+    template <typename Op, typename T>
+    void soa_zip_scalar(const T *a, T b, T *r, std::size_t n, Op op) noexcept
+    {
+#if defined(VECTORS_DISPATCH)
+        if constexpr (soa_avx512::scalar<T> && soa_avx512::supports<Op>)
+            if (soa_avx512::active())
+                return soa_avx512::zip_scalar<Op>(a, b, r, n);
+#endif
+        soa_loop::zip_scalar(a, b, r, n, op);
+    }
+
+    template <typename Op, typename T>
+    void soa_map(const T *a, T *r, std::size_t n, Op op) noexcept
+    {
+#if defined(VECTORS_DISPATCH)
+        if constexpr (soa_avx512::scalar<T> && std::is_same_v<Op, negate_op>)
+            if (soa_avx512::active())
+                return soa_avx512::map<Op>(a, r, n);
+#endif
+        soa_loop::map(a, r, n, op);
+    }
+
+    template <typename T, std::size_t N>
+    void soa_dot(const const_streams<T, N> &a, const const_streams<T, N> &b, T *out, std::size_t n) noexcept
+    {
+#if defined(VECTORS_DISPATCH)
+        if constexpr (soa_avx512::scalar<T>)
+            if (soa_avx512::active())
+                return soa_avx512::dot<N>(a, b, out, n);
+#endif
+        soa_loop::dot(a, b, out, n, std::make_index_sequence<N>{});
+    }
+
+    // Squared norms in R, or norms when root is set
+    template <typename R, typename T, std::size_t N>
+    void soa_norm_squared(const const_streams<T, N> &a, R *out, std::size_t n, bool root) noexcept
+    {
+#if defined(VECTORS_DISPATCH)
+        if constexpr (soa_avx512::scalar<T> && std::is_same_v<R, T>)
+            if (soa_avx512::active())
+                return soa_avx512::norm_squared<N>(a, out, n, root);
+#endif
+        soa_loop::norm_squared(a, out, n, std::make_index_sequence<N>{});
+        if (root)
+            sqrt_block(out, n);
+    }
+
+    template <typename T, std::size_t N>
+    void soa_normalize(const const_streams<T, N> &a, const streams<T, N> &r, std::size_t n) noexcept
+    {
+#if defined(VECTORS_DISPATCH)
+        if constexpr (soa_avx512::scalar<T>)
+            if (soa_avx512::active())
+                return soa_avx512::normalize<N>(a, r, n);
+#endif
+        soa_loop::normalize(a, r, n);
+    }
+
+    template <typename T>
+    void soa_cross(const const_streams<T, 3> &a, const const_streams<T, 3> &b, const streams<T, 3> &r,
+                   std::size_t n) noexcept
+    {
+#if defined(VECTORS_DISPATCH)
+        if constexpr (soa_avx512::scalar<T>)
+            if (soa_avx512::active())
+                return soa_avx512::cross(a, b, r, n);
+#endif
+        soa_loop::cross(a, b, r, n);
+    }
+} // namespace vec::detail
@@ -0,0 +1,613 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <unordered_map>
+#include <vector>
+
+#include "precision.hpp"
+#include "thread_pool.hpp"
+#include "vector_traits.hpp"
+
+/*
+ * Nearest-neighbour indexes over Vector2/3 points
+ *
+ * vec::KdTree is built once from an array and keeps the points in a single
+ * array in tree order, so a query walks contiguous memory. vec::HashGrid
+ * buckets points into cubic cells for data that changes: insert, remove and
+ * move are O(1) on average, and queries only look at cells near the query.
+ *
+ * Both report neighbours as (index, squared distance) pairs sorted by
+ * distance, then index, using the same (a - b).norm_squared() as a brute
+ * force search, so all three agree exactly, ties included.
+ */
+namespace vec
+{
+    // A stored point found by a query: its index (or grid id) and squared distance
+    template <typename D>
+    struct Neighbor
+    {
+        std::size_t index;
+        D distance_squared;
+
+        constexpr bool operator==(const Neighbor &o) const noexcept
+        {
+            return index == o.index && distance_squared == o.distance_squared;
+        }
+        constexpr bool operator!=(const Neighbor &o) const noexcept { return !(*this == o); }
+
+        // Closer first, lower index first among equal distances
+        constexpr bool operator<(const Neighbor &o) const noexcept
+        {
+            return distance_squared < o.distance_squared ||
+                   (distance_squared == o.distance_squared && index < o.index);
+        }
+    };
+
+    namespace detail
+    {
+        // Squared distances of vectors of V
+        template <typename V>
+        using distance_t = norm_precision_t<scalar_t<V>>;
+
+        // The k best neighbours seen so far, as a max-heap in out
+        template <typename D>
+        class nearest_heap
+        {
+        public:
+            nearest_heap(std::size_t k, std::vector<Neighbor<D>> &out) : k_(k), heap_(out)
+            {
+                heap_.clear();
+                heap_.reserve(k);
+            }
+
+            [[nodiscard]] bool full() const noexcept { return heap_.size() == k_; }
+
+            // Squared distance a point must not exceed to enter
+            [[nodiscard]] D worst() const noexcept
+            {
+                return full() ? heap_.front().distance_squared : std::numeric_limits<D>::infinity();
+            }
+
+            void push(std::size_t index, D distance_squared)
+            {
+                const Neighbor<D> n{index, distance_squared};
+                if (!full())
+                {
+                    heap_.push_back(n);
+                    std::push_heap(heap_.begin(), heap_.end());
+                }
+                else if (n < heap_.front())
+                {
+                    std::pop_heap(heap_.begin(), heap_.end());
+                    heap_.back() = n;
+                    std::push_heap(heap_.begin(), heap_.end());
+                }
+            }
+
+            // Leaves the neighbours sorted, closest first
+            void finish() { std::sort_heap(heap_.begin(), heap_.end()); }
+
+        private:
+            std::size_t k_;
+            std::vector<Neighbor<D>> &heap_;
+        };
+
+        // Queries per task of a batch
+        inline constexpr std::size_t query_chunk{64};
+
+        /**
+         * @brief Runs the k nearest neighbours of m queries on the pool
+         *
+         * knn(q, k, scratch) fills scratch with the neighbours of q; they are
+         * copied to out[i * k, (i + 1) * k).
+         */
+        template <typename V, typename D, typename Knn>
+        void knn_batch(const V *queries, std::size_t m, std::size_t k, Neighbor<D> *out, ThreadPool &pool, Knn knn)
+        {
+            pool.parallel_for((m + query_chunk - 1) / query_chunk,
+                              [&](std::size_t c)
+                              {
+                                  std::vector<Neighbor<D>> scratch;
+                                  for (std::size_t i = c * query_chunk; i < std::min(m, (c + 1) * query_chunk); ++i)
+                                  {
+                                      knn(queries[i], k, scratch);
+                                      std::copy(scratch.begin(), scratch.end(), out + i * k);
+                                  }
+                              });
+        }
+    } // namespace detail
+
+    /**
+     * @brief Static k-d tree over an array of points
+     *
+     * The points are copied and reordered so that every node is a contiguous
+     * range: a range of more than leaf_size points keeps its median point m
+     * along the axis of widest spread, with [begin, m) on the low side and
+     * (m, end) on the high side. Child ranges are implied by the split, so
+     * the only per-node data is that axis. Queries report the indices the
+     * points had in the input array.
+     */
+    template <typename V>
+    class KdTree
+    {
+    public:
+        using vector_type = V;
+        using distance_type = detail::distance_t<V>;
+        using neighbor_type = Neighbor<distance_type>;
+
+        // Largest range stored as a leaf (scanned linearly)
+        static constexpr std::size_t leaf_size{8};
+
+        explicit KdTree(const V *points, std::size_t n) : points_(n), indices_(n), axes_(n)
+        {
+            std::iota(indices_.begin(), indices_.end(), std::size_t{0});
+            build(points, 0, n);
+            for (std::size_t i = 0; i < n; ++i)
+                points_[i] = points[indices_[i]];
+        }
+
+        [[nodiscard]] std::size_t size() const noexcept { return points_.size(); }
+        [[nodiscard]] bool empty() const noexcept { return points_.empty(); }
+
+        // The min(k, size()) points nearest to q, closest first
+        void knn(const V &q, std::size_t k, std::vector<neighbor_type> &out) const
+        {
+            detail::nearest_heap<distance_type> heap(std::min(k, size()), out);
+            if (k > 0)
+                search(0, size(), q, heap);
+            heap.finish();
+        }
+
+        // The points within distance r of q (boundary included), closest first
+        void radius(const V &q, distance_type r, std::vector<neighbor_type> &out) const
+        {
+            out.clear();
+            search_radius(0, size(), q, r * r, out);
+            std::sort(out.begin(), out.end());
+        }
+
+        // knn() of m queries into out[i * k, (i + 1) * k), split across the pool; k <= size()
+        void knn_many(const V *queries, std::size_t m, std::size_t k, neighbor_type *out,
+                      ThreadPool &pool = ThreadPool::global()) const
+        {
+            assert(k <= size());
+            detail::knn_batch(queries, m, k, out, pool,
+                              [this](const V &q, std::size_t kk, std::vector<neighbor_type> &r) { knn(q, kk, r); });
+        }
+
+    private:
+        static constexpr std::size_t N{detail::vector_traits<V>::size};
+
+        // Arranges indices_[begin, end) into a subtree
+        void build(const V *points, std::size_t begin, std::size_t end)
+        {
+            if (end - begin <= leaf_size)
+                return;
+
+            // Axis of widest spread
+            V lo{points[indices_[begin]]};
+            V hi{lo};
+            for (std::size_t i = begin + 1; i < end; ++i)
+            {
+                lo = lo.min(points[indices_[i]]);
+                hi = hi.max(points[indices_[i]]);
+            }
+            const V spread{hi - lo};
+            std::size_t axis{0};
+            for (std::size_t a = 1; a < N; ++a)
+                if (spread[a] > spread[axis])
+                    axis = a;
+
+            const std::size_t mid{begin + (end - begin) / 2};
+            std::nth_element(indices_.begin() + begin, indices_.begin() + mid, indices_.begin() + end,
+                             [points, axis](std::size_t a, std::size_t b) { return points[a][axis] < points[b][axis]; });
+            axes_[mid] = static_cast<unsigned char>(axis);
+            build(points, begin, mid);
+            build(points, mid + 1, end);
+        }
+
+        // Signed distance of q from the splitting plane of the range whose median is mid
+        distance_type plane_offset(const V &q, std::size_t mid) const noexcept
+        {
+            const std::size_t axis{axes_[mid]};
+            return static_cast<distance_type>(q[axis]) - static_cast<distance_type>(points_[mid][axis]);
+        }
+
+        void search(std::size_t begin, std::size_t end, const V &q, detail::nearest_heap<distance_type> &heap) const
+        {
+            if (end - begin <= leaf_size)
+            {
+                for (std::size_t i = begin; i < end; ++i)
+                    heap.push(indices_[i], (points_[i] - q).norm_squared());
+                return;
+            }
+            // Nearer side first; the other only if the plane is within reach
+            const std::size_t mid{begin + (end - begin) / 2};
+            heap.push(indices_[mid], (points_[mid] - q).norm_squared());
+            const distance_type d{plane_offset(q, mid)};
+            if (d < 0)
+            {
+                search(begin, mid, q, heap);
+                if (d * d <= heap.worst())
+                    search(mid + 1, end, q, heap);
+            }
+            else
+            {
+                search(mid + 1, end, q, heap);
+                if (d * d <= heap.worst())
+                    search(begin, mid, q, heap);
+            }
+        }
+
+        void search_radius(std::size_t begin, std::size_t end, const V &q, distance_type r2,
+                           std::vector<neighbor_type> &out) const
+        {
+            if (end - begin <= leaf_size)
+            {
+                for (std::size_t i = begin; i < end; ++i)
+                {
+                    const distance_type d2{(points_[i] - q).norm_squared()};
+                    if (d2 <= r2)
+                        out.push_back({indices_[i], d2});
+                }
+                return;
+            }
+            const std::size_t mid{begin + (end - begin) / 2};
+            const distance_type d2{(points_[mid] - q).norm_squared()};
+            if (d2 <= r2)
+                out.push_back({indices_[mid], d2});
+            const distance_type d{plane_offset(q, mid)};
+            if (d < 0 || d * d <= r2)
+                search_radius(begin, mid, q, r2, out);
+            if (d >= 0 || d * d <= r2)
+                search_radius(mid + 1, end, q, r2, out);
+        }
+
+        std::vector<V> points_;
+        std::vector<std::size_t> indices_;
+        // Split axis of each internal node, stored at the position of its median
+        std::vector<unsigned char> axes_;
+    };
+
+    /**
+     * @brief Uniform grid of cubic cells hashed by their integer coordinates
+     *
+     * insert() returns an id that stays valid until the point is removed;
+     * ids of removed points are reused. Queries visit the query's cell,
+     * then rings of cells around it, so cell_size should be close to the
+     * typical distance between neighbours: much smaller means many empty
+     * cells per query, much larger means scanning many points per cell.
+     * When a ring would cover more cells than are occupied, the remaining
+     * occupied cells are scanned directly.
+     */
+    template <typename V>
+    class HashGrid
+    {
+    public:
+        using vector_type = V;
+        using distance_type = detail::distance_t<V>;
+        using neighbor_type = Neighbor<distance_type>;
+
+        explicit HashGrid(distance_type cell_size) : cell_size_(cell_size), inv_cell_size_(1 / cell_size)
+        {
+            assert(cell_size > 0);
+        }
+
+        [[nodiscard]] std::size_t size() const noexcept { return size_; }
+        [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+        [[nodiscard]] distance_type cell_size() const noexcept { return cell_size_; }
+
+        // True while id refers to a stored point
+        [[nodiscard]] bool contains(std::size_t id) const noexcept { return id < alive_.size() && alive_[id]; }
+        [[nodiscard]] const V &point(std::size_t id) const noexcept
+        {
+            assert(contains(id));
+            return points_[id];
+        }
+
+        std::size_t insert(const V &p)
+        {
+            std::size_t id;
+            if (!free_.empty())
+            {
+                id = free_.back();
+                free_.pop_back();
+                points_[id] = p;
+                alive_[id] = true;
+            }
+            else
+            {
+                id = points_.size();
+                points_.push_back(p);
+                alive_.push_back(true);
+            }
+            cells_[cell_of(p)].push_back({p, id});
+            ++size_;
+            return id;
+        }
+
+        void remove(std::size_t id)
+        {
+            assert(contains(id));
+            unlink(id);
+            alive_[id] = false;
+            free_.push_back(id);
+            --size_;
+        }
+
+        // Moves a stored point, keeping its id
+        void move(std::size_t id, const V &p)
+        {
+            assert(contains(id));
+            const cell_key from{cell_of(points_[id])};
+            const cell_key to{cell_of(p)};
+            points_[id] = p;
+            if (from == to)
+            {
+                for (entry &e : cells_.find(from)->second)
+                    if (e.id == id)
+                        e.point = p;
+                return;
+            }
+            unlink_from(from, id);
+            cells_[to].push_back({p, id});
+        }
+
+        void clear() noexcept
+        {
+            cells_.clear();
+            points_.clear();
+            alive_.clear();
+            free_.clear();
+            size_ = 0;
+        }
+
+        // The min(k, size()) points nearest to q, closest first
+        void knn(const V &q, std::size_t k, std::vector<neighbor_type> &out) const
+        {
+            detail::nearest_heap<distance_type> heap(std::min(k, size_), out);
+            if (k == 0 || size_ == 0)
+                return;
+
+            const cell_key center{cell_of(q)};
+            const auto visit = [&](const bucket &b)
+            {
+                for (const entry &e : b)
+                    heap.push(e.id, (e.point - q).norm_squared());
+            };
+            std::size_t seen{0};
+            for (std::int64_t r = 0;; ++r)
+            {
+                if (ring_cells(r) > cells_.size())
+                {
+                    // Cheaper to scan the occupied cells not visited yet
+                    for (const auto &[key, b] : cells_)
+                        if (chebyshev(key, center) >= r)
+                            visit(b);
+                    break;
+                }
+                for_each_in_ring(center, r, [&](const bucket &b)
+                                 {
+                                     visit(b);
+                                     seen += b.size();
+                                 });
+                // Unvisited points are at least as far as the border of rings 0..r
+                const distance_type border{border_distance(q, center, r)};
+                if (seen == size_ || (heap.full() && heap.worst() < border * border))
+                    break;
+            }
+            heap.finish();
+        }
+
+        // The points within distance r of q (boundary included), closest first
+        void radius(const V &q, distance_type r, std::vector<neighbor_type> &out) const
+        {
+            out.clear();
+            const distance_type r2{r * r};
+            const auto visit = [&](const bucket &b)
+            {
+                for (const entry &e : b)
+                {
+                    const distance_type d2{(e.point - q).norm_squared()};
+                    if (d2 <= r2)
+                        out.push_back({e.id, d2});
+                }
+            };
+
+            cell_key lo{};
+            cell_key hi{};
+            double cells{1};
+            for (std::size_t a = 0; a < N; ++a)
+            {
+                lo[a] = coordinate(static_cast<distance_type>(q[a]) - r);
+                hi[a] = coordinate(static_cast<distance_type>(q[a]) + r);
+                cells *= static_cast<double>(hi[a] - lo[a] + 1);
+            }
+            if (cells > static_cast<double>(cells_.size()))
+            {
+                for (const auto &[key, b] : cells_)
+                    visit(b);
+            }
+            else
+            {
+                cell_key c{lo};
+                do
+                    if (const auto it{cells_.find(c)}; it != cells_.end())
+                        visit(it->second);
+                while (next_cell(c, lo, hi));
+            }
+            std::sort(out.begin(), out.end());
+        }
+
+        // knn() of m queries into out[i * k, (i + 1) * k), split across the pool; k <= size()
+        void knn_many(const V *queries, std::size_t m, std::size_t k, neighbor_type *out,
+                      ThreadPool &pool = ThreadPool::global()) const
+        {
+            assert(k <= size());
+            detail::knn_batch(queries, m, k, out, pool,
+                              [this](const V &q, std::size_t kk, std::vector<neighbor_type> &r) { knn(q, kk, r); });
+        }
+
+    private:
+        static constexpr std::size_t N{detail::vector_traits<V>::size};
+
+        // Cell coordinates beyond this are clamped (also keeps ring arithmetic from overflowing)
+        static constexpr std::int64_t max_coordinate{std::int64_t{1} << 40};
+
+        using cell_key = std::array<std::int64_t, N>;
+
+        struct cell_hash
+        {
+            std::size_t operator()(const cell_key &key) const noexcept
+            {
+                std::uint64_t h{0};
+                for (std::int64_t c : key)
+                    h = (h ^ static_cast<std::uint64_t>(c)) * 0x9E3779B97F4A7C15u;
+                return static_cast<std::size_t>(h ^ (h >> 29));
+            }
+        };
+
+        // Points are kept next to their id so that scanning a cell reads one array
+        struct entry
+        {
+            V point;
+            std::size_t id;
+        };
+        using bucket = std::vector<entry>;
+
+        std::int64_t coordinate(distance_type x) const noexcept
+        {
+            const distance_type c{std::floor(x * inv_cell_size_)};
+            if (c > static_cast<distance_type>(max_coordinate))
+                return max_coordinate;
+            if (c >= static_cast<distance_type>(-max_coordinate))
+                return static_cast<std::int64_t>(c);
+            return -max_coordinate; // also NaN
+        }
+
+        cell_key cell_of(const V &p) const noexcept
+        {
+            cell_key key;
+            for (std::size_t a = 0; a < N; ++a)
+                key[a] = coordinate(static_cast<distance_type>(p[a]));
+            return key;
+        }
+
+        static std::int64_t chebyshev(const cell_key &x, const cell_key &y) noexcept
+        {
+            std::int64_t d{0};
+            for (std::size_t a = 0; a < N; ++a)
+                d = std::max(d, x[a] > y[a] ? x[a] - y[a] : y[a] - x[a]);
+            return d;
+        }
+
+        // Cells at Chebyshev distance exactly r (as a double: only compared)
+        static double ring_cells(std::int64_t r) noexcept
+        {
+            double outer{1};
+            double inner{1};
+            for (std::size_t a = 0; a < N; ++a)
+            {
+                outer *= static_cast<double>(2 * r + 1);
+                inner *= static_cast<double>(2 * r - 1);
+            }
+            return r == 0 ? 1.0 : outer - inner;
+        }
+
+        // Advances c through the box [lo, hi] in odometer order; false after the last cell
+        static bool next_cell(cell_key &c, const cell_key &lo, const cell_key &hi) noexcept
+        {
+            for (std::size_t a = 0; a < N; ++a)
+            {
+                if (c[a] < hi[a])
+                {
+                    ++c[a];
+                    return true;
+                }
+                c[a] = lo[a];
+            }
+            return false;
+        }
+
+        // Occupied cells at Chebyshev distance exactly r, ring_cells(r) lookups: for each axis a
+        // the two faces at center[a] -+ r, with the axes before a kept inside so no cell repeats
+        template <typename F>
+        void for_each_in_ring(const cell_key &center, std::int64_t r, F f) const
+        {
+            const auto visit = [&](const cell_key &c)
+            {
+                if (const auto it{cells_.find(c)}; it != cells_.end())
+                    f(it->second);
+            };
+            if (r == 0)
+            {
+                visit(center);
+                return;
+            }
+            for (std::size_t a = 0; a < N; ++a)
+                for (const std::int64_t side : {-r, r})
+                {
+                    cell_key lo{};
+                    cell_key hi{};
+                    for (std::size_t b = 0; b < N; ++b)
+                    {
+                        const std::int64_t inset{b < a ? 1 : 0};
+                        lo[b] = center[b] - r + inset;
+                        hi[b] = center[b] + r - inset;
+                    }
+                    lo[a] = center[a] + side;
+                    hi[a] = lo[a];
+                    cell_key c{lo};
+                    do
+                        visit(c);
+                    while (next_cell(c, lo, hi));
+                }
+        }
+
+        // Distance from q to the outside of the cells within Chebyshev distance r of center
+        distance_type border_distance(const V &q, const cell_key &center, std::int64_t r) const noexcept
+        {
+            distance_type d{std::numeric_limits<distance_type>::infinity()};
+            for (std::size_t a = 0; a < N; ++a)
+            {
+                const distance_type x{static_cast<distance_type>(q[a])};
+                const distance_type lo{static_cast<distance_type>(center[a] - r) * cell_size_};
+                const distance_type hi{static_cast<distance_type>(center[a] + r + 1) * cell_size_};
+                d = std::min(d, std::min(x - lo, hi - x));
+            }
+            return std::max(d, distance_type{0});
+        }
+
+        void unlink_from(const cell_key &key, std::size_t id)
+        {
+            const auto it{cells_.find(key)};
+            bucket &b{it->second};
+            for (std::size_t i = 0; i < b.size(); ++i)
+                if (b[i].id == id)
+                {
+                    b[i] = b.back();
+                    b.pop_back();
+                    break;
+                }
+            if (b.empty())
+                cells_.erase(it);
+        }
+
+        void unlink(std::size_t id) { unlink_from(cell_of(points_[id]), id); }
+
+        distance_type cell_size_;
+        distance_type inv_cell_size_;
+        std::unordered_map<cell_key, bucket, cell_hash> cells_;
+        std::vector<V> points_;
+        std::vector<bool> alive_;
+        std::vector<std::size_t> free_;
+        std::size_t size_{0};
+    };
+} // namespace vec
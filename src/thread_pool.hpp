@@ -0,0 +1,212 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace vec
+{
+    /**
+     * @brief Fixed set of worker threads running parallel loops
+     *
+     * parallel_for(chunks, f) calls f(i) once for every chunk index i and
+     * returns when all calls are done. The indices are dealt out as one
+     * contiguous range per participant (the workers and the calling thread);
+     * a participant that runs out of work steals the back half of another
+     * one's range, so uneven chunks are rebalanced without a shared queue.
+     *
+     * One loop runs at a time: concurrent callers are serialized, and a
+     * parallel_for issued from inside a chunk runs inline on that thread.
+     * f must not throw.
+     */
+    class ThreadPool
+    {
+    public:
+        // threads counts the calling thread: ThreadPool(1) starts no workers
+        explicit ThreadPool(std::size_t threads = default_threads())
+            : slots_(std::max<std::size_t>(threads, 1))
+        {
+            workers_.reserve(slots_.size() - 1);
+            for (std::size_t p = 1; p < slots_.size(); ++p)
+                workers_.emplace_back([this, p] { worker_loop(p); });
+        }
+
+        ThreadPool(const ThreadPool &) = delete;
+        ThreadPool &operator=(const ThreadPool &) = delete;
+
+        ~ThreadPool()
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                stop_ = true;
+            }
+            wake_.notify_all();
+            for (std::thread &t : workers_)
+                t.join();
+        }
+
+        // Number of participants in a loop, including the calling thread
+        [[nodiscard]] std::size_t size() const noexcept { return slots_.size(); }
+
+        [[nodiscard]] static std::size_t default_threads() noexcept
+        {
+            return std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+        }
+
+        // Process-wide pool with one participant per hardware thread
+        [[nodiscard]] static ThreadPool &global()
+        {
+            static ThreadPool pool;
+            return pool;
+        }
+
+        template <typename F>
+        void parallel_for(std::size_t chunks, F &&f)
+        {
+            if (chunks == 0)
+                return;
+            if (chunks == 1 || size() == 1 || inside_loop())
+            {
+                for (std::size_t i = 0; i < chunks; ++i)
+                    f(i);
+                return;
+            }
+
+            assert(chunks <= 0xFFFFFFFFu && "chunk indices are packed in 32 bits");
+            std::lock_guard<std::mutex> serial(submit_);
+            const std::size_t participants{size()};
+            for (std::size_t p = 0; p < participants; ++p)
+                slots_[p].range.store(pack(chunks * p / participants, chunks * (p + 1) / participants),
+                                      std::memory_order_relaxed);
+
+            job_.fn = const_cast<void *>(static_cast<const void *>(&f));
+            job_.call = [](void *fn, std::size_t i) { (*static_cast<std::remove_reference_t<F> *>(fn))(i); };
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                ++generation_;
+                running_ = true;
+            }
+            wake_.notify_all();
+
+            participate(0);
+
+            std::unique_lock<std::mutex> lock(mutex_);
+            running_ = false;
+            done_.wait(lock, [this] { return active_ == 0; });
+        }
+
+    private:
+        // Remaining chunk indices [begin, end) of one participant, packed in 64 bits
+        struct alignas(64) slot
+        {
+            std::atomic<std::uint64_t> range{0};
+        };
+
+        struct job
+        {
+            void *fn;
+            void (*call)(void *, std::size_t);
+        };
+
+        static std::uint64_t pack(std::uint64_t begin, std::uint64_t end) noexcept { return begin << 32 | end; }
+        static std::size_t begin_of(std::uint64_t r) noexcept { return static_cast<std::size_t>(r >> 32); }
+        static std::size_t end_of(std::uint64_t r) noexcept { return static_cast<std::size_t>(r & 0xFFFFFFFFu); }
+
+        static bool &inside_loop() noexcept
+        {
+            thread_local bool inside{false};
+            return inside;
+        }
+
+        // Take the first remaining index of participant p
+        bool pop(std::size_t p, std::size_t &i) noexcept
+        {
+            std::atomic<std::uint64_t> &range{slots_[p].range};
+            std::uint64_t r{range.load(std::memory_order_relaxed)};
+            while (begin_of(r) < end_of(r))
+                if (range.compare_exchange_weak(r, pack(begin_of(r) + 1, end_of(r)), std::memory_order_relaxed))
+                {
+                    i = begin_of(r);
+                    return true;
+                }
+            return false;
+        }
+
+        // Move the back half of some other participant's range to participant p
+        bool steal(std::size_t p) noexcept
+        {
+            const std::size_t participants{size()};
+            for (std::size_t k = 1; k < participants; ++k)
+            {
+                std::atomic<std::uint64_t> &victim{slots_[(p + k) % participants].range};
+                std::uint64_t r{victim.load(std::memory_order_relaxed)};
+                while (begin_of(r) < end_of(r))
+                {
+                    const std::size_t mid{begin_of(r) + (end_of(r) - begin_of(r)) / 2};
+                    if (victim.compare_exchange_weak(r, pack(begin_of(r), mid), std::memory_order_relaxed))
+                    {
+                        slots_[p].range.store(pack(mid, end_of(r)), std::memory_order_relaxed);
+                        return true;
+                    }
+                }
+            }
+            return false;
+        }
+
+        void participate(std::size_t p)
+        {
+            inside_loop() = true;
+            std::size_t i{0};
+            do
+                while (pop(p, i))
+                    job_.call(job_.fn, i);
+            while (steal(p));
+            inside_loop() = false;
+        }
+
+        void worker_loop(std::size_t p)
+        {
+            std::uint64_t seen{0};
+            for (;;)
+            {
+                {
+                    std::unique_lock<std::mutex> lock(mutex_);
+                    wake_.wait(lock, [&] { return stop_ || generation_ != seen; });
+                    if (stop_)
+                        return;
+                    seen = generation_;
+                    // Woken after the loop already finished
+                    if (!running_)
+                        continue;
+                    ++active_;
+                }
+                participate(p);
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    if (--active_ == 0)
+                        done_.notify_one();
+                }
+            }
+        }
+
+        std::vector<slot> slots_;
+        std::vector<std::thread> workers_;
+        job job_{};
+
+        std::mutex submit_;
+        std::mutex mutex_;
+        std::condition_variable wake_;
+        std::condition_variable done_;
+        std::uint64_t generation_{0};
+        std::size_t active_{0};
+        bool running_{false};
+        bool stop_{false};
+    };
+} // namespace vec
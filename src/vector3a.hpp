@@ -0,0 +1,25 @@
+#pragma once
+
+#include "vector3.hpp"
+#include "vector_n.hpp"
+
+/**
+ * @brief 3D vector padded to four lanes and aligned to the register width
+ *
+ * A Vector3 with a hidden fourth lane that is always zero: 4 * sizeof(T)
+ * bytes, aligned to 16 / 32 / 16 bytes for float, double and int. Every
+ * operation is a single load, one register instruction and a store on the
+ * SIMD backend (see simd.hpp), and arrays of them never straddle a cache
+ * line. Dot products and norms sum the four lanes pairwise, so they may
+ * differ from Vector3 in the last bit.
+ *
+ * It is a VectorN (padded, see vector_n.hpp), so it has the whole Vector3
+ * interface, and converts implicitly from and to Vector3<T>.
+ */
+template <typename T>
+using Vector3A = VectorN<T, 3, true>;
+
+// Type aliases
+using Vector3Ai = Vector3A<int>;
+using Vector3Af = Vector3A<float>;
+using Vector3Ad = Vector3A<double>;
@@ -0,0 +1,393 @@
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <initializer_list>
+#include <type_traits>
+#include <utility>
+
+#include "aligned_allocator.hpp"
+#include "simd.hpp"
+#include "soa_kernels.hpp"
+#include "vector_traits.hpp"
+
+/**
+ * @brief Structure-of-arrays container of 2D, 3D or 4D vectors
+ *
+ * Each component lives in its own cache-line aligned stream (x[], y[], z[],
+ * w[]), so bulk operations are plain contiguous loops that the compiler
+ * vectorizes at full register width; float arrays switch to AVX-512 kernels
+ * on CPUs that have it (see soa_kernels.hpp). Elements are read and written
+ * as Vector2/3/4 values through a proxy reference.
+ *
+ * Bulk operations mirror the members of the element type and produce the
+ * same results element by element.
+ */
+template <typename T, std::size_t N>
+class VectorArray
+{
+    static_assert(N >= 2 && N <= 4, "VectorArray supports 2, 3 or 4 components");
+
+public:
+    using value_type = vec::detail::vector_of_t<T, N>;
+    using stream_type = vec::aligned_vector<T>;
+    using norm_type = vec::detail::norm_t<value_type>;
+    using size_type = std::size_t;
+
+    // Proxy to one element of the array
+    class reference
+    {
+    public:
+        reference(const reference &) noexcept = default;
+
+        operator value_type() const noexcept { return array_.get(index_); }
+
+        reference &operator=(const value_type &v) noexcept
+        {
+            array_.set(index_, v);
+            return *this;
+        }
+        reference &operator=(const reference &o) noexcept { return *this = static_cast<value_type>(o); }
+
+        reference &operator+=(const value_type &v) noexcept { return *this = static_cast<value_type>(*this) + v; }
+        reference &operator-=(const value_type &v) noexcept { return *this = static_cast<value_type>(*this) - v; }
+        reference &operator*=(const value_type &v) noexcept { return *this = static_cast<value_type>(*this) * v; }
+        reference &operator/=(const value_type &v) noexcept { return *this = static_cast<value_type>(*this) / v; }
+        reference &operator*=(T s) noexcept { return *this = static_cast<value_type>(*this) * s; }
+        reference &operator/=(T s) noexcept { return *this = static_cast<value_type>(*this) / s; }
+
+        friend bool operator==(const reference &r, const value_type &v) noexcept { return static_cast<value_type>(r) == v; }
+
+    private:
+        friend class VectorArray;
+        reference(VectorArray &array, size_type index) noexcept : array_(array), index_(index) {}
+
+        VectorArray &array_;
+        size_type index_;
+    };
+
+    // Constructors
+    VectorArray() = default;
+    explicit VectorArray(size_type n) : VectorArray(n, value_type()) {}
+    VectorArray(size_type n, const value_type &v) { resize(n, v); }
+    VectorArray(std::initializer_list<value_type> values) : VectorArray(values.begin(), values.size()) {}
+
+    // Copy from an array-of-structures buffer
+    VectorArray(const value_type *values, size_type n)
+    {
+        reserve(n);
+        for (size_type i = 0; i < n; ++i)
+            push_back(values[i]);
+    }
+
+    // Array of n elements with unspecified values, for callers that overwrite every element
+    [[nodiscard]] static VectorArray uninitialized(size_type n)
+    {
+        VectorArray out;
+        for (auto &s : out.streams_)
+            s.resize(n);
+        return out;
+    }
+
+    // Size and capacity
+    [[nodiscard]] size_type size() const noexcept { return streams_[0].size(); }
+    [[nodiscard]] bool empty() const noexcept { return streams_[0].empty(); }
+
+    void resize(size_type n) { resize(n, value_type()); }
+    void resize(size_type n, const value_type &v)
+    {
+        for_each_component([&](auto c)
+                           { streams_[c].resize(n, vec::detail::component<c>(v)); });
+    }
+    void reserve(size_type n)
+    {
+        for (auto &s : streams_)
+            s.reserve(n);
+    }
+    void clear() noexcept
+    {
+        for (auto &s : streams_)
+            s.clear();
+    }
+    void push_back(const value_type &v)
+    {
+        for_each_component([&](auto c)
+                           { streams_[c].push_back(vec::detail::component<c>(v)); });
+    }
+
+    // Element access
+    reference operator[](size_type i) noexcept { return reference(*this, i); }
+    value_type operator[](size_type i) const noexcept { return get(i); }
+
+    // Component streams
+    [[nodiscard]] T *data(size_type c) noexcept { return streams_[c].data(); }
+    [[nodiscard]] const T *data(size_type c) const noexcept { return streams_[c].data(); }
+
+    [[nodiscard]] T *x() noexcept { return data(0); }
+    [[nodiscard]] const T *x() const noexcept { return data(0); }
+    [[nodiscard]] T *y() noexcept { return data(1); }
+    [[nodiscard]] const T *y() const noexcept { return data(1); }
+
+    template <size_type M = N, std::enable_if_t<(M > 2), int> = 0>
+    [[nodiscard]] T *z() noexcept { return data(2); }
+    template <size_type M = N, std::enable_if_t<(M > 2), int> = 0>
+    [[nodiscard]] const T *z() const noexcept { return data(2); }
+
+    template <size_type M = N, std::enable_if_t<(M > 3), int> = 0>
+    [[nodiscard]] T *w() noexcept { return data(3); }
+    template <size_type M = N, std::enable_if_t<(M > 3), int> = 0>
+    [[nodiscard]] const T *w() const noexcept { return data(3); }
+
+    // Copy to an array-of-structures buffer of size() elements
+    void copy_to(value_type *out) const noexcept
+    {
+        for (size_type i = 0; i < size(); ++i)
+            out[i] = get(i);
+    }
+
+    // Array - Array operations
+    VectorArray operator+(const VectorArray &o) const { return zip(o, vec::detail::plus_op{}); }
+    VectorArray operator-(const VectorArray &o) const { return zip(o, vec::detail::minus_op{}); }
+    VectorArray operator*(const VectorArray &o) const { return zip(o, vec::detail::multiplies_op{}); }
+    VectorArray operator/(const VectorArray &o) const { return zip(o, vec::detail::divides_op{}); }
+
+    // Array - Vector operations (same vector for every element)
+    VectorArray operator+(const value_type &v) const { return zip(v, vec::detail::plus_op{}); }
+    VectorArray operator-(const value_type &v) const { return zip(v, vec::detail::minus_op{}); }
+    VectorArray operator*(const value_type &v) const { return zip(v, vec::detail::multiplies_op{}); }
+    VectorArray operator/(const value_type &v) const { return zip(v, vec::detail::divides_op{}); }
+
+    // Array - Scalar operations
+    VectorArray operator+(T s) const { return zip(s, vec::detail::plus_op{}); }
+    VectorArray operator-(T s) const { return zip(s, vec::detail::minus_op{}); }
+    VectorArray operator*(T s) const { return zip(s, vec::detail::multiplies_op{}); }
+    VectorArray operator/(T s) const { return zip(s, vec::detail::divides_op{}); }
+
+    // Unary
+    VectorArray operator-() const
+    {
+        const size_type n{size()};
+        VectorArray out{uninitialized(n)};
+        for (size_type c = 0; c < N; ++c)
+            vec::detail::soa_map(data(c), out.data(c), n, vec::detail::negate_op{});
+        return out;
+    }
+
+    // Compound assignment
+    VectorArray &operator+=(const VectorArray &o) noexcept { return zip_assign(o, vec::detail::plus_op{}); }
+    VectorArray &operator-=(const VectorArray &o) noexcept { return zip_assign(o, vec::detail::minus_op{}); }
+    VectorArray &operator*=(const VectorArray &o) noexcept { return zip_assign(o, vec::detail::multiplies_op{}); }
+    VectorArray &operator/=(const VectorArray &o) noexcept { return zip_assign(o, vec::detail::divides_op{}); }
+
+    VectorArray &operator+=(T s) noexcept { return zip_assign(s, vec::detail::plus_op{}); }
+    VectorArray &operator-=(T s) noexcept { return zip_assign(s, vec::detail::minus_op{}); }
+    VectorArray &operator*=(T s) noexcept { return zip_assign(s, vec::detail::multiplies_op{}); }
+    VectorArray &operator/=(T s) noexcept { return zip_assign(s, vec::detail::divides_op{}); }
+
+    // Dot products of matching elements
+    [[nodiscard]] vec::aligned_vector<T> dot(const VectorArray &o) const
+    {
+        assert(size() == o.size());
+        vec::aligned_vector<T> out(size());
+        vec::detail::soa_dot(streams(), o.streams(), out.data(), size());
+        return out;
+    }
+
+    // Cross products of matching elements
+    template <size_type M = N, std::enable_if_t<M == 3, int> = 0>
+    [[nodiscard]] VectorArray cross(const VectorArray &o) const
+    {
+        assert(size() == o.size());
+        const size_type n{size()};
+        VectorArray out{uninitialized(n)};
+        vec::detail::soa_cross(streams(), o.streams(), out.streams(), n);
+        return out;
+    }
+
+    // Norms (lengths) of every element
+    [[nodiscard]] vec::aligned_vector<norm_type> norm() const
+    {
+        vec::aligned_vector<norm_type> out(size());
+        vec::detail::soa_norm_squared(streams(), out.data(), size(), true);
+        return out;
+    }
+
+    [[nodiscard]] vec::aligned_vector<norm_type> length() const
+    {
+        return norm();
+    }
+
+    [[nodiscard]] vec::aligned_vector<norm_type> norm_squared() const
+    {
+        vec::aligned_vector<norm_type> out(size());
+        vec::detail::soa_norm_squared(streams(), out.data(), size(), false);
+        return out;
+    }
+
+    // Normalized elements
+    [[nodiscard]] VectorArray normalize() const
+    {
+        const size_type n{size()};
+        VectorArray out{uninitialized(n)};
+        vec::detail::soa_normalize(streams(), out.streams(), n);
+        return out;
+    }
+
+    // Sign of components
+    [[nodiscard]] VectorArray sign() const
+    {
+        return map([](T a) { return a >= 0 ? static_cast<T>(1) : static_cast<T>(-1); });
+    }
+
+    // Power (component-wise); integers by repeated squaring, see vec::detail::integer_pow
+    [[nodiscard]] VectorArray pow(T exp) const
+    {
+        return map([exp](T a) { return vec::detail::power(a, exp); });
+    }
+
+    // Power with an exponent known at compile time: multiplies instead of std::pow
+    template <int E>
+    [[nodiscard]] VectorArray pow() const
+    {
+        return map([](T a) { return vec::detail::static_pow<E>(a); });
+    }
+
+private:
+    template <typename F>
+    static void for_each_component(F &&f)
+    {
+        for_each_component(f, std::make_index_sequence<N>{});
+    }
+
+    template <typename F, size_type... I>
+    static void for_each_component(F &f, std::index_sequence<I...>)
+    {
+        (f(std::integral_constant<size_type, I>{}), ...);
+    }
+
+    value_type get(size_type i) const noexcept
+    {
+        return get(i, std::make_index_sequence<N>{});
+    }
+
+    template <size_type... I>
+    value_type get(size_type i, std::index_sequence<I...>) const noexcept
+    {
+        return value_type(streams_[I][i]...);
+    }
+
+    void set(size_type i, const value_type &v) noexcept
+    {
+        for_each_component([&](auto c)
+                           { streams_[c][i] = vec::detail::component<c>(v); });
+    }
+
+    template <typename F>
+    VectorArray map(F f) const
+    {
+        const size_type n{size()};
+        VectorArray out{uninitialized(n)};
+        for (size_type c = 0; c < N; ++c)
+        {
+            const T *a{data(c)};
+            T *r{out.data(c)};
+            for (size_type i = 0; i < n; ++i)
+                r[i] = f(a[i]);
+        }
+        return out;
+    }
+
+    // Component streams, for the kernels of soa_kernels.hpp
+    vec::detail::const_streams<T, N> streams() const noexcept
+    {
+        vec::detail::const_streams<T, N> s;
+        for (size_type c = 0; c < N; ++c)
+            s[c] = data(c);
+        return s;
+    }
+
+    vec::detail::streams<T, N> streams() noexcept
+    {
+        vec::detail::streams<T, N> s;
+        for (size_type c = 0; c < N; ++c)
+            s[c] = data(c);
+        return s;
+    }
+
+    template <typename Op>
+    VectorArray zip(const VectorArray &o, Op op) const
+    {
+        assert(size() == o.size());
+        const size_type n{size()};
+        VectorArray out{uninitialized(n)};
+        for (size_type c = 0; c < N; ++c)
+            vec::detail::soa_zip(data(c), o.data(c), out.data(c), n, op);
+        return out;
+    }
+
+    template <typename Op>
+    VectorArray zip(const value_type &v, Op op) const
+    {
+        const size_type n{size()};
+        VectorArray out{uninitialized(n)};
+        for_each_component([&](auto c)
+                           { vec::detail::soa_zip_scalar(data(c), vec::detail::component<c>(v), out.data(c), n, op); });
+        return out;
+    }
+
+    template <typename Op>
+    VectorArray zip(T s, Op op) const
+    {
+        const size_type n{size()};
+        VectorArray out{uninitialized(n)};
+        for (size_type c = 0; c < N; ++c)
+            vec::detail::soa_zip_scalar(data(c), s, out.data(c), n, op);
+        return out;
+    }
+
+    template <typename Op>
+    VectorArray &zip_assign(const VectorArray &o, Op op) noexcept
+    {
+        assert(size() == o.size());
+        for (size_type c = 0; c < N; ++c)
+            vec::detail::soa_zip(data(c), o.data(c), data(c), size(), op);
+        return *this;
+    }
+
+    template <typename Op>
+    VectorArray &zip_assign(T s, Op op) noexcept
+    {
+        for (size_type c = 0; c < N; ++c)
+            vec::detail::soa_zip_scalar(data(c), s, data(c), size(), op);
+        return *this;
+    }
+
+    std::array<stream_type, N> streams_{};
+};
+
+// Scalar * array
+template <typename T, std::size_t N>
+VectorArray<T, N> operator*(T s, const VectorArray<T, N> &a)
+{
+    return a * s;
+}
+
+// Type aliases
+template <typename T>
+using Vector2Array = VectorArray<T, 2>;
+template <typename T>
+using Vector3Array = VectorArray<T, 3>;
+template <typename T>
+using Vector4Array = VectorArray<T, 4>;
+
+using Vector2iArray = Vector2Array<int>;
+using Vector2fArray = Vector2Array<float>;
+using Vector2dArray = Vector2Array<double>;
+using Vector3iArray = Vector3Array<int>;
+using Vector3fArray = Vector3Array<float>;
+using Vector3dArray = Vector3Array<double>;
+using Vector4iArray = Vector4Array<int>;
+using Vector4fArray = Vector4Array<float>;
+using Vector4dArray = Vector4Array<double>;
@@ -0,0 +1,259 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdlib>
+#include <optional>
+#include <string_view>
+
+#include "vector_kernels.hpp"
+
+/*
+ * Runtime selection of the batch kernels by CPU
+ *
+ * The kernels of vector_kernels.hpp are only as fast as the flags they are
+ * compiled with. The functions in vec::dispatched are the same kernels
+ * compiled once per instruction-set level, with everything they call
+ * inlined into each copy. The first call of each kernel picks the copy for
+ * the highest level the CPU supports (CPUID, through the compiler's
+ * __builtin_cpu_supports) and later calls go straight to it.
+ *
+ *     baseline  the flags the translation unit is built with (e.g. SSE2)
+ *     sse4.2    SSE4.2 and POPCNT
+ *     avx2      AVX2 and FMA
+ *     avx512    AVX-512 F, VL, BW and DQ
+ *
+ * Set VECTORS_SIMD_LEVEL to one of these names to force a level for the
+ * process, e.g. to compare paths; levels the CPU lacks fall back to the
+ * highest one it has. Levels at or below the build flags run the baseline
+ * code. Dispatch needs GCC or Clang on x86; elsewhere, and with
+ * VECTORS_NO_SIMD, every level is the baseline.
+ *
+ * The copies differ in vector width and may contract multiplies and adds
+ * into FMAs, so results can differ between levels within a rounding.
+ */
+#if !defined(VECTORS_NO_SIMD) && (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define VECTORS_DISPATCH 1
+#define VECTORS_TARGET(isa) __attribute__((target(isa), flatten))
+#define VECTORS_TARGET_AVX512 VECTORS_TARGET("avx512f,avx512vl,avx512bw,avx512dq,avx2,fma")
+#endif
+
+namespace vec
+{
+    enum class simd_level
+    {
+        baseline,
+        sse4_2,
+        avx2,
+        avx512
+    };
+
+    [[nodiscard]] constexpr const char *simd_level_name(simd_level level) noexcept
+    {
+        switch (level)
+        {
+        case simd_level::sse4_2:
+            return "sse4.2";
+        case simd_level::avx2:
+            return "avx2";
+        case simd_level::avx512:
+            return "avx512";
+        default:
+            return "baseline";
+        }
+    }
+
+    // Level named as in simd_level_name(), or nullopt
+    [[nodiscard]] constexpr std::optional<simd_level> parse_simd_level(std::string_view name) noexcept
+    {
+        for (const simd_level level : {simd_level::baseline, simd_level::sse4_2, simd_level::avx2, simd_level::avx512})
+            if (name == simd_level_name(level))
+                return level;
+        return std::nullopt;
+    }
+
+    // Highest level the CPU (and the operating system's register saving) supports
+    [[nodiscard]] inline simd_level detect_simd_level() noexcept
+    {
+#if defined(VECTORS_DISPATCH)
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512vl") &&
+            __builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("avx512dq"))
+            return simd_level::avx512;
+        if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+            return simd_level::avx2;
+        if (__builtin_cpu_supports("sse4.2") && __builtin_cpu_supports("popcnt"))
+            return simd_level::sse4_2;
+#endif
+        return simd_level::baseline;
+    }
+
+    // The forced level if it names one the CPU supports, the detected level otherwise
+    [[nodiscard]] constexpr simd_level select_simd_level(const char *forced, simd_level detected) noexcept
+    {
+        const std::optional<simd_level> level{forced ? parse_simd_level(forced) : std::nullopt};
+        return level && *level < detected ? *level : detected;
+    }
+
+    // Level the dispatched kernels run at: VECTORS_SIMD_LEVEL or the CPU's, read once
+    [[nodiscard]] inline simd_level active_simd_level() noexcept
+    {
+        static const simd_level level{select_simd_level(std::getenv("VECTORS_SIMD_LEVEL"), detect_simd_level())};
+        return level;
+    }
+
+    namespace detail
+    {
+        // One copy of kernel K per level, K::run and all its callees inlined
+        template <typename K, typename... A>
+        void run_baseline(A... a) noexcept
+        {
+            K::run(a...);
+        }
+
+#if defined(VECTORS_DISPATCH)
+        template <typename K, typename... A>
+        VECTORS_TARGET("sse4.2,popcnt") void run_sse4_2(A... a) noexcept
+        {
+            K::run(a...);
+        }
+
+        template <typename K, typename... A>
+        VECTORS_TARGET("avx2,fma") void run_avx2(A... a) noexcept
+        {
+            K::run(a...);
+        }
+
+        template <typename K, typename... A>
+        VECTORS_TARGET_AVX512 void run_avx512(A... a) noexcept
+        {
+            K::run(a...);
+        }
+#endif
+
+        template <typename... A>
+        using kernel_fn = void (*)(A...) noexcept;
+
+        // Copy of kernel K for a level; the caller checks that the CPU supports it
+        template <typename K, typename... A>
+        kernel_fn<A...> kernel_for(simd_level level) noexcept
+        {
+#if defined(VECTORS_DISPATCH)
+            switch (level)
+            {
+            case simd_level::sse4_2:
+                return run_sse4_2<K, A...>;
+            case simd_level::avx2:
+                return run_avx2<K, A...>;
+            case simd_level::avx512:
+                return run_avx512<K, A...>;
+            default:
+                break;
+            }
+#endif
+            static_cast<void>(level);
+            return run_baseline<K, A...>;
+        }
+
+        // Run kernel K through the copy chosen on its first call
+        template <typename K, typename... A>
+        void dispatch(A... a) noexcept
+        {
+            static const kernel_fn<A...> f{kernel_for<K, A...>(active_simd_level())};
+            f(a...);
+        }
+
+        struct normalize_kernel
+        {
+            template <typename V>
+            static void run(const V *in, V *out, std::size_t n) noexcept { vec::normalize(in, out, n); }
+        };
+
+        struct normalize_fast_kernel
+        {
+            template <typename V>
+            static void run(const V *in, V *out, std::size_t n) noexcept { vec::normalize_fast(in, out, n); }
+        };
+
+        struct dot_many_kernel
+        {
+            template <typename V, typename R>
+            static void run(const V *a, const V *b, R *out, std::size_t n) noexcept { vec::dot_many(a, b, out, n); }
+        };
+
+        struct cross_many_kernel
+        {
+            template <typename T>
+            static void run(const Vector3<T> *a, const Vector3<T> *b, Vector3<T> *out, std::size_t n) noexcept
+            {
+                vec::cross_many(a, b, out, n);
+            }
+        };
+
+        struct axpy_kernel
+        {
+            template <typename T, typename V>
+            static void run(T alpha, const V *x, V *y, std::size_t n) noexcept { vec::axpy(alpha, x, y, n); }
+        };
+
+        struct norm_squared_many_kernel
+        {
+            template <typename V, typename R>
+            static void run(const V *in, R *out, std::size_t n) noexcept { vec::norm_squared_many(in, out, n); }
+        };
+
+        struct length_many_kernel
+        {
+            template <typename V, typename R>
+            static void run(const V *in, R *out, std::size_t n) noexcept { vec::length_many(in, out, n); }
+        };
+    } // namespace detail
+
+    /*
+     * The kernels of vector_kernels.hpp, same signatures and results, run at
+     * active_simd_level()
+     */
+    namespace dispatched
+    {
+        template <typename V>
+        void normalize(const V *in, V *out, std::size_t n) noexcept
+        {
+            detail::dispatch<detail::normalize_kernel>(in, out, n);
+        }
+
+        template <typename V>
+        void normalize_fast(const V *in, V *out, std::size_t n) noexcept
+        {
+            detail::dispatch<detail::normalize_fast_kernel>(in, out, n);
+        }
+
+        template <typename V, typename R>
+        void dot_many(const V *a, const V *b, R *out, std::size_t n) noexcept
+        {
+            detail::dispatch<detail::dot_many_kernel>(a, b, out, n);
+        }
+
+        template <typename T>
+        void cross_many(const Vector3<T> *a, const Vector3<T> *b, Vector3<T> *out, std::size_t n) noexcept
+        {
+            detail::dispatch<detail::cross_many_kernel>(a, b, out, n);
+        }
+
+        template <typename V>
+        void axpy(detail::scalar_t<V> alpha, const V *x, V *y, std::size_t n) noexcept
+        {
+            detail::dispatch<detail::axpy_kernel>(alpha, x, y, n);
+        }
+
+        template <typename V, typename R>
+        void norm_squared_many(const V *in, R *out, std::size_t n) noexcept
+        {
+            detail::dispatch<detail::norm_squared_many_kernel>(in, out, n);
+        }
+
+        template <typename V>
+        void length_many(const V *in, detail::norm_t<V> *out, std::size_t n) noexcept
+        {
+            detail::dispatch<detail::length_many_kernel>(in, out, n);
+        }
+    } // namespace dispatched
+} // namespace vec
@@ -0,0 +1,361 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "simd.hpp"
+#include "vector_array.hpp"
+#include "vector_n.hpp"
+
+/*
+ * Expression templates for vectors and arrays of vectors (opt-in)
+ *
+ * Wrapping an operand in vec::lazy() makes the arithmetic operators build an
+ * expression tree instead of computing intermediate results:
+ *
+ *     Vector3d r = vec::lazy(a) + vec::lazy(b) * s - c;
+ *     vec::assign(pos, vec::fma(vec::lazy(vel), dt, pos));   // VectorArray
+ *
+ * The tree is evaluated once per component when converted to a vector or an
+ * array, or written in place with vec::assign(), so an array expression is a
+ * single loop per component stream with no temporary arrays. Every node
+ * rounds to the scalar type exactly like the eager operator it replaces, so
+ * results are identical. vec::fma(a, b, c) is the exception: it computes
+ * a * b + c with a single rounding when the target has FMA instructions
+ * (VECTORS_HAS_FMA), and as a * b + c otherwise.
+ *
+ * Arrays are captured by reference, vectors and scalars by value: evaluate
+ * an expression in the statement that builds it.
+ */
+namespace vec
+{
+    namespace detail
+    {
+        // a * b + c, fused when the hardware supports it
+        struct fma_op
+        {
+            template <typename U>
+            U operator()(U a, U b, U c) const noexcept
+            {
+#if defined(VECTORS_HAS_FMA)
+                if constexpr (std::is_floating_point_v<U>)
+                    return std::fma(a, b, c);
+                else
+#endif
+                    return a * b + c;
+            }
+        };
+
+        // Component of a vector or scalar operand, the same for every element
+        template <typename T>
+        struct broadcast_lane
+        {
+            constexpr T operator[](std::size_t) const noexcept { return value; }
+
+            T value;
+        };
+
+        // Op applied to component i of each operand lane
+        template <typename T, typename Op, typename... L>
+        struct node_lane
+        {
+            constexpr T operator[](std::size_t i) const noexcept
+            {
+                return std::apply([i](const L &...l)
+                                  { return static_cast<T>(Op{}(l[i]...)); },
+                                  lanes);
+            }
+
+            std::tuple<L...> lanes;
+        };
+    } // namespace detail
+
+    namespace expr
+    {
+        // Base of every expression type
+        struct expression
+        {
+        };
+
+        template <typename E>
+        inline constexpr bool is_expression = std::is_base_of_v<expression, E>;
+
+        /*
+         * Every expression type exposes its scalar_type, its dimension (0 for
+         * scalars), whether it spans an array (is_array), size() (elements,
+         * meaningful for arrays only) and lane(c): an object whose
+         * operator[](i) is component c of element i.
+         */
+        template <typename T, std::size_t N>
+        struct vector_leaf : expression
+        {
+            using scalar_type = T;
+            static constexpr std::size_t dimension{N};
+            static constexpr bool is_array{false};
+
+            constexpr std::size_t size() const noexcept { return 1; }
+            constexpr detail::broadcast_lane<T> lane(std::size_t c) const noexcept { return {value[c]}; }
+
+            VectorN<T, N> value;
+        };
+
+        template <typename T, std::size_t N>
+        struct array_leaf : expression
+        {
+            using scalar_type = T;
+            static constexpr std::size_t dimension{N};
+            static constexpr bool is_array{true};
+
+            std::size_t size() const noexcept { return array->size(); }
+            const T *lane(std::size_t c) const noexcept { return array->data(c); }
+
+            const VectorArray<T, N> *array;
+        };
+
+        template <typename T>
+        struct scalar_leaf : expression
+        {
+            using scalar_type = T;
+            static constexpr std::size_t dimension{0};
+            static constexpr bool is_array{false};
+
+            constexpr std::size_t size() const noexcept { return 1; }
+            constexpr detail::broadcast_lane<T> lane(std::size_t) const noexcept { return {value}; }
+
+            T value;
+        };
+
+        // Op applied component-wise to the operands
+        template <typename Op, typename... E>
+        struct node : expression
+        {
+            using scalar_type = typename std::tuple_element_t<0, std::tuple<E...>>::scalar_type;
+            static constexpr std::size_t dimension{std::max({E::dimension...})};
+            static constexpr bool is_array{(E::is_array || ...)};
+
+            static_assert((std::is_same_v<typename E::scalar_type, scalar_type> && ...),
+                          "operands must have the same scalar type");
+            static_assert(((E::dimension == 0 || E::dimension == dimension) && ...),
+                          "operands must have the same number of components");
+
+            // VectorArray for array expressions, VectorN otherwise
+            using result_type = std::conditional_t<is_array, VectorArray<scalar_type, dimension>,
+                                                   VectorN<scalar_type, dimension>>;
+
+            std::size_t size() const noexcept
+            {
+                std::size_t n{1};
+                std::apply([&n](const E &...e)
+                           { ((n = e.is_array ? e.size() : n), ...); },
+                           operands);
+                assert(std::apply([n](const E &...e)
+                                  { return ((!e.is_array || e.size() == n) && ...); },
+                                  operands));
+                return n;
+            }
+
+            constexpr auto lane(std::size_t c) const noexcept
+            {
+                return std::apply([c](const E &...e)
+                                  { return detail::node_lane<scalar_type, Op, decltype(e.lane(c))...>{{e.lane(c)...}}; },
+                                  operands);
+            }
+
+            constexpr operator result_type() const;
+
+            std::tuple<E...> operands;
+        };
+
+        // Scalar type of an operand, void for plain numbers
+        template <typename A, typename = void>
+        struct operand_scalar
+        {
+            using type = void;
+        };
+
+        template <typename T, std::size_t N>
+        struct operand_scalar<VectorN<T, N>>
+        {
+            using type = T;
+        };
+
+        template <typename T, std::size_t N>
+        struct operand_scalar<VectorArray<T, N>>
+        {
+            using type = T;
+        };
+
+        template <typename E>
+        struct operand_scalar<E, std::enable_if_t<is_expression<E>>>
+        {
+            using type = typename E::scalar_type;
+        };
+
+        template <typename A>
+        using operand_scalar_t = typename operand_scalar<A>::type;
+
+        // Scalar type of the first operand that is not a plain number
+        template <typename... A>
+        struct common_scalar
+        {
+            using type = void;
+        };
+
+        template <typename A, typename... Rest>
+        struct common_scalar<A, Rest...>
+        {
+            using type = std::conditional_t<std::is_void_v<operand_scalar_t<A>>,
+                                            typename common_scalar<Rest...>::type, operand_scalar_t<A>>;
+        };
+
+        template <typename A>
+        inline constexpr bool is_operand = std::is_arithmetic_v<A> || !std::is_void_v<operand_scalar_t<A>>;
+
+        // Operands of an expression operator: at least one must already be an expression
+        template <typename... A>
+        inline constexpr bool is_lazy_call = (is_operand<A> && ...) && (is_expression<A> || ...);
+
+        // Operands of vec::fma: at least one must be a vector, an array or an expression
+        template <typename... A>
+        inline constexpr bool is_fma_call = (is_operand<A> && ...) && (!std::is_arithmetic_v<A> || ...);
+
+        // Wrap any operand as an expression of scalar type T
+        template <typename T, typename U, std::size_t N>
+        constexpr vector_leaf<U, N> operand(const VectorN<U, N> &v) noexcept
+        {
+            return {{}, v};
+        }
+
+        template <typename T, typename U, std::size_t N>
+        array_leaf<U, N> operand(const VectorArray<U, N> &a) noexcept
+        {
+            return {{}, &a};
+        }
+
+        template <typename T, typename S, std::enable_if_t<std::is_arithmetic_v<S>, int> = 0>
+        constexpr scalar_leaf<T> operand(S s) noexcept
+        {
+            return {{}, static_cast<T>(s)};
+        }
+
+        template <typename T, typename E, std::enable_if_t<is_expression<E>, int> = 0>
+        constexpr const E &operand(const E &e) noexcept
+        {
+            return e;
+        }
+
+        template <typename Op, typename... A>
+        constexpr auto make_node(const A &...a) noexcept
+        {
+            using T = typename common_scalar<A...>::type;
+            return node<Op, std::decay_t<decltype(operand<T>(a))>...>{{}, {operand<T>(a)...}};
+        }
+
+        // Operators
+        template <typename L, typename R, std::enable_if_t<is_lazy_call<L, R>, int> = 0>
+        constexpr auto operator+(const L &l, const R &r) noexcept
+        {
+            return make_node<detail::plus_op>(l, r);
+        }
+
+        template <typename L, typename R, std::enable_if_t<is_lazy_call<L, R>, int> = 0>
+        constexpr auto operator-(const L &l, const R &r) noexcept
+        {
+            return make_node<detail::minus_op>(l, r);
+        }
+
+        template <typename L, typename R, std::enable_if_t<is_lazy_call<L, R>, int> = 0>
+        constexpr auto operator*(const L &l, const R &r) noexcept
+        {
+            return make_node<detail::multiplies_op>(l, r);
+        }
+
+        template <typename L, typename R, std::enable_if_t<is_lazy_call<L, R>, int> = 0>
+        constexpr auto operator/(const L &l, const R &r) noexcept
+        {
+            return make_node<detail::divides_op>(l, r);
+        }
+
+        template <typename E, std::enable_if_t<is_expression<E>, int> = 0>
+        constexpr auto operator-(const E &e) noexcept
+        {
+            return make_node<detail::negate_op>(e);
+        }
+
+        template <typename E, std::size_t... I>
+        constexpr VectorN<typename E::scalar_type, E::dimension> evaluate_vector(const E &e, std::index_sequence<I...>) noexcept
+        {
+            return VectorN<typename E::scalar_type, E::dimension>(e.lane(I)[0]...);
+        }
+    } // namespace expr
+
+    // Start an expression from a vector (captured by value) or an array (by reference)
+    template <typename T, std::size_t N>
+    constexpr expr::vector_leaf<T, N> lazy(const VectorN<T, N> &v) noexcept
+    {
+        return {{}, v};
+    }
+
+    template <typename T, std::size_t N>
+    expr::array_leaf<T, N> lazy(const VectorArray<T, N> &a) noexcept
+    {
+        return {{}, &a};
+    }
+
+    // a * b + c with a single rounding where supported; any operand may be a vector, array, scalar or expression
+    template <typename A, typename B, typename C, std::enable_if_t<expr::is_fma_call<A, B, C>, int> = 0>
+    auto fma(const A &a, const B &b, const C &c) noexcept
+    {
+        return expr::make_node<detail::fma_op>(a, b, c);
+    }
+
+    // Write an array expression into out, resized to the expression's size
+    template <typename T, std::size_t N, typename E, std::enable_if_t<expr::is_expression<E>, int> = 0>
+    void assign(VectorArray<T, N> &out, const E &e)
+    {
+        static_assert(std::is_same_v<typename E::scalar_type, T> && E::dimension == N,
+                      "expression does not match the array type");
+        const std::size_t n{e.size()};
+        if (out.size() != n)
+            out = VectorArray<T, N>::uninitialized(n);
+        for (std::size_t c = 0; c < N; ++c)
+        {
+            T *r{out.data(c)};
+            const auto l{e.lane(c)};
+            for (std::size_t i = 0; i < n; ++i)
+                r[i] = l[i];
+        }
+    }
+
+    template <typename T, std::size_t N, typename E, std::enable_if_t<expr::is_expression<E>, int> = 0>
+    constexpr void assign(VectorN<T, N> &out, const E &e) noexcept
+    {
+        static_assert(!E::is_array, "array expressions must be assigned to a VectorArray");
+        out = expr::evaluate_vector(e, std::make_index_sequence<E::dimension>{});
+    }
+
+    // Value of an expression: a VectorArray for array expressions, a VectorN otherwise
+    template <typename E, std::enable_if_t<expr::is_expression<E>, int> = 0>
+    constexpr typename E::result_type evaluate(const E &e)
+    {
+        if constexpr (E::is_array)
+        {
+            typename E::result_type out;
+            assign(out, e);
+            return out;
+        }
+        else
+            return expr::evaluate_vector(e, std::make_index_sequence<E::dimension>{});
+    }
+
+    template <typename Op, typename... E>
+    constexpr expr::node<Op, E...>::operator result_type() const
+    {
+        return evaluate(*this);
+    }
+} // namespace vec
@@ -0,0 +1,353 @@
+#pragma once
+
+#include <charconv>
+#include <cstddef>
+#include <istream>
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
+#include "vector2.hpp"
+#include "vector3.hpp"
+#include "vector4.hpp"
+#include "vector_n.hpp"
+
+/*
+ * Floating-point std::from_chars / std::to_chars
+ *
+ * Defined when the standard library implements them (libstdc++ 11, MSVC
+ * 2019 16.4). Otherwise floating-point components go through strtod and
+ * snprintf with the fewest digits that round-trip, which is slower and
+ * depends on the C locale. Integers always use <charconv>.
+ */
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+#define VECTORS_HAS_FLOAT_CHARCONV 1
+#else
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#endif
+
+/*
+ * Text parsing and formatting without iostreams
+ *
+ * vec::format() writes the components separated by a space (or another
+ * separator), each in the shortest form that reads back to the same value.
+ * vec::parse() reads components separated by blanks and/or a comma, e.g.
+ * "1 2 3", "1,2,3" or "1, 2, 3", as well as the "Vector3(x=1, y=2, z=3)"
+ * form written by operator<<. vec::parse_vectors() fills an array from a
+ * buffer holding one vector per line, and operator>> reads the same forms
+ * from a stream.
+ */
+namespace vec
+{
+    namespace detail
+    {
+        inline bool is_blank(char c) noexcept { return c == ' ' || c == '\t'; }
+
+        inline const char *skip_blanks(const char *p, const char *last) noexcept
+        {
+            while (p != last && is_blank(*p))
+                ++p;
+            return p;
+        }
+
+        // Characters of a decimal number, infinity or NaN
+        inline bool is_number_char(char c) noexcept
+        {
+            return (c >= '0' && c <= '9') || c == '.' || c == '+' || c == '-' || c == 'e' || c == 'E' ||
+                   std::string_view("infatyINFATY").find(c) != std::string_view::npos;
+        }
+
+        template <typename T>
+        std::from_chars_result parse_scalar(const char *first, const char *last, T &value) noexcept
+        {
+            // from_chars rejects an explicit plus sign, allow one
+            const char *p{first != last && *first == '+' ? first + 1 : first};
+            if (p != first && (p == last || *p == '+' || *p == '-'))
+                return {first, std::errc::invalid_argument};
+#if !defined(VECTORS_HAS_FLOAT_CHARCONV)
+            if constexpr (std::is_floating_point_v<T>)
+            {
+                char buffer[64];
+                std::size_t n{0};
+                while (p + n != last && n + 1 < sizeof(buffer) && is_number_char(p[n]))
+                {
+                    buffer[n] = p[n];
+                    ++n;
+                }
+                buffer[n] = '\0';
+                char *end;
+                errno = 0;
+                T r;
+                if constexpr (std::is_same_v<T, float>)
+                    r = std::strtof(buffer, &end);
+                else if constexpr (std::is_same_v<T, double>)
+                    r = std::strtod(buffer, &end);
+                else
+                    r = std::strtold(buffer, &end);
+                if (end == buffer)
+                    return {first, std::errc::invalid_argument};
+                // Subnormal results are in range, as for from_chars
+                if (errno == ERANGE && (r == 0 || std::isinf(r)))
+                    return {p + (end - buffer), std::errc::result_out_of_range};
+                value = r;
+                return {p + (end - buffer), std::errc{}};
+            }
+            else
+#endif
+            {
+                const std::from_chars_result r{std::from_chars(p, last, value)};
+                return r.ec == std::errc::invalid_argument ? std::from_chars_result{first, r.ec} : r;
+            }
+        }
+
+        template <typename T>
+        std::to_chars_result format_scalar(char *first, char *last, T value) noexcept
+        {
+#if !defined(VECTORS_HAS_FLOAT_CHARCONV)
+            if constexpr (std::is_floating_point_v<T>)
+            {
+                // Fewest significant digits that read back to value
+                char buffer[64];
+                int n{-1};
+                for (int digits = std::numeric_limits<T>::digits10; digits <= std::numeric_limits<T>::max_digits10; ++digits)
+                {
+                    n = std::snprintf(buffer, sizeof(buffer), "%.*Lg", digits, static_cast<long double>(value));
+                    T back{};
+                    if (n < 0 || (parse_scalar(buffer, buffer + n, back).ec == std::errc{} && back == value))
+                        break;
+                }
+                if (n < 0 || n > last - first)
+                    return {last, std::errc::value_too_large};
+                std::memcpy(first, buffer, static_cast<std::size_t>(n));
+                return {first + n, std::errc{}};
+            }
+            else
+#endif
+                return std::to_chars(first, last, value);
+        }
+
+        // Longest text of one component written by format_scalar
+        template <typename T>
+        inline constexpr std::size_t max_scalar_chars =
+            std::is_floating_point_v<T> ? std::numeric_limits<T>::max_digits10 + 12 : std::numeric_limits<T>::digits10 + 3;
+    } // namespace detail
+
+    // Longest text vec::format() writes for a VectorN<T, N>, separators included
+    template <typename T, std::size_t N>
+    inline constexpr std::size_t max_format_chars = N * (detail::max_scalar_chars<T> + 1);
+
+    /**
+     * @brief Writes the components of v to [first, last), separated by `separator`
+     *
+     * Same contract as std::to_chars: on success ptr is one past the last
+     * character written (no terminator), otherwise ec is value_too_large.
+     * Floating-point components use the shortest round-trip representation.
+     */
+    template <typename T, std::size_t N>
+    std::to_chars_result format(char *first, char *last, const VectorN<T, N> &v, char separator = ' ') noexcept
+    {
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            if (i > 0)
+            {
+                if (first == last)
+                    return {last, std::errc::value_too_large};
+                *first++ = separator;
+            }
+            const std::to_chars_result r{detail::format_scalar(first, last, v[i])};
+            if (r.ec != std::errc{})
+                return r;
+            first = r.ptr;
+        }
+        return {first, std::errc{}};
+    }
+
+    template <typename T, std::size_t N>
+    std::string format(const VectorN<T, N> &v, char separator = ' ')
+    {
+        char buffer[max_format_chars<T, N>];
+        const std::to_chars_result r{format(buffer, buffer + sizeof(buffer), v, separator)};
+        return std::string(buffer, r.ptr);
+    }
+
+    /**
+     * @brief Reads a vector from the start of [first, last)
+     *
+     * Leading blanks are skipped; components are separated by blanks and/or
+     * one comma, optionally wrapped as "Vector3(x=1, y=2, z=3)". Same
+     * contract as std::from_chars: on success ptr is one past the vector,
+     * on failure ec is invalid_argument (ptr == first) or result_out_of_range
+     * and v is unchanged.
+     */
+    template <typename T, std::size_t N>
+    std::from_chars_result parse(const char *first, const char *last, VectorN<T, N> &v) noexcept
+    {
+        using detail::skip_blanks;
+        const std::from_chars_result invalid{first, std::errc::invalid_argument};
+        const char *p{skip_blanks(first, last)};
+
+        // "VectorN(" prefix of the operator<< form
+        constexpr std::string_view prefix{"Vector"};
+        const bool wrapped{static_cast<std::size_t>(last - p) > prefix.size() && std::string_view(p, prefix.size()) == prefix};
+        if (wrapped)
+        {
+            p += prefix.size();
+            while (p != last && *p >= '0' && *p <= '9')
+                ++p;
+            if (p == last || *p != '(')
+                return invalid;
+            p = skip_blanks(p + 1, last);
+        }
+
+        VectorN<T, N> r;
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            if (i > 0)
+            {
+                const char *q{skip_blanks(p, last)};
+                if (q != last && *q == ',')
+                    q = skip_blanks(q + 1, last);
+                if (q == p)
+                    return invalid;
+                p = q;
+            }
+            if (wrapped && N >= 2 && N <= 4 && last - p >= 2 && p[0] == "xyzw"[i] && p[1] == '=')
+                p += 2;
+            const std::from_chars_result c{detail::parse_scalar(p, last, r[i])};
+            if (c.ec == std::errc::invalid_argument)
+                return invalid;
+            if (c.ec != std::errc{})
+                return c;
+            p = c.ptr;
+        }
+
+        if (wrapped)
+        {
+            p = skip_blanks(p, last);
+            if (p == last || *p != ')')
+                return invalid;
+            ++p;
+        }
+        v = r;
+        return {p, std::errc{}};
+    }
+
+    // The whole of s as a vector (surrounding blanks allowed), or nullopt
+    template <typename V>
+    std::optional<V> parse_vector(std::string_view s) noexcept
+    {
+        V v;
+        const char *last{s.data() + s.size()};
+        const std::from_chars_result r{parse(s.data(), last, v)};
+        if (r.ec != std::errc{} || detail::skip_blanks(r.ptr, last) != last)
+            return std::nullopt;
+        return v;
+    }
+
+    template <typename T = float>
+    std::optional<Vector2<T>> parse_vector2(std::string_view s) noexcept
+    {
+        return parse_vector<Vector2<T>>(s);
+    }
+
+    template <typename T = float>
+    std::optional<Vector3<T>> parse_vector3(std::string_view s) noexcept
+    {
+        return parse_vector<Vector3<T>>(s);
+    }
+
+    template <typename T = float>
+    std::optional<Vector4<T>> parse_vector4(std::string_view s) noexcept
+    {
+        return parse_vector<Vector4<T>>(s);
+    }
+
+    /**
+     * @brief Appends the vectors of [first, last), one per line, to out
+     *
+     * Lines end with "\n" or "\r\n"; blank lines are skipped. On success ptr
+     * is last; otherwise ptr is the start of the first line that is not a
+     * single vector and out holds the vectors before it.
+     */
+    template <typename T, std::size_t N>
+    std::from_chars_result parse_vectors(const char *first, const char *last, std::vector<VectorN<T, N>> &out)
+    {
+        const char *p{first};
+        while (p != last)
+        {
+            const char *line{p};
+            p = detail::skip_blanks(p, last);
+            if (p != last && (*p == '\n' || *p == '\r'))
+            {
+                p += *p == '\r' && last - p > 1 && p[1] == '\n' ? 2 : 1;
+                continue;
+            }
+            if (p == last)
+                break;
+
+            VectorN<T, N> v;
+            const std::from_chars_result r{parse(p, last, v)};
+            if (r.ec != std::errc{})
+                return {line, r.ec};
+            p = detail::skip_blanks(r.ptr, last);
+            if (p != last && *p == '\r')
+                ++p;
+            if (p != last && *p++ != '\n')
+                return {line, std::errc::invalid_argument};
+            out.push_back(v);
+        }
+        return {last, std::errc{}};
+    }
+} // namespace vec
+
+/**
+ * @brief Reads a vector in any form vec::parse() accepts
+ *
+ * Leading whitespace (newlines included) is skipped; sets failbit if the
+ * input is not a vector.
+ */
+template <typename T, std::size_t N>
+std::istream &operator>>(std::istream &is, VectorN<T, N> &v)
+{
+    const std::istream::sentry sentry(is);
+    if (!sentry)
+        return is;
+
+    // Collect the characters of one vector, then parse them
+    std::string text;
+    if (is.peek() == 'V')
+    {
+        std::getline(is, text, ')');
+        text += ')';
+    }
+    else
+    {
+        for (std::size_t i = 0; i < N && is; ++i)
+        {
+            if (i > 0)
+            {
+                text += ' ';
+                is >> std::ws;
+                if (is.peek() == ',')
+                    is.get();
+                is >> std::ws;
+            }
+            for (int c = is.peek(); c != std::istream::traits_type::eof() && vec::detail::is_number_char(static_cast<char>(c));
+                 c = is.peek())
+                text += static_cast<char>(is.get());
+        }
+    }
+    if (const std::optional<VectorN<T, N>> r{vec::parse_vector<VectorN<T, N>>(text)})
+        v = *r;
+    else
+        is.setstate(std::ios::failbit);
+    return is;
+}
@@ -0,0 +1,420 @@
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "vector_traits.hpp"
+
+/*
+ * Binary vector array files
+ *
+ * A 32-byte header followed by the vectors exactly as they are laid out in
+ * memory:
+ *
+ *   offset  size  field
+ *        0     4  magic "VECA"
+ *        4     4  byte order mark 0x01020304, in the byte order of the data
+ *        8     2  format version (1)
+ *       10     1  scalar kind: 0 signed integer, 1 unsigned integer, 2 floating point
+ *       11     1  scalar size in bytes
+ *       12     4  components per vector
+ *       16     8  number of vectors
+ *       24     8  reserved (zero)
+ *
+ * Starting the data at byte 32 keeps a mapped file aligned for every vector
+ * type. Files are written in native byte order: vec::read_vectors() swaps
+ * files from a machine of the other byte order, MappedVectorFile (zero copy)
+ * rejects them. I/O and format errors throw vec::vector_file_error.
+ */
+namespace vec
+{
+    class vector_file_error : public std::runtime_error
+    {
+    public:
+        using std::runtime_error::runtime_error;
+    };
+
+    namespace detail
+    {
+        struct vector_file_header
+        {
+            char magic[4];
+            std::uint32_t byte_order;
+            std::uint16_t version;
+            std::uint8_t scalar_kind;
+            std::uint8_t scalar_size;
+            std::uint32_t dimension;
+            std::uint64_t count;
+            std::uint64_t reserved;
+        };
+
+        static_assert(sizeof(vector_file_header) == 32, "vector file header must be 32 bytes");
+
+        inline constexpr char vector_file_magic[4]{'V', 'E', 'C', 'A'};
+        inline constexpr std::uint32_t vector_file_byte_order{0x01020304};
+        inline constexpr std::uint16_t vector_file_version{1};
+
+        // Vectors stored in files: tightly packed components, copied as bytes
+        template <typename V>
+        constexpr void check_file_vector() noexcept
+        {
+            static_assert(std::is_trivially_copyable_v<V>, "vector files hold trivially copyable vectors");
+            static_assert(sizeof(V) == vector_traits<V>::size * sizeof(scalar_t<V>), "vectors must be tightly packed");
+        }
+
+        template <typename V>
+        constexpr vector_file_header make_file_header(std::uint64_t count) noexcept
+        {
+            using T = scalar_t<V>;
+            constexpr std::uint8_t kind{std::is_floating_point_v<T> ? 2 : std::is_signed_v<T> ? 0 : 1};
+            return {{'V', 'E', 'C', 'A'},
+                    vector_file_byte_order,
+                    vector_file_version,
+                    kind,
+                    static_cast<std::uint8_t>(sizeof(T)),
+                    static_cast<std::uint32_t>(vector_traits<V>::size),
+                    count,
+                    0};
+        }
+
+        template <typename T>
+        T byteswap(T v) noexcept
+        {
+            unsigned char bytes[sizeof(T)];
+            std::memcpy(bytes, &v, sizeof(T));
+            std::reverse(bytes, bytes + sizeof(T));
+            std::memcpy(&v, bytes, sizeof(T));
+            return v;
+        }
+
+        // e.g. "float32[3]"
+        inline std::string describe(const vector_file_header &h)
+        {
+            static constexpr const char *kinds[]{"int", "uint", "float"};
+            const std::string kind{h.scalar_kind < 3 ? kinds[h.scalar_kind] : "unknown"};
+            return kind + std::to_string(8 * h.scalar_size) + "[" + std::to_string(h.dimension) + "]";
+        }
+
+        /**
+         * @brief Validates the header of a file holding `bytes` bytes in total
+         *
+         * Converts the header to native byte order and returns whether the
+         * data needs swapping too.
+         */
+        template <typename V>
+        bool check_file_header(vector_file_header &h, std::uint64_t bytes, const std::string &path)
+        {
+            if (bytes < sizeof(vector_file_header) || std::memcmp(h.magic, vector_file_magic, 4) != 0)
+                throw vector_file_error(path + ": not a vector file");
+
+            const bool swapped{h.byte_order != vector_file_byte_order};
+            if (swapped)
+            {
+                if (byteswap(h.byte_order) != vector_file_byte_order)
+                    throw vector_file_error(path + ": invalid byte order mark");
+                h.version = byteswap(h.version);
+                h.dimension = byteswap(h.dimension);
+                h.count = byteswap(h.count);
+            }
+            if (h.version != vector_file_version)
+                throw vector_file_error(path + ": unsupported format version " + std::to_string(h.version));
+
+            const vector_file_header expected{make_file_header<V>(0)};
+            if (h.scalar_kind != expected.scalar_kind || h.scalar_size != expected.scalar_size ||
+                h.dimension != expected.dimension)
+                throw vector_file_error(path + ": holds " + describe(h) + " vectors, expected " + describe(expected));
+            if (h.count > (bytes - sizeof(vector_file_header)) / sizeof(V))
+                throw vector_file_error(path + ": truncated, " + std::to_string(h.count) + " vectors expected");
+            return swapped;
+        }
+
+        inline vector_file_error system_error(const std::string &path, const char *what)
+        {
+#if defined(_WIN32)
+            const int code{static_cast<int>(GetLastError())};
+            return vector_file_error(path + ": " + what + ": " + std::system_category().message(code));
+#else
+            return vector_file_error(path + ": " + what + ": " + std::generic_category().message(errno));
+#endif
+        }
+
+        // Read-only mapping of a whole file
+        class file_mapping
+        {
+        public:
+            explicit file_mapping(const std::string &path)
+            {
+#if defined(_WIN32)
+                const HANDLE file{CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                              FILE_ATTRIBUTE_NORMAL, nullptr)};
+                if (file == INVALID_HANDLE_VALUE)
+                    throw system_error(path, "cannot open");
+                LARGE_INTEGER size;
+                if (!GetFileSizeEx(file, &size))
+                {
+                    const vector_file_error e{system_error(path, "cannot read size")};
+                    CloseHandle(file);
+                    throw e;
+                }
+                size_ = static_cast<std::uint64_t>(size.QuadPart);
+                if (size_ > 0)
+                {
+                    const HANDLE mapping{CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr)};
+                    if (mapping != nullptr)
+                    {
+                        data_ = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+                        CloseHandle(mapping);
+                    }
+                    if (data_ == nullptr)
+                    {
+                        const vector_file_error e{system_error(path, "cannot map")};
+                        CloseHandle(file);
+                        throw e;
+                    }
+                }
+                CloseHandle(file);
+#else
+                const int fd{::open(path.c_str(), O_RDONLY | O_CLOEXEC)};
+                if (fd < 0)
+                    throw system_error(path, "cannot open");
+                struct stat st
+                {
+                };
+                if (::fstat(fd, &st) != 0)
+                {
+                    const vector_file_error e{system_error(path, "cannot read size")};
+                    ::close(fd);
+                    throw e;
+                }
+                size_ = static_cast<std::uint64_t>(st.st_size);
+                if (size_ > 0)
+                {
+                    void *p{::mmap(nullptr, static_cast<std::size_t>(size_), PROT_READ, MAP_PRIVATE, fd, 0)};
+                    if (p == MAP_FAILED)
+                    {
+                        const vector_file_error e{system_error(path, "cannot map")};
+                        ::close(fd);
+                        throw e;
+                    }
+                    data_ = p;
+                }
+                ::close(fd);
+#endif
+            }
+
+            file_mapping(file_mapping &&o) noexcept
+                : data_(std::exchange(o.data_, nullptr)), size_(std::exchange(o.size_, 0))
+            {
+            }
+            file_mapping &operator=(file_mapping &&o) noexcept
+            {
+                std::swap(data_, o.data_);
+                std::swap(size_, o.size_);
+                return *this;
+            }
+            ~file_mapping()
+            {
+                if (data_ == nullptr)
+                    return;
+#if defined(_WIN32)
+                UnmapViewOfFile(data_);
+#else
+                ::munmap(data_, static_cast<std::size_t>(size_));
+#endif
+            }
+
+            [[nodiscard]] const unsigned char *data() const noexcept { return static_cast<const unsigned char *>(data_); }
+            [[nodiscard]] std::uint64_t size() const noexcept { return size_; }
+
+        private:
+            void *data_{nullptr};
+            std::uint64_t size_{0};
+        };
+    } // namespace detail
+
+    /**
+     * @brief Streams vectors to a binary vector file
+     *
+     * write() appends chunks as they are produced, straight from the
+     * caller's memory; the count in the header is filled in by close() (or
+     * the destructor, which ignores errors: call close() to see them).
+     */
+    template <typename V>
+    class VectorFileWriter
+    {
+    public:
+        explicit VectorFileWriter(const std::string &path) : path_(path), out_(path, std::ios::binary | std::ios::trunc)
+        {
+            detail::check_file_vector<V>();
+            if (!out_)
+                throw vector_file_error(path_ + ": cannot open for writing");
+            write_header();
+        }
+
+        VectorFileWriter(const VectorFileWriter &) = delete;
+        VectorFileWriter &operator=(const VectorFileWriter &) = delete;
+
+        ~VectorFileWriter()
+        {
+            try
+            {
+                close();
+            }
+            catch (const vector_file_error &)
+            {
+            }
+        }
+
+        void write(const V *v, std::size_t n)
+        {
+            out_.write(reinterpret_cast<const char *>(v), static_cast<std::streamsize>(n * sizeof(V)));
+            if (!out_)
+                throw vector_file_error(path_ + ": write failed");
+            count_ += n;
+        }
+
+        // Vectors written so far
+        [[nodiscard]] std::uint64_t size() const noexcept { return count_; }
+
+        void close()
+        {
+            if (!out_.is_open())
+                return;
+            out_.seekp(0);
+            write_header();
+            out_.close();
+            if (!out_)
+                throw vector_file_error(path_ + ": write failed");
+        }
+
+    private:
+        void write_header()
+        {
+            const detail::vector_file_header h{detail::make_file_header<V>(count_)};
+            out_.write(reinterpret_cast<const char *>(&h), sizeof(h));
+            if (!out_)
+                throw vector_file_error(path_ + ": write failed");
+        }
+
+        std::string path_;
+        std::ofstream out_;
+        std::uint64_t count_{0};
+    };
+
+    // Writes n vectors to a new binary vector file
+    template <typename V>
+    void write_vectors(const std::string &path, const V *v, std::size_t n)
+    {
+        VectorFileWriter<V> writer(path);
+        writer.write(v, n);
+        writer.close();
+    }
+
+    // All vectors of a binary vector file, converted to native byte order if needed
+    template <typename V>
+    std::vector<V> read_vectors(const std::string &path)
+    {
+        detail::check_file_vector<V>();
+        std::ifstream in(path, std::ios::binary | std::ios::ate);
+        if (!in)
+            throw vector_file_error(path + ": cannot open");
+        const auto bytes{static_cast<std::uint64_t>(in.tellg())};
+        in.seekg(0);
+
+        detail::vector_file_header h{};
+        in.read(reinterpret_cast<char *>(&h), sizeof(h));
+        const bool swapped{detail::check_file_header<V>(h, bytes, path)};
+
+        std::vector<V> r(static_cast<std::size_t>(h.count));
+        in.read(reinterpret_cast<char *>(r.data()), static_cast<std::streamsize>(r.size() * sizeof(V)));
+        if (!in)
+            throw vector_file_error(path + ": read failed");
+        if (swapped)
+        {
+            auto *s{reinterpret_cast<detail::scalar_t<V> *>(r.data())};
+            for (std::size_t i = 0; i < r.size() * detail::vector_traits<V>::size; ++i)
+                s[i] = detail::byteswap(s[i]);
+        }
+        return r;
+    }
+
+    /**
+     * @brief Zero-copy, read-only view of a binary vector file
+     *
+     * The file is memory-mapped and its vectors are used in place through a
+     * span-like data()/size()/begin()/end() interface: pages are read on
+     * first access, so opening a file of hundreds of millions of vectors is
+     * immediate. Files in the other byte order are rejected (use
+     * vec::read_vectors() to convert them).
+     */
+    template <typename V>
+    class MappedVectorFile
+    {
+    public:
+        using value_type = V;
+        using const_iterator = const V *;
+
+        explicit MappedVectorFile(const std::string &path) : map_(path)
+        {
+            detail::check_file_vector<V>();
+            detail::vector_file_header h{};
+            if (map_.size() >= sizeof(h))
+                std::memcpy(&h, map_.data(), sizeof(h));
+            if (detail::check_file_header<V>(h, map_.size(), path))
+                throw vector_file_error(path + ": written in the other byte order, cannot be mapped");
+            data_ = reinterpret_cast<const V *>(map_.data() + sizeof(h));
+            size_ = static_cast<std::size_t>(h.count);
+        }
+
+        MappedVectorFile(MappedVectorFile &&o) noexcept
+            : map_(std::move(o.map_)), data_(std::exchange(o.data_, nullptr)), size_(std::exchange(o.size_, 0))
+        {
+        }
+        MappedVectorFile &operator=(MappedVectorFile &&o) noexcept
+        {
+            std::swap(map_, o.map_);
+            std::swap(data_, o.data_);
+            std::swap(size_, o.size_);
+            return *this;
+        }
+
+        [[nodiscard]] const V *data() const noexcept { return data_; }
+        [[nodiscard]] std::size_t size() const noexcept { return size_; }
+        [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+
+        [[nodiscard]] const V &operator[](std::size_t i) const noexcept { return data_[i]; }
+
+        [[nodiscard]] const_iterator begin() const noexcept { return data_; }
+        [[nodiscard]] const_iterator end() const noexcept { return data_ + size_; }
+
+    private:
+        detail::file_mapping map_;
+        const V *data_{nullptr};
+        std::size_t size_{0};
+    };
+} // namespace vec
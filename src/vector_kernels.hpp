@@ -0,0 +1,423 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "simd.hpp"
+#include "vector_traits.hpp"
+
+/*
+ * Batch kernels over arrays of Vector2/3/4
+ *
+ * Arrays keep the usual interleaved (x, y, z, ...) layout. They are processed
+ * in blocks of kernel_block elements: each block is transposed into one
+ * scratch array per component, computed with contiguous loops the compiler
+ * vectorizes, then written back. The last, partial block runs through the
+ * same loops with a shorter length.
+ *
+ * Results match the member functions of the vector classes, except that
+ * normalize() multiplies by the reciprocal norm instead of dividing by it
+ * (within one rounding of Vector::normalize()).
+ */
+namespace vec
+{
+    // Elements per block, sized so the scratch arrays stay in L1
+    inline constexpr std::size_t kernel_block{256};
+
+    namespace detail
+    {
+        template <typename V, typename U = std::remove_const_t<V>>
+        using kernel_scalars = std::conditional_t<std::is_const_v<V>, const scalar_t<U>, scalar_t<U>>;
+
+        // View an array of vectors as its interleaved components
+        template <typename V>
+        kernel_scalars<V> *scalars(V *v) noexcept
+        {
+            using U = std::remove_const_t<V>;
+            static_assert(sizeof(U) == vector_traits<U>::size * sizeof(scalar_t<U>), "vectors must be tightly packed");
+            return reinterpret_cast<kernel_scalars<V> *>(v);
+        }
+
+#if defined(VECTORS_SIMD_SSE2) && !defined(__AVX2__)
+        // Transposed explicitly: before AVX2 the compiler moves 32-bit
+        // integers through general registers, lacking a two-source shuffle
+        template <typename T, std::size_t N>
+        inline constexpr bool shuffle_transpose{std::is_integral_v<T> && sizeof(T) == 4 && N >= 2 && N <= 4};
+
+        inline __m128 load_ps(const void *p) noexcept
+        {
+            return _mm_castsi128_ps(_mm_loadu_si128(static_cast<const __m128i *>(p)));
+        }
+
+        inline void store_ps(void *p, __m128 a) noexcept
+        {
+            _mm_storeu_si128(static_cast<__m128i *>(p), _mm_castps_si128(a));
+        }
+
+        // Four interleaved elements of N 32-bit components at s, one register per component
+        template <std::size_t N>
+        void transpose_in(const std::uint32_t *s, __m128 (&r)[N]) noexcept
+        {
+            if constexpr (N == 2)
+            {
+                const __m128 a{load_ps(s)};
+                const __m128 b{load_ps(s + 4)};
+                r[0] = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+                r[1] = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+            }
+            else if constexpr (N == 3)
+            {
+                // a = x0 y0 z0 x1, b = y1 z1 x2 y2, c = z2 x3 y3 z3
+                const __m128 a{load_ps(s)};
+                const __m128 b{load_ps(s + 4)};
+                const __m128 c{load_ps(s + 8)};
+                r[0] = _mm_shuffle_ps(a, _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2)), _MM_SHUFFLE(2, 0, 3, 0));
+                r[1] = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)),
+                                      _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+                r[2] = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)), c, _MM_SHUFFLE(3, 0, 2, 0));
+            }
+            else
+            {
+                for (std::size_t c = 0; c < 4; ++c)
+                    r[c] = load_ps(s + 4 * c);
+                _MM_TRANSPOSE4_PS(r[0], r[1], r[2], r[3]);
+            }
+        }
+
+        // Inverse of transpose_in
+        template <std::size_t N>
+        void transpose_out(__m128 (&r)[N], std::uint32_t *s) noexcept
+        {
+            if constexpr (N == 2)
+            {
+                store_ps(s, _mm_unpacklo_ps(r[0], r[1]));
+                store_ps(s + 4, _mm_unpackhi_ps(r[0], r[1]));
+            }
+            else if constexpr (N == 3)
+            {
+                // lo = x0 y0 x1 y1, hi = x2 y2 x3 y3
+                const __m128 lo{_mm_unpacklo_ps(r[0], r[1])};
+                const __m128 hi{_mm_unpackhi_ps(r[0], r[1])};
+                const __m128 z0x1{_mm_shuffle_ps(r[2], lo, _MM_SHUFFLE(2, 2, 0, 0))};
+                const __m128 y1z1{_mm_shuffle_ps(lo, r[2], _MM_SHUFFLE(1, 1, 3, 3))};
+                const __m128 z2x3{_mm_shuffle_ps(r[2], hi, _MM_SHUFFLE(2, 2, 2, 2))};
+                const __m128 y3z3{_mm_shuffle_ps(hi, r[2], _MM_SHUFFLE(3, 3, 3, 3))};
+                store_ps(s, _mm_shuffle_ps(lo, z0x1, _MM_SHUFFLE(2, 0, 1, 0)));
+                store_ps(s + 4, _mm_shuffle_ps(y1z1, hi, _MM_SHUFFLE(1, 0, 2, 0)));
+                store_ps(s + 8, _mm_shuffle_ps(z2x3, y3z3, _MM_SHUFFLE(2, 0, 2, 0)));
+            }
+            else
+            {
+                _MM_TRANSPOSE4_PS(r[0], r[1], r[2], r[3]);
+                for (std::size_t c = 0; c < 4; ++c)
+                    store_ps(s + 4 * c, r[c]);
+            }
+        }
+#endif
+
+        // Transpose m interleaved elements into block[c][j]
+        template <std::size_t N, typename T>
+        void load_block(const T *s, std::size_t m, T (&block)[N][kernel_block]) noexcept
+        {
+#if defined(VECTORS_SIMD_SSE2) && !defined(__AVX2__)
+            if constexpr (shuffle_transpose<T, N>)
+            {
+                const std::size_t whole{m / 4 * 4};
+                for (std::size_t j = 0; j < whole; j += 4)
+                {
+                    __m128 r[N];
+                    transpose_in(reinterpret_cast<const std::uint32_t *>(s + j * N), r);
+                    for (std::size_t c = 0; c < N; ++c)
+                        store_ps(block[c] + j, r[c]);
+                }
+                for (std::size_t c = 0; c < N; ++c)
+                    for (std::size_t j = whole; j < m; ++j)
+                        block[c][j] = s[j * N + c];
+                return;
+            }
+#endif
+            for (std::size_t c = 0; c < N; ++c)
+                for (std::size_t j = 0; j < m; ++j)
+                    block[c][j] = s[j * N + c];
+        }
+
+        template <std::size_t N, typename T>
+        void store_block(T *s, std::size_t m, const T (&block)[N][kernel_block]) noexcept
+        {
+#if defined(VECTORS_SIMD_SSE2) && !defined(__AVX2__)
+            if constexpr (shuffle_transpose<T, N>)
+            {
+                const std::size_t whole{m / 4 * 4};
+                for (std::size_t j = 0; j < whole; j += 4)
+                {
+                    __m128 r[N];
+                    for (std::size_t c = 0; c < N; ++c)
+                        r[c] = load_ps(block[c] + j);
+                    transpose_out(r, reinterpret_cast<std::uint32_t *>(s + j * N));
+                }
+                for (std::size_t c = 0; c < N; ++c)
+                    for (std::size_t j = whole; j < m; ++j)
+                        s[j * N + c] = block[c][j];
+                return;
+            }
+#endif
+            for (std::size_t c = 0; c < N; ++c)
+                for (std::size_t j = 0; j < m; ++j)
+                    s[j * N + c] = block[c][j];
+        }
+
+        // Whether blocks of T reduce to R on the 32-bit integer lanes (64-bit products)
+        template <typename T, typename R>
+        inline constexpr bool wide_epi32_block{simd4<T>::enabled && std::is_same_v<T, std::int32_t> &&
+                                               std::is_integral_v<R> && sizeof(R) == 8};
+
+        /**
+         * @brief out[j] = sum over c of a[c][j] * b[c][j], in 64-bit integers
+         *
+         * Four vectors per step: even and odd lanes are multiplied into
+         * exact 64-bit products and accumulated in registers. Squares (a and
+         * b the same block) are unsigned products of absolute values, which
+         * need no sign fix-up. Sums wrap around past 64 bits.
+         */
+        template <bool Squares, std::size_t N, typename R>
+        void block_dot_wide(const std::int32_t (&a)[N][kernel_block], const std::int32_t (&b)[N][kernel_block],
+                            std::size_t m, R *out) noexcept
+        {
+            std::size_t whole{0};
+#if defined(VECTORS_SIMD_SSE2)
+            using S = simd4<std::int32_t>;
+            whole = m / 4 * 4;
+            for (std::size_t j = 0; j < whole; j += 4)
+            {
+                __m128i even{_mm_setzero_si128()};
+                __m128i odd{_mm_setzero_si128()};
+                for (std::size_t c = 0; c < N; ++c)
+                {
+                    if constexpr (Squares)
+                    {
+                        const __m128i x{S::abs(S::load(a[c] + j))};
+                        even = _mm_add_epi64(even, _mm_mul_epu32(x, x));
+                        const __m128i x_odd{_mm_srli_epi64(x, 32)};
+                        odd = _mm_add_epi64(odd, _mm_mul_epu32(x_odd, x_odd));
+                    }
+                    else
+                    {
+                        const __m128i x{S::load(a[c] + j)};
+                        const __m128i y{S::load(b[c] + j)};
+                        even = _mm_add_epi64(even, S::mul_wide(x, y));
+                        odd = _mm_add_epi64(odd, S::mul_wide(_mm_srli_epi64(x, 32), _mm_srli_epi64(y, 32)));
+                    }
+                }
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(out + j), _mm_unpacklo_epi64(even, odd));
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(out + j + 2), _mm_unpackhi_epi64(even, odd));
+            }
+#endif
+            for (std::size_t j = whole; j < m; ++j)
+            {
+                R r{0};
+                for (std::size_t c = 0; c < N; ++c)
+                    r += static_cast<R>(static_cast<std::int64_t>(a[c][j]) * b[c][j]);
+                out[j] = r;
+            }
+        }
+
+        // Squared norms of a block, summed in the same order as the members
+        template <typename R, std::size_t N, typename T>
+        void block_norm_squared(const T (&block)[N][kernel_block], std::size_t m, R *out) noexcept
+        {
+            if constexpr (wide_epi32_block<T, R>)
+            {
+                block_dot_wide<true>(block, block, m, out);
+                return;
+            }
+            for (std::size_t j = 0; j < m; ++j)
+                out[j] = static_cast<R>(block[0][j]) * block[0][j];
+            for (std::size_t c = 1; c < N; ++c)
+                for (std::size_t j = 0; j < m; ++j)
+                    out[j] += static_cast<R>(block[c][j]) * block[c][j];
+        }
+    } // namespace detail
+
+    /**
+     * @brief Normalize n vectors
+     *
+     * Zero vectors are copied unchanged. in and out may be the same array.
+     * Integer vectors take the exact path of VectorN::normalize().
+     */
+    template <typename V>
+    void normalize(const V *in, V *out, std::size_t n) noexcept
+    {
+        using T = detail::scalar_t<V>;
+        constexpr std::size_t N{detail::vector_traits<V>::size};
+        using R = std::conditional_t<detail::integer_normalize<T, N>, std::uint64_t, detail::norm_t<V>>;
+
+        const T *src{detail::scalars(in)};
+        T *dst{detail::scalars(out)};
+        T block[N][kernel_block];
+        R norms[kernel_block];
+        for (std::size_t i = 0; i < n; i += kernel_block)
+        {
+            const std::size_t m{std::min(kernel_block, n - i)};
+            detail::load_block(src + i * N, m, block);
+            detail::block_norm_squared(block, m, norms);
+            if constexpr (detail::integer_normalize<T, N>)
+            {
+                for (std::size_t j = 0; j < m; ++j)
+                    norms[j] = detail::integer_sqrt(norms[j]);
+                for (std::size_t c = 0; c < N; ++c)
+                    for (std::size_t j = 0; j < m; ++j)
+                        block[c][j] = detail::divide_by_norm(block[c][j], norms[j]);
+            }
+            else
+            {
+                detail::sqrt_block(norms, m);
+                if constexpr (std::is_floating_point_v<T>)
+                {
+                    T scale[kernel_block];
+                    for (std::size_t j = 0; j < m; ++j)
+                        scale[j] = norms[j] != 0 ? static_cast<T>(1 / norms[j]) : static_cast<T>(1);
+                    for (std::size_t c = 0; c < N; ++c)
+                        for (std::size_t j = 0; j < m; ++j)
+                            block[c][j] *= scale[j];
+                }
+                else
+                {
+                    T divisor[kernel_block];
+                    for (std::size_t j = 0; j < m; ++j)
+                        divisor[j] = norms[j] != 0 ? static_cast<T>(norms[j]) : static_cast<T>(1);
+                    for (std::size_t c = 0; c < N; ++c)
+                        for (std::size_t j = 0; j < m; ++j)
+                            block[c][j] /= divisor[j];
+                }
+            }
+            detail::store_block(dst + i * N, m, block);
+        }
+    }
+
+    /**
+     * @brief Approximately normalize n vectors
+     *
+     * Batched Vector::normalize_fast(): relative error below 1e-6 per
+     * component. Zero vectors are copied unchanged. in and out may alias.
+     */
+    template <typename V>
+    void normalize_fast(const V *in, V *out, std::size_t n) noexcept
+    {
+        using T = detail::scalar_t<V>;
+        static_assert(std::is_floating_point_v<T>, "normalize_fast requires floating-point vectors");
+        constexpr std::size_t N{detail::vector_traits<V>::size};
+
+        const T *src{detail::scalars(in)};
+        T *dst{detail::scalars(out)};
+        T block[N][kernel_block];
+        T scale[kernel_block];
+        for (std::size_t i = 0; i < n; i += kernel_block)
+        {
+            const std::size_t m{std::min(kernel_block, n - i)};
+            detail::load_block(src + i * N, m, block);
+            detail::block_norm_squared(block, m, scale);
+            detail::rsqrt_approx_block(scale, m);
+            for (std::size_t c = 0; c < N; ++c)
+                for (std::size_t j = 0; j < m; ++j)
+                    block[c][j] *= scale[j];
+            detail::store_block(dst + i * N, m, block);
+        }
+    }
+
+    // out[i] = a[i].dot(b[i]), computed in R (e.g. vec::wide_t for a[i].dot_wide(b[i]))
+    template <typename V, typename R>
+    void dot_many(const V *a, const V *b, R *out, std::size_t n) noexcept
+    {
+        using T = detail::scalar_t<V>;
+        constexpr std::size_t N{detail::vector_traits<V>::size};
+
+        const T *sa{detail::scalars(a)};
+        const T *sb{detail::scalars(b)};
+        T block_a[N][kernel_block];
+        T block_b[N][kernel_block];
+        for (std::size_t i = 0; i < n; i += kernel_block)
+        {
+            const std::size_t m{std::min(kernel_block, n - i)};
+            detail::load_block(sa + i * N, m, block_a);
+            detail::load_block(sb + i * N, m, block_b);
+            R *r{out + i};
+            if constexpr (detail::wide_epi32_block<T, R>)
+            {
+                detail::block_dot_wide<false>(block_a, block_b, m, r);
+                continue;
+            }
+            for (std::size_t j = 0; j < m; ++j)
+                r[j] = static_cast<R>(block_a[0][j]) * block_b[0][j];
+            for (std::size_t c = 1; c < N; ++c)
+                for (std::size_t j = 0; j < m; ++j)
+                    r[j] += static_cast<R>(block_a[c][j]) * block_b[c][j];
+        }
+    }
+
+    // out[i] = a[i].cross(b[i]); out may alias a or b
+    template <typename T>
+    void cross_many(const Vector3<T> *a, const Vector3<T> *b, Vector3<T> *out, std::size_t n) noexcept
+    {
+        const T *sa{detail::scalars(a)};
+        const T *sb{detail::scalars(b)};
+        T *dst{detail::scalars(out)};
+        T block_a[3][kernel_block];
+        T block_b[3][kernel_block];
+        T block_r[3][kernel_block];
+        for (std::size_t i = 0; i < n; i += kernel_block)
+        {
+            const std::size_t m{std::min(kernel_block, n - i)};
+            detail::load_block(sa + i * 3, m, block_a);
+            detail::load_block(sb + i * 3, m, block_b);
+            for (std::size_t j = 0; j < m; ++j)
+            {
+                block_r[0][j] = block_a[1][j] * block_b[2][j] - block_a[2][j] * block_b[1][j];
+                block_r[1][j] = block_a[2][j] * block_b[0][j] - block_a[0][j] * block_b[2][j];
+                block_r[2][j] = block_a[0][j] * block_b[1][j] - block_a[1][j] * block_b[0][j];
+            }
+            detail::store_block(dst + i * 3, m, block_r);
+        }
+    }
+
+    // y[i] += alpha * x[i]
+    template <typename V>
+    void axpy(detail::scalar_t<V> alpha, const V *x, V *y, std::size_t n) noexcept
+    {
+        using T = detail::scalar_t<V>;
+        constexpr std::size_t N{detail::vector_traits<V>::size};
+
+        // Component-wise, so the interleaved layout is already contiguous
+        const T *sx{detail::scalars(x)};
+        T *sy{detail::scalars(y)};
+        for (std::size_t i = 0; i < n * N; ++i)
+            sy[i] += sx[i] * alpha;
+    }
+
+    // out[i] = in[i].norm_squared<R>() (e.g. norm_squared_wide() for vec::wide_norm_t)
+    template <typename V, typename R>
+    void norm_squared_many(const V *in, R *out, std::size_t n) noexcept
+    {
+        using T = detail::scalar_t<V>;
+        constexpr std::size_t N{detail::vector_traits<V>::size};
+
+        const T *src{detail::scalars(in)};
+        T block[N][kernel_block];
+        for (std::size_t i = 0; i < n; i += kernel_block)
+        {
+            const std::size_t m{std::min(kernel_block, n - i)};
+            detail::load_block(src + i * N, m, block);
+            detail::block_norm_squared(block, m, out + i);
+        }
+    }
+
+    // out[i] = in[i].length()
+    template <typename V>
+    void length_many(const V *in, detail::norm_t<V> *out, std::size_t n) noexcept
+    {
+        norm_squared_many(in, out, n);
+        detail::sqrt_block(out, n);
+    }
+} // namespace vec
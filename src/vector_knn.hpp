@@ -0,0 +1,271 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+#include "simd.hpp"
+#include "spatial_index.hpp"
+#include "thread_pool.hpp"
+#include "vector_traits.hpp"
+
+/*
+ * Brute-force neighbour search between arrays of vectors
+ *
+ * For embeddings (Vector4f, VectorN<float, 128>, ...) where an index does
+ * not pay off, every query is compared with every database vector through
+ * |a - b|^2 = |a|^2 - 2 a.b + |b|^2, so the work is a matrix of dot
+ * products. The database is transposed once into tiles of about 16 KB
+ * (one array per component, zero-padded to a whole tile). Each tile is
+ * then swept by a chunk of queries while it sits in L1, four queries
+ * against eight database vectors at a time in a micro-kernel whose
+ * accumulators stay in registers and whose inner loops the compiler
+ * vectorizes. Chunks of queries run in parallel on a ThreadPool.
+ *
+ * Squared norms are computed with norm_squared() and the dot products in
+ * the same precision (that of norm_squared(): float for float vectors,
+ * double for integer vectors). The expanded form loses accuracy on points
+ * much closer to each other than to the origin. Its results are within
+ * a few roundings of (a - b).norm_squared() and are clamped at zero.
+ */
+namespace vec
+{
+    namespace detail
+    {
+        // Database vectors and queries per micro-kernel step
+        inline constexpr std::size_t knn_lanes{8};
+        inline constexpr std::size_t knn_queries{4};
+
+        // Database vectors per tile: about 16 KB of components, half of a typical L1
+        template <typename D, std::size_t N>
+        inline constexpr std::size_t knn_tile{
+            std::clamp<std::size_t>(16384 / (N * sizeof(D)) / knn_lanes * knn_lanes, knn_lanes, 1024)};
+
+        /**
+         * @brief Database transposed tile by tile, with squared norms
+         *
+         * Component c of vector t * tile + j is at data()[(t * N + c) * tile + j].
+         */
+        template <typename V>
+        class packed_database
+        {
+        public:
+            using D = distance_t<V>;
+            static constexpr std::size_t N{vector_traits<V>::size};
+            static constexpr std::size_t tile{knn_tile<D, N>};
+
+            packed_database(const V *v, std::size_t n, ThreadPool &pool)
+                : n_(n), tiles_((n + tile - 1) / tile), data_(tiles_ * N * tile), norms_(n)
+            {
+                pool.parallel_for(tiles_, [&](std::size_t t)
+                                  {
+                                      D *block{data_.data() + t * N * tile};
+                                      for (std::size_t j = 0; j < length(t); ++j)
+                                      {
+                                          const V &p{v[t * tile + j]};
+                                          for (std::size_t c = 0; c < N; ++c)
+                                              block[c * tile + j] = static_cast<D>(p[c]);
+                                          norms_[t * tile + j] = p.template norm_squared<D>();
+                                      }
+                                  });
+            }
+
+            [[nodiscard]] std::size_t size() const noexcept { return n_; }
+            [[nodiscard]] std::size_t tiles() const noexcept { return tiles_; }
+            [[nodiscard]] std::size_t length(std::size_t t) const noexcept { return std::min(tile, n_ - t * tile); }
+            [[nodiscard]] const D *block(std::size_t t) const noexcept { return data_.data() + t * N * tile; }
+            [[nodiscard]] const D *norms() const noexcept { return norms_.data(); }
+
+        private:
+            std::size_t n_;
+            std::size_t tiles_;
+            std::vector<D> data_;
+            std::vector<D> norms_;
+        };
+
+        // Up to knn_queries queries, zero-padded
+        template <typename D, std::size_t N>
+        struct query_group
+        {
+            D q[knn_queries][N];
+        };
+
+        // r[i][j] = dot of query i with vector j of a tile, for j < len rounded up to knn_lanes
+        template <std::size_t tile, typename D, std::size_t N>
+        void dot_tile(const query_group<D, N> &g, const D *block, std::size_t len, D (&r)[knn_queries][tile]) noexcept
+        {
+            using S = simd4<D>;
+            if constexpr (S::enabled)
+            {
+                // Spelled out with the backend: left to itself the compiler vectorizes across c instead
+                constexpr std::size_t regs{knn_lanes / 4};
+                for (std::size_t j = 0; j < len; j += knn_lanes)
+                {
+                    typename S::reg acc[knn_queries][regs];
+                    for (std::size_t i = 0; i < knn_queries; ++i)
+                        for (std::size_t h = 0; h < regs; ++h)
+                            acc[i][h] = S::set1(0);
+                    for (std::size_t c = 0; c < N; ++c)
+                    {
+                        typename S::reg b[regs];
+                        for (std::size_t h = 0; h < regs; ++h)
+                            b[h] = S::load(block + c * tile + j + 4 * h);
+                        for (std::size_t i = 0; i < knn_queries; ++i)
+                        {
+                            const typename S::reg q{S::set1(g.q[i][c])};
+                            for (std::size_t h = 0; h < regs; ++h)
+                                acc[i][h] = S::add(acc[i][h], S::mul(q, b[h]));
+                        }
+                    }
+                    for (std::size_t i = 0; i < knn_queries; ++i)
+                        for (std::size_t h = 0; h < regs; ++h)
+                            S::store(&r[i][j + 4 * h], acc[i][h]);
+                }
+                return;
+            }
+            for (std::size_t j = 0; j < len; j += knn_lanes)
+            {
+                D acc[knn_queries][knn_lanes]{};
+                for (std::size_t c = 0; c < N; ++c)
+                {
+                    const D *b{block + c * tile + j};
+                    for (std::size_t i = 0; i < knn_queries; ++i)
+                        for (std::size_t l = 0; l < knn_lanes; ++l)
+                            acc[i][l] += g.q[i][c] * b[l];
+                }
+                for (std::size_t i = 0; i < knn_queries; ++i)
+                    for (std::size_t l = 0; l < knn_lanes; ++l)
+                        r[i][j + l] = acc[i][l];
+            }
+        }
+
+        /**
+         * @brief f(i, t, dots) for every query i and database tile t
+         *
+         * dots[j] is the dot product of queries[i] with database vector
+         * t * tile + j, for j < db.length(t). Queries are split into chunks
+         * across the pool; within a chunk f sees the tiles in order, and
+         * each query's calls come from a single thread.
+         */
+        template <typename V, typename F>
+        void for_each_dot_tile(const V *queries, std::size_t m, const packed_database<V> &db, ThreadPool &pool, F f)
+        {
+            using D = distance_t<V>;
+            constexpr std::size_t N{vector_traits<V>::size};
+            constexpr std::size_t tile{packed_database<V>::tile};
+
+            pool.parallel_for((m + query_chunk - 1) / query_chunk, [&](std::size_t chunk)
+                              {
+                                  const std::size_t begin{chunk * query_chunk};
+                                  const std::size_t count{std::min(query_chunk, m - begin)};
+                                  std::vector<query_group<D, N>> groups((count + knn_queries - 1) / knn_queries);
+                                  for (std::size_t i = 0; i < count; ++i)
+                                      for (std::size_t c = 0; c < N; ++c)
+                                          groups[i / knn_queries].q[i % knn_queries][c] = static_cast<D>(queries[begin + i][c]);
+
+                                  D dots[knn_queries][tile];
+                                  for (std::size_t t = 0; t < db.tiles(); ++t)
+                                      for (std::size_t g = 0; g < groups.size(); ++g)
+                                      {
+                                          dot_tile(groups[g], db.block(t), db.length(t), dots);
+                                          for (std::size_t i = 0; i < std::min(knn_queries, count - g * knn_queries); ++i)
+                                              f(begin + g * knn_queries + i, t, dots[i]);
+                                      }
+                              });
+        }
+
+        // |a|^2 + |b|^2 - 2 a.b, clamped at zero
+        template <typename D>
+        constexpr D expanded_distance(D a_norm, D b_norm, D dot) noexcept
+        {
+            const D d{a_norm + b_norm - 2 * dot};
+            return d > 0 ? d : D{0};
+        }
+    } // namespace detail
+
+    /**
+     * @brief The k nearest database vectors of each query, by squared distance
+     *
+     * Writes the neighbours of queries[i] to out[i * k, (i + 1) * k), closest
+     * first (ties by lower index); k <= n.
+     */
+    template <typename V>
+    void knn_brute_force(const V *queries, std::size_t m, const V *database, std::size_t n, std::size_t k,
+                         Neighbor<detail::distance_t<V>> *out, ThreadPool &pool = ThreadPool::global())
+    {
+        using D = detail::distance_t<V>;
+        constexpr std::size_t tile{detail::packed_database<V>::tile};
+        assert(k <= n);
+        if (m == 0 || k == 0)
+            return;
+
+        const detail::packed_database<V> db(database, n, pool);
+        std::vector<D> query_norms(m);
+        for (std::size_t i = 0; i < m; ++i)
+            query_norms[i] = queries[i].template norm_squared<D>();
+
+        // One heap per query, each filled by the thread that owns its chunk
+        std::vector<std::vector<Neighbor<D>>> found(m);
+        std::vector<detail::nearest_heap<D>> heaps;
+        heaps.reserve(m);
+        for (std::size_t i = 0; i < m; ++i)
+            heaps.emplace_back(k, found[i]);
+
+        detail::for_each_dot_tile(queries, m, db, pool, [&](std::size_t i, std::size_t t, const D *dots)
+                                  {
+                                      // Distances in a loop the compiler vectorizes, then the rare heap updates
+                                      const std::size_t len{db.length(t)};
+                                      const D *norms{db.norms() + t * tile};
+                                      D distances[tile];
+                                      for (std::size_t j = 0; j < len; ++j)
+                                          distances[j] = detail::expanded_distance(query_norms[i], norms[j], dots[j]);
+                                      detail::nearest_heap<D> &heap{heaps[i]};
+                                      D worst{heap.worst()};
+                                      for (std::size_t j = 0; j < len; ++j)
+                                          if (distances[j] <= worst)
+                                          {
+                                              heap.push(t * tile + j, distances[j]);
+                                              worst = heap.worst();
+                                          }
+                                  });
+
+        for (std::size_t i = 0; i < m; ++i)
+        {
+            heaps[i].finish();
+            std::copy(found[i].begin(), found[i].end(), out + i * k);
+        }
+    }
+
+    // out[i * n + j] = |queries[i] - database[j]|^2 (m x n, row-major)
+    template <typename V>
+    void squared_distances(const V *queries, std::size_t m, const V *database, std::size_t n,
+                           detail::distance_t<V> *out, ThreadPool &pool = ThreadPool::global())
+    {
+        using D = detail::distance_t<V>;
+        constexpr std::size_t tile{detail::packed_database<V>::tile};
+        const detail::packed_database<V> db(database, n, pool);
+        std::vector<D> query_norms(m);
+        for (std::size_t i = 0; i < m; ++i)
+            query_norms[i] = queries[i].template norm_squared<D>();
+        detail::for_each_dot_tile(queries, m, db, pool, [&](std::size_t i, std::size_t t, const D *dots)
+                                  {
+                                      const D *norms{db.norms() + t * tile};
+                                      D *row{out + i * n + t * tile};
+                                      for (std::size_t j = 0; j < db.length(t); ++j)
+                                          row[j] = detail::expanded_distance(query_norms[i], norms[j], dots[j]);
+                                  });
+    }
+
+    // out[i * n + j] = queries[i].dot(database[j]) (m x n, row-major)
+    template <typename V>
+    void dot_products(const V *queries, std::size_t m, const V *database, std::size_t n, detail::distance_t<V> *out,
+                      ThreadPool &pool = ThreadPool::global())
+    {
+        using D = detail::distance_t<V>;
+        constexpr std::size_t tile{detail::packed_database<V>::tile};
+        const detail::packed_database<V> db(database, n, pool);
+        detail::for_each_dot_tile(queries, m, db, pool, [&](std::size_t i, std::size_t t, const D *dots)
+                                  { std::copy(dots, dots + db.length(t), out + i * n + t * tile); });
+    }
+} // namespace vec
@@ -0,0 +1,707 @@
+#pragma once
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+#include "vector_array.hpp"
+#include "vector_dispatch.hpp"
+#include "vector_kernels.hpp"
+
+/*
+ * Component-wise exp, log, sin, cos, atan2 and pow
+ *
+ * The std:: functions are opaque library calls, so a loop over them stays
+ * one component at a time. The kernels here are short branch-free
+ * polynomials (Cephes coefficients) with bit-mask selects for the special
+ * cases, so loops over arrays vectorize: vec::exp(v) on a VectorN,
+ * vec::exp(a) on a VectorArray (stream by stream) and vec::exp_many(in,
+ * out, n) on arrays of vectors. The VectorArray functions and
+ * vec::dispatched::exp_many etc. run at the CPU's instruction-set level
+ * (vector_dispatch.hpp). The double kernels, and float pow, need SSE4.1 to
+ * vectorize, for 64-bit compares; built for plain SSE2 they run one
+ * component at a time and are slower than std::. float and double only.
+ *
+ * Largest errors against the exact result, measured on random arguments
+ * over the finite domain unless noted (tests/test_vector_math.cpp):
+ *
+ *              float       double
+ *     exp      1 ulp       2 ulp
+ *     log      1 ulp       1 ulp
+ *     sin/cos  2 ulp       2 ulp         |x| < 1e8
+ *     atan2    3 ulp       2 ulp
+ *     pow      1 ulp       1 + 2 |y ln x| ulp   0 < x < 100, |y| < 20
+ *
+ * sin and cos reduce by pi/2 in three parts (Cody-Waite), in double for
+ * both types, and lose accuracy beyond that range; there is no reduction for
+ * huge arguments. float pow runs through the double kernels; double pow is
+ * exp(y * log(x)), whose error grows with the size of y * log(x). Special
+ * values (zeros, infinities, NaN, negative bases with integer exponents)
+ * follow std::.
+ */
+namespace vec
+{
+    namespace detail
+    {
+        template <typename T>
+        inline constexpr bool math_scalar{std::is_same_v<T, float> || std::is_same_v<T, double>};
+
+        inline std::uint32_t to_bits(float x) noexcept
+        {
+            std::uint32_t u;
+            std::memcpy(&u, &x, sizeof(u));
+            return u;
+        }
+
+        inline std::uint64_t to_bits(double x) noexcept
+        {
+            std::uint64_t u;
+            std::memcpy(&u, &x, sizeof(u));
+            return u;
+        }
+
+        inline float from_bits(std::uint32_t u) noexcept
+        {
+            float x;
+            std::memcpy(&x, &u, sizeof(x));
+            return x;
+        }
+
+        inline double from_bits(std::uint64_t u) noexcept
+        {
+            double x;
+            std::memcpy(&x, &u, sizeof(x));
+            return x;
+        }
+
+        // c ? a : b through a bit mask: GCC will not turn a branch whose
+        // floating-point operations may trap into a vector select. For the
+        // same reason the kernels combine conditions with & and |, not && and ||
+        template <typename T>
+        inline T select(bool c, T a, T b) noexcept
+        {
+            using U = decltype(to_bits(a));
+            const U mask{U{0} - static_cast<U>(c)};
+            return from_bits((to_bits(a) & mask) | (to_bits(b) & ~mask));
+        }
+
+        // Adding and subtracting it rounds to an integer, held in the low bits in between
+        template <typename T>
+        inline constexpr T round_magic{T(std::uint64_t{3} << (std::numeric_limits<T>::digits - 2))};
+
+        // Smallest T whose neighbours are all integers
+        template <typename T>
+        inline constexpr T integer_bound{T(std::uint64_t{1} << (std::numeric_limits<T>::digits - 1))};
+
+        // 2^k as two factors so that k reaches below the normal range; k wraps like unsigned
+        template <typename U>
+        inline auto exp2_split(U k) noexcept
+        {
+            constexpr int bits{std::numeric_limits<U>::digits};
+            constexpr U mantissa{bits == 32 ? 23 : 52};
+            constexpr U bias{bits == 32 ? 127 : 1023};
+            constexpr U offset{bits == 32 ? 2048 : 4096};
+            const U half{((k + offset) >> 1) - offset / 2};
+            struct factors
+            {
+                decltype(from_bits(U{})) a, b;
+            };
+            return factors{from_bits((half + bias) << mantissa), from_bits((k - half + bias) << mantissa)};
+        }
+
+        inline float math_exp(float x) noexcept
+        {
+            // Clamped so that 2^n saturates; NaN fails both tests
+            x = select(std::isgreater(x, 88.8f), 88.8f, x);
+            x = select(std::isless(x, -105.0f), -105.0f, x);
+            const float t{x * 1.44269504088896341f + round_magic<float>};
+            const float n{t - round_magic<float>};
+            const auto [s1, s2]{exp2_split(to_bits(t) - to_bits(round_magic<float>))};
+
+            // r = x - n ln 2, ln 2 in two parts
+            const float r{(x - n * 0.693359375f) - n * -2.12194440e-4f};
+            float p{1.9875691500e-4f};
+            p = p * r + 1.3981999507e-3f;
+            p = p * r + 8.3334519073e-3f;
+            p = p * r + 4.1665795894e-2f;
+            p = p * r + 1.6666665459e-1f;
+            p = p * r + 5.0000001201e-1f;
+            p = p * (r * r) + r + 1.0f;
+            return p * s1 * s2;
+        }
+
+        inline double math_exp(double x) noexcept
+        {
+            x = select(std::isgreater(x, 709.8), 709.8, x);
+            x = select(std::isless(x, -746.0), -746.0, x);
+            const double t{x * 1.4426950408889634074 + round_magic<double>};
+            const double n{t - round_magic<double>};
+            const auto [s1, s2]{exp2_split(to_bits(t) - to_bits(round_magic<double>))};
+
+            // e^r = 1 + 2 r P(r^2) / (Q(r^2) - r P(r^2))
+            const double r{(x - n * 6.93145751953125e-1) - n * 1.42860682030941723212e-6};
+            const double z{r * r};
+            const double p{r * ((1.26177193074810590878e-4 * z + 3.02994407707441961300e-2) * z +
+                                9.99999999999999999910e-1)};
+            const double q{((3.00198505138664455042e-6 * z + 2.52448340349684104192e-3) * z +
+                            2.27265548208155028766e-1) *
+                               z +
+                           2.0};
+            return (1.0 + 2.0 * (p / (q - p))) * s1 * s2;
+        }
+
+        inline float math_log(float x) noexcept
+        {
+            // x = m 2^e with m in [sqrt(1/2), sqrt(2)); subnormals scaled up first
+            const bool tiny{std::isless(x, std::numeric_limits<float>::min())};
+            const std::uint32_t b{to_bits(select(tiny, x * 0x1p23f, x))};
+            float e{static_cast<float>(static_cast<std::int32_t>((b >> 23) & 0xff)) - select(tiny, 149.0f, 126.0f)};
+            const float m{from_bits((b & 0x007fffffu) | 0x3f000000u)};
+            const bool low{std::isless(m, 0.707106781186547524f)};
+            e = select(low, e - 1.0f, e);
+            const float f{select(low, m + m - 1.0f, m - 1.0f)};
+
+            const float z{f * f};
+            float p{7.0376836292e-2f};
+            p = p * f - 1.1514610310e-1f;
+            p = p * f + 1.1676998740e-1f;
+            p = p * f - 1.2420140846e-1f;
+            p = p * f + 1.4249322787e-1f;
+            p = p * f - 1.6668057665e-1f;
+            p = p * f + 2.0000714765e-1f;
+            p = p * f - 2.4999993993e-1f;
+            p = p * f + 3.3333331174e-1f;
+            const float y{p * f * z + e * -2.12194440e-4f - 0.5f * z};
+            float r{(f + y) + e * 0.693359375f};
+
+            r = select(x == 0.0f, -std::numeric_limits<float>::infinity(), r);
+            r = select(std::isless(x, 0.0f), std::numeric_limits<float>::quiet_NaN(), r);
+            r = select(x == std::numeric_limits<float>::infinity(), x, r);
+            return select(x != x, x, r);
+        }
+
+        inline double math_log(double x) noexcept
+        {
+            const bool tiny{std::isless(x, std::numeric_limits<double>::min())};
+            const std::uint64_t b{to_bits(select(tiny, x * 0x1p54, x))};
+            // The biased exponent converted through the mantissa of 2^52
+            const double biased{from_bits(to_bits(0x1p52) | ((b >> 52) & 0x7ff)) - 0x1p52};
+            double e{biased - select(tiny, 1076.0, 1022.0)};
+            const double m{from_bits((b & 0x000fffffffffffffu) | 0x3fe0000000000000u)};
+            const bool low{std::isless(m, 0.70710678118654752440)};
+            e = select(low, e - 1.0, e);
+            const double f{select(low, m + m - 1.0, m - 1.0)};
+
+            // log(1 + f) = f - f^2 / 2 + f^3 P(f) / Q(f)
+            const double z{f * f};
+            double p{1.01875663804580931796e-4};
+            p = p * f + 4.97494994976747001425e-1;
+            p = p * f + 4.70579119878881725854e0;
+            p = p * f + 1.44989225341610930846e1;
+            p = p * f + 1.79368678507819816313e1;
+            p = p * f + 7.70838733755885391666e0;
+            double q{f + 1.12873587189167450590e1};
+            q = q * f + 4.52279145837532221105e1;
+            q = q * f + 8.29875266912776603211e1;
+            q = q * f + 7.11544750618563894466e1;
+            q = q * f + 2.31251620126765340583e1;
+            const double y{f * (z * p / q) - e * 2.121944400546905827679e-4 - 0.5 * z};
+            double r{(f + y) + e * 0.693359375};
+
+            r = select(x == 0.0, -std::numeric_limits<double>::infinity(), r);
+            r = select(std::isless(x, 0.0), std::numeric_limits<double>::quiet_NaN(), r);
+            r = select(x == std::numeric_limits<double>::infinity(), x, r);
+            return select(x != x, x, r);
+        }
+
+        struct quadrant
+        {
+            double r;
+            std::uint64_t n;
+        };
+
+        // x = r + n pi/2 with |r| <= pi/4, pi/2 in three parts; n modulo 4 in the low bits
+        inline quadrant reduce_half_pi(double x) noexcept
+        {
+            const double t{x * 0.63661977236758134308 + round_magic<double>};
+            const double n{t - round_magic<double>};
+            const double r{((x - n * 1.57079625129699707031e0) - n * 7.54978941586159635335e-8) -
+                           n * 5.39030285815811905290e-15};
+            return {r, to_bits(t) - to_bits(round_magic<double>)};
+        }
+
+        // sin(x), or cos(x) as sin of the next quadrant
+        template <bool Cos>
+        inline float math_sin(float x) noexcept
+        {
+            // Reduced in double: near multiples of pi/2 float reduction loses the result
+            const auto [rd, n]{reduce_half_pi(x)};
+            const std::uint32_t q{static_cast<std::uint32_t>(n) + (Cos ? 1u : 0u)};
+            const auto r{static_cast<float>(rd)};
+
+            const float z{r * r};
+            float s{((-1.9515295891e-4f * z + 8.3321608736e-3f) * z - 1.6666654611e-1f) * z * r + r};
+            s = select(r == 0.0f, r, s); // sin(-0) = -0
+            const float c{((2.443315711809948e-5f * z - 1.388731625493765e-3f) * z + 4.166664568298827e-2f) * z * z -
+                          0.5f * z + 1.0f};
+            // Quadrants 1 and 3 take the cosine, 2 and 3 flip the sign; in integers, as
+            // GCC narrows (q & 1) != 0 to a one-bit bool it cannot vectorize
+            const std::uint32_t odd{0u - (q & 1u)};
+            const float v{from_bits((to_bits(c) & odd) | (to_bits(s) & ~odd))};
+            return from_bits(to_bits(v) ^ (q & 2u) << 30);
+        }
+
+        template <bool Cos>
+        inline double math_sin(double x) noexcept
+        {
+            const auto [r, n]{reduce_half_pi(x)};
+            const std::uint64_t q{n + (Cos ? 1u : 0u)};
+
+            const double z{r * r};
+            double s{1.58962301576546568060e-10};
+            s = s * z - 2.50507477628578072866e-8;
+            s = s * z + 2.75573136213857245213e-6;
+            s = s * z - 1.98412698295895385996e-4;
+            s = s * z + 8.33333333332211858878e-3;
+            s = s * z - 1.66666666666666307295e-1;
+            s = select(r == 0.0, r, r + r * z * s);
+            double c{-1.13585365213876817300e-11};
+            c = c * z + 2.08757008419747316778e-9;
+            c = c * z - 2.75573141792967388112e-7;
+            c = c * z + 2.48015872888517045348e-5;
+            c = c * z - 1.38888888888730564116e-3;
+            c = c * z + 4.16666666666665929218e-2;
+            c = 1.0 - 0.5 * z + z * z * c;
+            const std::uint64_t odd{0u - (q & 1u)};
+            const double v{from_bits((to_bits(c) & odd) | (to_bits(s) & ~odd))};
+            return from_bits(to_bits(v) ^ (q & 2u) << 62);
+        }
+
+        inline float math_atan2(float y, float x) noexcept
+        {
+            // atan of min / max in [0, 1], as pi/4 + atan((min - max) / (min + max)) above tan(pi/8)
+            const float ay{std::fabs(y)};
+            const float ax{std::fabs(x)};
+            const bool steep{std::isgreater(ay, ax)};
+            const float hi{select(steep, ay, ax)};
+            const float lo{select(steep, ax, ay)};
+            const bool infinite{lo == std::numeric_limits<float>::infinity()};
+            // Tested on the ratio itself: a product like 0.414 * hi rounds up to hi for subnormals
+            const float ratio{lo / hi};
+            const bool wide{std::isgreater(ratio, 0.414213562373095049f)};
+            const bool big{infinite || wide};
+            float w{select(big, (lo - hi) / (lo + hi), ratio)};
+            w = select((hi == 0.0f) | infinite, 0.0f, w);
+
+            const float z{w * w};
+            float r{(((8.05374449538e-2f * z - 1.38776856032e-1f) * z + 1.99777106478e-1f) * z - 3.33329491539e-1f) *
+                        z * w +
+                    w};
+
+            // The angle is k pi/4 +- r, pi/4 in two parts
+            const bool negative{to_bits(x) >> 31 != 0};
+            float k{select(big, 1.0f, 0.0f)};
+            k = select(steep, 2.0f - k, k);
+            k = select(negative, 4.0f - k, k);
+            r = select(steep != negative, -r, r);
+            r = k * 0.785398185253143310546875f + (k * -2.18556950e-8f + r);
+            r = select(to_bits(y) >> 31 != 0, -r, r);
+            return select((x != x) | (y != y), x + y, r);
+        }
+
+        inline double math_atan2(double y, double x) noexcept
+        {
+            // As for float, reduced above 0.66
+            const double ay{std::fabs(y)};
+            const double ax{std::fabs(x)};
+            const bool steep{std::isgreater(ay, ax)};
+            const double hi{select(steep, ay, ax)};
+            const double lo{select(steep, ax, ay)};
+            const bool infinite{lo == std::numeric_limits<double>::infinity()};
+            const double ratio{lo / hi};
+            const bool wide{std::isgreater(ratio, 0.66)};
+            const bool big{infinite || wide};
+            double w{select(big, (lo - hi) / (lo + hi), ratio)};
+            w = select((hi == 0.0) | infinite, 0.0, w);
+
+            const double z{w * w};
+            double p{-8.750608600031904122785e-1};
+            p = p * z - 1.615753718733365076637e1;
+            p = p * z - 7.500855792314704667340e1;
+            p = p * z - 1.228866684490136173410e2;
+            p = p * z - 6.485021904942025371773e1;
+            double q{z + 2.485846490142306297962e1};
+            q = q * z + 1.650270098316988542046e2;
+            q = q * z + 4.328810604912902668951e2;
+            q = q * z + 4.853903996359136964868e2;
+            q = q * z + 1.945506571482613964425e2;
+            double r{w * (z * p / q) + w};
+
+            const bool negative{to_bits(x) >> 63 != 0};
+            double k{select(big, 1.0, 0.0)};
+            k = select(steep, 2.0 - k, k);
+            k = select(negative, 4.0 - k, k);
+            r = select(steep != negative, -r, r);
+            r = k * 7.85398163397448278999e-1 + (k * 3.06161699786838301793e-17 + r);
+            r = select(to_bits(y) >> 63 != 0, -r, r);
+            return select((x != x) | (y != y), x + y, r);
+        }
+
+        template <typename T>
+        inline T math_pow(T x, T y) noexcept
+        {
+            // |x|^y through double, then the sign and the cases exp(y log |x|) gets wrong
+            const double l{math_log(static_cast<double>(std::fabs(x)))};
+            T r{static_cast<T>(math_exp(static_cast<double>(y) * l))};
+
+            const T ay{std::fabs(y)};
+            const bool large{std::isgreaterequal(ay, integer_bound<T>)};
+            const T t{ay + integer_bound<T>};
+            const bool exact{t - integer_bound<T> == ay};
+            const bool integral{large || exact};
+            // Odd integer exponents give r the sign of x: the parity bit of t moved to the sign bit
+            using U = decltype(to_bits(x));
+            const U odd{(to_bits(t) & U{1}) << (std::numeric_limits<U>::digits - 1)};
+            r = select(exact && !large, from_bits(to_bits(r) ^ (to_bits(x) & odd)), r);
+            const bool below{std::isless(x, T(0))};
+            const bool finite{std::isgreater(x, -std::numeric_limits<T>::infinity())};
+            r = select(below & finite & !integral, std::numeric_limits<T>::quiet_NaN(), r);
+            r = select((x == T(-1)) & (ay == std::numeric_limits<T>::infinity()), T(1), r);
+            r = select(y == 1, x, r);
+            return select((y == 0) | (x == 1), T(1), r);
+        }
+
+        struct exp_fn
+        {
+            template <typename T>
+            T operator()(T a) const noexcept
+            {
+                return math_exp(a);
+            }
+        };
+
+        struct log_fn
+        {
+            template <typename T>
+            T operator()(T a) const noexcept
+            {
+                return math_log(a);
+            }
+        };
+
+        struct sin_fn
+        {
+            template <typename T>
+            T operator()(T a) const noexcept
+            {
+                return math_sin<false>(a);
+            }
+        };
+
+        struct cos_fn
+        {
+            template <typename T>
+            T operator()(T a) const noexcept
+            {
+                return math_sin<true>(a);
+            }
+        };
+
+        struct atan2_fn
+        {
+            template <typename T>
+            T operator()(T y, T x) const noexcept
+            {
+                return math_atan2(y, x);
+            }
+        };
+
+        struct pow_fn
+        {
+            template <typename T>
+            T operator()(T a, T e) const noexcept
+            {
+                return math_pow(a, e);
+            }
+        };
+
+        // out[i] = f(a[i]), a loop the compiler vectorizes
+        template <typename T, typename F>
+        void math_map(const T *a, T *out, std::size_t n, F f) noexcept
+        {
+            static_assert(math_scalar<T>, "vector math needs float or double components");
+            for (std::size_t i = 0; i < n; ++i)
+                out[i] = f(a[i]);
+        }
+
+        template <typename T, typename F>
+        void math_zip(const T *a, const T *b, T *out, std::size_t n, F f) noexcept
+        {
+            static_assert(math_scalar<T>, "vector math needs float or double components");
+            for (std::size_t i = 0; i < n; ++i)
+                out[i] = f(a[i], b[i]);
+        }
+
+        template <typename T, typename F>
+        void math_zip(const T *a, T b, T *out, std::size_t n, F f) noexcept
+        {
+            static_assert(math_scalar<T>, "vector math needs float or double components");
+            for (std::size_t i = 0; i < n; ++i)
+                out[i] = f(a[i], b);
+        }
+
+        template <typename T, std::size_t N, typename F>
+        VectorN<T, N> math_map(const VectorN<T, N> &v, F f) noexcept
+        {
+            VectorN<T, N> r;
+            math_map(v.data(), r.data(), N, f);
+            return r;
+        }
+
+        template <typename T, std::size_t N, typename F>
+        VectorN<T, N> math_zip(const VectorN<T, N> &a, const VectorN<T, N> &b, F f) noexcept
+        {
+            VectorN<T, N> r;
+            math_zip(a.data(), b.data(), r.data(), N, f);
+            return r;
+        }
+
+        // The loops above as kernels for vec::detail::dispatch
+        template <typename F>
+        struct math_map_kernel
+        {
+            template <typename T>
+            static void run(const T *a, T *out, std::size_t n) noexcept
+            {
+                math_map(a, out, n, F{});
+            }
+        };
+
+        template <typename F>
+        struct math_zip_kernel
+        {
+            template <typename T, typename B>
+            static void run(const T *a, B b, T *out, std::size_t n) noexcept
+            {
+                math_zip(a, b, out, n, F{});
+            }
+        };
+
+        // Stream by stream, at active_simd_level()
+        template <typename F, typename T, std::size_t N>
+        VectorArray<T, N> math_map(const VectorArray<T, N> &a)
+        {
+            VectorArray<T, N> r{VectorArray<T, N>::uninitialized(a.size())};
+            for (std::size_t c = 0; c < N; ++c)
+                dispatch<math_map_kernel<F>>(a.data(c), r.data(c), a.size());
+            return r;
+        }
+
+        template <typename F, typename T, std::size_t N>
+        VectorArray<T, N> math_zip(const VectorArray<T, N> &a, const VectorArray<T, N> &b)
+        {
+            assert(a.size() == b.size());
+            VectorArray<T, N> r{VectorArray<T, N>::uninitialized(a.size())};
+            for (std::size_t c = 0; c < N; ++c)
+                dispatch<math_zip_kernel<F>>(a.data(c), b.data(c), r.data(c), a.size());
+            return r;
+        }
+
+        template <typename F, typename T, std::size_t N>
+        VectorArray<T, N> math_zip(const VectorArray<T, N> &a, T b)
+        {
+            VectorArray<T, N> r{VectorArray<T, N>::uninitialized(a.size())};
+            for (std::size_t c = 0; c < N; ++c)
+                dispatch<math_zip_kernel<F>>(a.data(c), b, r.data(c), a.size());
+            return r;
+        }
+    } // namespace detail
+
+    // Vectors: each component
+
+    template <typename T, std::size_t N>
+    [[nodiscard]] VectorN<T, N> exp(const VectorN<T, N> &v) noexcept
+    {
+        return detail::math_map(v, detail::exp_fn{});
+    }
+
+    template <typename T, std::size_t N>
+    [[nodiscard]] VectorN<T, N> log(const VectorN<T, N> &v) noexcept
+    {
+        return detail::math_map(v, detail::log_fn{});
+    }
+
+    template <typename T, std::size_t N>
+    [[nodiscard]] VectorN<T, N> sin(const VectorN<T, N> &v) noexcept
+    {
+        return detail::math_map(v, detail::sin_fn{});
+    }
+
+    template <typename T, std::size_t N>
+    [[nodiscard]] VectorN<T, N> cos(const VectorN<T, N> &v) noexcept
+    {
+        return detail::math_map(v, detail::cos_fn{});
+    }
+
+    // atan2(y[i], x[i])
+    template <typename T, std::size_t N>
+    [[nodiscard]] VectorN<T, N> atan2(const VectorN<T, N> &y, const VectorN<T, N> &x) noexcept
+    {
+        return detail::math_zip(y, x, detail::atan2_fn{});
+    }
+
+    // v[i]^e[i]; for a constant integer exponent v.pow<E>() is exact and cheaper
+    template <typename T, std::size_t N>
+    [[nodiscard]] VectorN<T, N> pow(const VectorN<T, N> &v, const VectorN<T, N> &e) noexcept
+    {
+        return detail::math_zip(v, e, detail::pow_fn{});
+    }
+
+    template <typename T, std::size_t N>
+    [[nodiscard]] VectorN<T, N> pow(const VectorN<T, N> &v, T e) noexcept
+    {
+        VectorN<T, N> r;
+        detail::math_zip(v.data(), e, r.data(), N, detail::pow_fn{});
+        return r;
+    }
+
+    // Structure-of-arrays containers: each component of each element, at active_simd_level()
+
+    template <typename T, std::size_t N>
+    [[nodiscard]] VectorArray<T, N> exp(const VectorArray<T, N> &a)
+    {
+        return detail::math_map<detail::exp_fn>(a);
+    }
+
+    template <typename T, std::size_t N>
+    [[nodiscard]] VectorArray<T, N> log(const VectorArray<T, N> &a)
+    {
+        return detail::math_map<detail::log_fn>(a);
+    }
+
+    template <typename T, std::size_t N>
+    [[nodiscard]] VectorArray<T, N> sin(const VectorArray<T, N> &a)
+    {
+        return detail::math_map<detail::sin_fn>(a);
+    }
+
+    template <typename T, std::size_t N>
+    [[nodiscard]] VectorArray<T, N> cos(const VectorArray<T, N> &a)
+    {
+        return detail::math_map<detail::cos_fn>(a);
+    }
+
+    template <typename T, std::size_t N>
+    [[nodiscard]] VectorArray<T, N> atan2(const VectorArray<T, N> &y, const VectorArray<T, N> &x)
+    {
+        return detail::math_zip<detail::atan2_fn>(y, x);
+    }
+
+    template <typename T, std::size_t N>
+    [[nodiscard]] VectorArray<T, N> pow(const VectorArray<T, N> &a, const VectorArray<T, N> &e)
+    {
+        return detail::math_zip<detail::pow_fn>(a, e);
+    }
+
+    template <typename T, std::size_t N>
+    [[nodiscard]] VectorArray<T, N> pow(const VectorArray<T, N> &a, T e)
+    {
+        return detail::math_zip<detail::pow_fn>(a, e);
+    }
+
+    // Arrays of vectors, as the batch kernels: n vectors from in to out, which may be the same array
+
+    template <typename V>
+    void exp_many(const V *in, V *out, std::size_t n) noexcept
+    {
+        detail::math_map(detail::scalars(in), detail::scalars(out), n * detail::vector_traits<V>::size,
+                         detail::exp_fn{});
+    }
+
+    template <typename V>
+    void log_many(const V *in, V *out, std::size_t n) noexcept
+    {
+        detail::math_map(detail::scalars(in), detail::scalars(out), n * detail::vector_traits<V>::size,
+                         detail::log_fn{});
+    }
+
+    template <typename V>
+    void sin_many(const V *in, V *out, std::size_t n) noexcept
+    {
+        detail::math_map(detail::scalars(in), detail::scalars(out), n * detail::vector_traits<V>::size,
+                         detail::sin_fn{});
+    }
+
+    template <typename V>
+    void cos_many(const V *in, V *out, std::size_t n) noexcept
+    {
+        detail::math_map(detail::scalars(in), detail::scalars(out), n * detail::vector_traits<V>::size,
+                         detail::cos_fn{});
+    }
+
+    template <typename V>
+    void atan2_many(const V *y, const V *x, V *out, std::size_t n) noexcept
+    {
+        detail::math_zip(detail::scalars(y), detail::scalars(x), detail::scalars(out),
+                         n * detail::vector_traits<V>::size, detail::atan2_fn{});
+    }
+
+    template <typename V>
+    void pow_many(const V *a, const V *e, V *out, std::size_t n) noexcept
+    {
+        detail::math_zip(detail::scalars(a), detail::scalars(e), detail::scalars(out),
+                         n * detail::vector_traits<V>::size, detail::pow_fn{});
+    }
+
+    // The functions on arrays of vectors run at active_simd_level(); doubles need SSE4.1 to vectorize
+    namespace dispatched
+    {
+        template <typename V>
+        void exp_many(const V *in, V *out, std::size_t n) noexcept
+        {
+            detail::dispatch<detail::math_map_kernel<detail::exp_fn>>(detail::scalars(in), detail::scalars(out),
+                                                                      n * detail::vector_traits<V>::size);
+        }
+
+        template <typename V>
+        void log_many(const V *in, V *out, std::size_t n) noexcept
+        {
+            detail::dispatch<detail::math_map_kernel<detail::log_fn>>(detail::scalars(in), detail::scalars(out),
+                                                                      n * detail::vector_traits<V>::size);
+        }
+
+        template <typename V>
+        void sin_many(const V *in, V *out, std::size_t n) noexcept
+        {
+            detail::dispatch<detail::math_map_kernel<detail::sin_fn>>(detail::scalars(in), detail::scalars(out),
+                                                                      n * detail::vector_traits<V>::size);
+        }
+
+        template <typename V>
+        void cos_many(const V *in, V *out, std::size_t n) noexcept
+        {
+            detail::dispatch<detail::math_map_kernel<detail::cos_fn>>(detail::scalars(in), detail::scalars(out),
+                                                                      n * detail::vector_traits<V>::size);
+        }
+
+        template <typename V>
+        void atan2_many(const V *y, const V *x, V *out, std::size_t n) noexcept
+        {
+            detail::dispatch<detail::math_zip_kernel<detail::atan2_fn>>(detail::scalars(y), detail::scalars(x),
+                                                                        detail::scalars(out),
+                                                                        n * detail::vector_traits<V>::size);
+        }
+
+        template <typename V>
+        void pow_many(const V *a, const V *e, V *out, std::size_t n) noexcept
+        {
+            detail::dispatch<detail::math_zip_kernel<detail::pow_fn>>(detail::scalars(a), detail::scalars(e),
+                                                                      detail::scalars(out),
+                                                                      n * detail::vector_traits<V>::size);
+        }
+    } // namespace dispatched
+} // namespace vec
@@ -0,0 +1,1077 @@
+#pragma once
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include "precision.hpp"
+#include "simd.hpp"
+
+namespace vec::detail
+{
+    // Components of a VectorN: an array in general, named x/y/z/w for N = 2, 3, 4
+    template <typename T, std::size_t N>
+    struct vector_storage
+    {
+        T values[N]{};
+    };
+
+    template <typename T>
+    struct vector_storage<T, 2>
+    {
+        T x{};
+        T y{};
+
+        static constexpr T vector_storage::*member(std::size_t i) noexcept
+        {
+            constexpr T vector_storage::*members[]{&vector_storage::x, &vector_storage::y};
+            return members[i];
+        }
+    };
+
+    template <typename T>
+    struct vector_storage<T, 3>
+    {
+        T x{};
+        T y{};
+        T z{};
+
+        static constexpr T vector_storage::*member(std::size_t i) noexcept
+        {
+            constexpr T vector_storage::*members[]{&vector_storage::x, &vector_storage::y, &vector_storage::z};
+            return members[i];
+        }
+    };
+
+    template <typename T>
+    struct vector_storage<T, 4>
+    {
+        T x{};
+        T y{};
+        T z{};
+        T w{};
+
+        static constexpr T vector_storage::*member(std::size_t i) noexcept
+        {
+            constexpr T vector_storage::*members[]{&vector_storage::x, &vector_storage::y, &vector_storage::z,
+                                                   &vector_storage::w};
+            return members[i];
+        }
+    };
+
+    /**
+     * @brief Components x, y, z of a padded VectorN and a fourth lane that is always zero
+     *
+     * All four members are public, like x, y, z, w of Vector4, so the four
+     * lanes are laid out and loaded exactly as Vector4's are (a private
+     * member would cost the storage its standard layout). The padding is
+     * not a component: operator[], size() and the interface stop at z.
+     *
+     * padding is internal and must stay zero: dot(), norm_squared() and ==
+     * reduce all four lanes, so a value written to it would leak into their
+     * results. Debug builds assert this in those reductions.
+     */
+    template <typename T, std::size_t N>
+    struct padded_storage;
+
+    template <typename T>
+    struct padded_storage<T, 3>
+    {
+        T x{};
+        T y{};
+        T z{};
+        T padding{}; // internal, always zero
+
+        static constexpr T padded_storage::*member(std::size_t i) noexcept
+        {
+            constexpr T padded_storage::*members[]{&padded_storage::x, &padded_storage::y, &padded_storage::z};
+            return members[i];
+        }
+    };
+
+    template <typename T, std::size_t N, bool Padded>
+    using storage_t = std::conditional_t<Padded, padded_storage<T, N>, vector_storage<T, N>>;
+
+    /**
+     * @brief a * b - c * d with a single final rounding error
+     *
+     * Kahan's algorithm: the rounding error of c * d is recovered exactly by
+     * an FMA and added back, so the result is within 1.5 ulp even when the
+     * two products nearly cancel.
+     */
+    template <typename T>
+    T difference_of_products(T a, T b, T c, T d) noexcept
+    {
+        const T cd{c * d};
+        const T err{std::fma(-c, d, cd)};
+        return std::fma(a, b, -cd) + err;
+    }
+
+    /**
+     * @brief a raised to a non-negative integer power by repeated squaring
+     *
+     * Wraps around on overflow like unsigned arithmetic. Negative powers are
+     * 1 / a^-exp truncated toward zero: 1 and -1 keep their magnitude, every
+     * other base (0 included) gives 0.
+     */
+    template <typename T>
+    constexpr T integer_pow(T a, T exp) noexcept
+    {
+        if constexpr (std::is_signed_v<T>)
+        {
+            if (exp < 0)
+                return a == 1 || a == -1 ? (exp % 2 == 0 ? T{1} : a) : T{0};
+        }
+        // Unsigned and at least int, so that neither promotion nor overflow is undefined
+        using U = std::make_unsigned_t<std::common_type_t<T, int>>;
+        U r{1};
+        U base{static_cast<U>(a)};
+        for (U e{static_cast<U>(exp)}; e != 0; e >>= 1)
+        {
+            if (e & 1)
+                r *= base;
+            base *= base;
+        }
+        return static_cast<T>(r);
+    }
+
+    // a^E for E >= 0 by squaring, unrolled at compile time: a^3 is (a * a) * a
+    template <int E, typename T>
+    constexpr T unrolled_pow(T a) noexcept
+    {
+        if constexpr (E == 0)
+            return T{1};
+        else if constexpr (E == 1)
+            return a;
+        else
+        {
+            const T half{unrolled_pow<E / 2>(a)};
+            if constexpr (E % 2 == 0)
+                return half * half;
+            else
+                return half * half * a;
+        }
+    }
+
+    /**
+     * @brief a raised to the power E, known at compile time
+     *
+     * Multiplies only. Integers wrap around like integer_pow(); negative E
+     * is 1 / a^-E for floating point and follows integer_pow() for signed
+     * integers.
+     */
+    template <int E, typename T>
+    constexpr T static_pow(T a) noexcept
+    {
+        if constexpr (std::is_integral_v<T>)
+        {
+            static_assert(E >= 0 || std::is_signed_v<T>, "negative powers of unsigned integers");
+            using U = std::make_unsigned_t<std::common_type_t<T, int>>;
+            if constexpr (E < 0)
+                return integer_pow(a, static_cast<T>(E));
+            else
+                return static_cast<T>(unrolled_pow<E>(static_cast<U>(a)));
+        }
+        else if constexpr (E < 0)
+            return T{1} / unrolled_pow<-E>(a);
+        else
+            return unrolled_pow<E>(a);
+    }
+
+    // Component power: repeated squaring for integers, std::pow otherwise
+    template <typename T>
+    constexpr T power(T a, T exp) noexcept
+    {
+        if constexpr (std::is_integral_v<T>)
+            return integer_pow(a, exp);
+        else
+            return static_cast<T>(std::pow(a, exp));
+    }
+
+    // floor(sqrt(a)), exact for every 64-bit value
+    constexpr std::uint64_t integer_sqrt(std::uint64_t a) noexcept
+    {
+        if (!VECTORS_CONSTANT_EVALUATED())
+        {
+            // The double estimate is within one of the result; fix it up
+            std::uint64_t r{static_cast<std::uint64_t>(std::sqrt(static_cast<double>(a)))};
+            r = r < 0xFFFFFFFFu ? r : 0xFFFFFFFFu;
+            while (r * r > a)
+                --r;
+            while (r < 0xFFFFFFFFu && (r + 1) * (r + 1) <= a)
+                ++r;
+            return r;
+        }
+        // One result bit per step
+        std::uint64_t r{0};
+        for (std::uint64_t bit = std::uint64_t{1} << 62; bit != 0; bit >>= 2)
+        {
+            if (a >= r + bit)
+            {
+                a -= r + bit;
+                r = (r >> 1) + bit;
+            }
+            else
+                r >>= 1;
+        }
+        return r;
+    }
+
+    // r = a + b and r = a * b, returning whether the exact result overflows T
+    template <typename T>
+    constexpr bool add_overflow(T a, T b, T &r) noexcept
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_add_overflow(a, b, &r);
+#else
+        constexpr T lo{std::numeric_limits<T>::min()};
+        constexpr T hi{std::numeric_limits<T>::max()};
+        if ((b > 0 && a > hi - b) || (b < 0 && a < lo - b))
+            return true;
+        r = static_cast<T>(a + b);
+        return false;
+#endif
+    }
+
+    template <typename T>
+    constexpr bool mul_overflow(T a, T b, T &r) noexcept
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_mul_overflow(a, b, &r);
+#else
+        constexpr T lo{std::numeric_limits<T>::min()};
+        constexpr T hi{std::numeric_limits<T>::max()};
+        if (a != 0 && b != 0)
+        {
+            if constexpr (std::is_unsigned_v<T>)
+            {
+                if (a > hi / b)
+                    return true;
+            }
+            else if (a > 0 ? (b > 0 ? a > hi / b : b < lo / a) : (b > 0 ? a < lo / b : b < hi / a))
+                return true;
+        }
+        r = static_cast<T>(a * b);
+        return false;
+#endif
+    }
+
+    /**
+     * @brief Whether normalize() of N components of T has an exact integer path
+     *
+     * The squared norm must fit in 64 bits: true for signed 32-bit vectors of
+     * up to four components (the one overflow, four times INT_MIN, wraps to
+     * zero and normalizes to zero as it should) and for narrower integers.
+     */
+    template <typename T, std::size_t N>
+    inline constexpr bool integer_normalize{std::is_integral_v<T> && N <= 4 &&
+                                            (sizeof(T) < 4 || (sizeof(T) == 4 && std::is_signed_v<T>))};
+
+    // Component a of an integer vector divided by its exact norm n; zero when n is
+    template <typename T>
+    constexpr T divide_by_norm(T a, std::uint64_t n) noexcept
+    {
+        if (n == 0)
+            return T{0};
+        if (n <= static_cast<std::uint64_t>(std::numeric_limits<T>::max()))
+            return static_cast<T>(a / static_cast<T>(n));
+        // A norm beyond T, e.g. of (INT_MIN, 0, 0): divide in 64 bits
+        return static_cast<T>(static_cast<std::int64_t>(a) / static_cast<std::int64_t>(n));
+    }
+
+    // Component-wise operations on scalars and, through simd(), on registers of backend S;
+    // keeps_zero when zero operands give +0, so the padding lane of a padded vector stays zero
+    struct plus_op
+    {
+        template <typename U>
+        constexpr auto operator()(U a, U b) const noexcept { return a + b; }
+        template <typename S, typename R>
+        static R simd(R a, R b) noexcept { return S::add(a, b); }
+        static constexpr bool keeps_zero{true};
+    };
+
+    struct minus_op
+    {
+        template <typename U>
+        constexpr auto operator()(U a, U b) const noexcept { return a - b; }
+        template <typename S, typename R>
+        static R simd(R a, R b) noexcept { return S::sub(a, b); }
+        static constexpr bool keeps_zero{true};
+    };
+
+    struct multiplies_op
+    {
+        template <typename U>
+        constexpr auto operator()(U a, U b) const noexcept { return a * b; }
+        template <typename S, typename R>
+        static R simd(R a, R b) noexcept { return S::mul(a, b); }
+        static constexpr bool keeps_zero{true};
+    };
+
+    struct divides_op
+    {
+        template <typename U>
+        constexpr auto operator()(U a, U b) const noexcept { return a / b; }
+        template <typename S, typename R>
+        static R simd(R a, R b) noexcept { return S::div(a, b); }
+        static constexpr bool keeps_zero{false};
+    };
+
+    struct negate_op
+    {
+        template <typename U>
+        constexpr auto operator()(U a) const noexcept { return -a; }
+        template <typename S, typename R>
+        static R simd(R a) noexcept { return S::neg(a); }
+        static constexpr bool keeps_zero{false};
+    };
+
+    // std::min(a, b) and std::max(a, b): a unless b is strictly smaller (larger)
+    struct min_op
+    {
+        template <typename U>
+        constexpr auto operator()(U a, U b) const noexcept { return b < a ? b : a; }
+        template <typename S, typename R>
+        static R simd(R a, R b) noexcept { return S::min(b, a); }
+        static constexpr bool keeps_zero{true};
+    };
+
+    struct max_op
+    {
+        template <typename U>
+        constexpr auto operator()(U a, U b) const noexcept { return a < b ? b : a; }
+        template <typename S, typename R>
+        static R simd(R a, R b) noexcept { return S::max(b, a); }
+        static constexpr bool keeps_zero{true};
+    };
+
+    struct abs_op
+    {
+        // + 0 turns -0 into +0, as clearing the sign bit does
+        template <typename U>
+        constexpr auto operator()(U a) const noexcept { return a < 0 ? -a : a + U(0); }
+        template <typename S, typename R>
+        static R simd(R a) noexcept { return S::abs(a); }
+        static constexpr bool keeps_zero{true};
+    };
+
+    // Whether the named swizzle over components I... exists for a VectorN of N components
+    template <std::size_t N, std::size_t... I>
+    inline constexpr bool swizzle_fits = N >= 2 && N <= 4 && ((I < N) && ...);
+
+    // Whether no component appears twice in I..., i.e. the swizzle can be assigned to
+    template <std::size_t... I>
+    constexpr bool distinct_components() noexcept
+    {
+        constexpr std::size_t indices[]{I...};
+        for (std::size_t i = 0; i < sizeof...(I); ++i)
+            for (std::size_t j = i + 1; j < sizeof...(I); ++j)
+                if (indices[i] == indices[j])
+                    return false;
+        return true;
+    }
+
+    template <typename V, std::size_t... I>
+    class swizzle_ref;
+} // namespace vec::detail
+
+/*
+ * Named swizzle accessors
+ *
+ * VECTORS_SWIZZLE(xzy, 0, 2, 1) declares xzy() for vectors that have the
+ * components 0, 2 and 1. VECTORS_SWIZZLE_1(x, 0) declares every swizzle of
+ * two to four components starting with x, each level appending x, y, z, w.
+ */
+#define VECTORS_SWIZZLE(NAME, ...) \
+    template <std::size_t M = N, std::enable_if_t<vec::detail::swizzle_fits<M, __VA_ARGS__>, int> = 0> \
+    [[nodiscard]] constexpr auto NAME() const noexcept \
+    { \
+        return swizzle<__VA_ARGS__>(); \
+    } \
+    template <std::size_t M = N, std::enable_if_t<vec::detail::swizzle_fits<M, __VA_ARGS__>, int> = 0> \
+    [[nodiscard]] constexpr auto NAME() noexcept \
+    { \
+        return swizzle<__VA_ARGS__>(); \
+    }
+#define VECTORS_SWIZZLE_3(P, ...) \
+    VECTORS_SWIZZLE(P, __VA_ARGS__) \
+    VECTORS_SWIZZLE(P##x, __VA_ARGS__, 0) \
+    VECTORS_SWIZZLE(P##y, __VA_ARGS__, 1) \
+    VECTORS_SWIZZLE(P##z, __VA_ARGS__, 2) \
+    VECTORS_SWIZZLE(P##w, __VA_ARGS__, 3)
+#define VECTORS_SWIZZLE_2(P, ...) \
+    VECTORS_SWIZZLE(P, __VA_ARGS__) \
+    VECTORS_SWIZZLE_3(P##x, __VA_ARGS__, 0) \
+    VECTORS_SWIZZLE_3(P##y, __VA_ARGS__, 1) \
+    VECTORS_SWIZZLE_3(P##z, __VA_ARGS__, 2) \
+    VECTORS_SWIZZLE_3(P##w, __VA_ARGS__, 3)
+#define VECTORS_SWIZZLE_1(P, I) \
+    VECTORS_SWIZZLE_2(P##x, I, 0) \
+    VECTORS_SWIZZLE_2(P##y, I, 1) \
+    VECTORS_SWIZZLE_2(P##z, I, 2) \
+    VECTORS_SWIZZLE_2(P##w, I, 3)
+
+/**
+ * @brief Fixed-size vector of N components
+ *
+ * Common implementation of Vector2, Vector3 and Vector4, also usable for any
+ * other size (e.g. VectorN<float, 8> feature vectors). Components are named
+ * x, y, z, w for N = 2, 3, 4; every size supports operator[].
+ *
+ * Operations are unrolled over the components at compile time. Outside of
+ * constant evaluation, float, double and 32-bit integer vectors of four or
+ * more components run four lanes at a time on the SIMD backend (see
+ * simd.hpp); sizes that are a multiple of four are aligned to the register
+ * width. Horizontal sums
+ * are reduced pairwise, so SIMD results may differ from the scalar order in
+ * the last bit.
+ *
+ * Padded vectors (Vector3A) store three components and a zero fourth lane
+ * in padded_storage and are aligned like four components, so every
+ * operation runs on whole registers. Operations that would not leave the
+ * lane zero (0 / 0, -0) clear it again.
+ */
+template <typename T, std::size_t N, bool Padded = false>
+class alignas(vec::detail::simd_alignment<T, Padded ? 4 : N>) VectorN
+    : public vec::detail::storage_t<T, N, Padded>
+{
+    static_assert(N > 0, "VectorN needs at least one component");
+    static_assert(!Padded || N == 3, "only three-component vectors are padded");
+
+    using storage = vec::detail::storage_t<T, N, Padded>;
+    using simd = vec::detail::simd4<T>;
+    using indices = std::make_index_sequence<N>;
+
+    static constexpr bool named_components{N >= 2 && N <= 4};
+
+    // Leading lanes processed four at a time on the SIMD backend (all four of a padded vector)
+    static constexpr std::size_t simd_size{simd::enabled ? (Padded ? 4 : N) / 4 * 4 : 0};
+
+public:
+    using value_type = T;
+
+    // Constructors
+    explicit constexpr VectorN() noexcept = default;
+    template <typename... Args,
+              std::enable_if_t<sizeof...(Args) == N && (std::is_convertible_v<Args, T> && ...), int> = 0>
+    explicit constexpr VectorN(Args... args) noexcept : storage{static_cast<T>(args)...} {}
+    VectorN(const VectorN &other) noexcept = default;
+    VectorN(VectorN &&) noexcept = default;
+
+    // Assignment
+    constexpr VectorN &operator=(const VectorN &other) noexcept = default;
+
+    // A padded vector converts implicitly from and to the packed vector of its components
+    template <bool P = Padded, std::enable_if_t<P, int> = 0>
+    constexpr VectorN(const VectorN<T, N> &v) noexcept : storage{v.x, v.y, v.z}
+    {
+    }
+    template <bool P = Padded, std::enable_if_t<P, int> = 0>
+    constexpr operator VectorN<T, N>() const noexcept
+    {
+        return VectorN<T, N>(this->x, this->y, this->z);
+    }
+
+    // Component access
+    [[nodiscard]] constexpr T &operator[](std::size_t i) noexcept
+    {
+        if constexpr (named_components)
+            return this->*storage::member(i);
+        else
+            return this->values[i];
+    }
+    [[nodiscard]] constexpr const T &operator[](std::size_t i) const noexcept
+    {
+        if constexpr (named_components)
+            return this->*storage::member(i);
+        else
+            return this->values[i];
+    }
+
+    [[nodiscard]] T *data() noexcept { return &(*this)[0]; }
+    [[nodiscard]] const T *data() const noexcept { return &(*this)[0]; }
+
+    [[nodiscard]] static constexpr std::size_t size() noexcept { return N; }
+
+    // Comparison
+    constexpr bool operator==(const VectorN &other) const noexcept
+    {
+        if constexpr (simd_size > 0)
+        {
+            if (!VECTORS_CONSTANT_EVALUATED())
+            {
+                assert(padding_is_zero() && other.padding_is_zero());
+                for (std::size_t i = 0; i < simd_size; i += 4)
+                    if (!simd::equal(load(i), other.load(i)))
+                        return false;
+                for (std::size_t i = simd_size; i < N; ++i)
+                    if ((*this)[i] != other[i])
+                        return false;
+                return true;
+            }
+        }
+        return equal(other, indices{});
+    }
+
+    // Unary
+    constexpr VectorN operator+() const noexcept { return *this; }
+    constexpr VectorN operator-() const noexcept
+    {
+        return map(vec::detail::negate_op{});
+    }
+
+    // Vector - Vector operations
+    constexpr VectorN operator+(const VectorN &o) const noexcept
+    {
+        return zip(o, vec::detail::plus_op{});
+    }
+    constexpr VectorN operator-(const VectorN &o) const noexcept
+    {
+        return zip(o, vec::detail::minus_op{});
+    }
+    constexpr VectorN operator*(const VectorN &o) const noexcept
+    {
+        return zip(o, vec::detail::multiplies_op{});
+    }
+    constexpr VectorN operator/(const VectorN &o) const noexcept
+    {
+        return zip(o, vec::detail::divides_op{});
+    }
+
+    // Vector - Scalar operations
+    constexpr VectorN operator+(T s) const noexcept { return zip(s, vec::detail::plus_op{}); }
+    constexpr VectorN operator-(T s) const noexcept { return zip(s, vec::detail::minus_op{}); }
+    constexpr VectorN operator*(T s) const noexcept { return zip(s, vec::detail::multiplies_op{}); }
+    constexpr VectorN operator/(T s) const noexcept
+    {
+        // Integers divide lane by lane, which the compiler strength-reduces for a constant s
+        if constexpr (std::is_integral_v<T>)
+            return map([s](T a) { return static_cast<T>(a / s); }, indices{});
+        else
+            return zip(s, vec::detail::divides_op{});
+    }
+
+    // Compound assignment
+    constexpr VectorN &operator+=(const VectorN &o) noexcept { return *this = *this + o; }
+    constexpr VectorN &operator-=(const VectorN &o) noexcept { return *this = *this - o; }
+    constexpr VectorN &operator*=(const VectorN &o) noexcept { return *this = *this * o; }
+    constexpr VectorN &operator/=(const VectorN &o) noexcept { return *this = *this / o; }
+
+    constexpr VectorN &operator+=(T s) noexcept { return *this = *this + s; }
+    constexpr VectorN &operator-=(T s) noexcept { return *this = *this - s; }
+    constexpr VectorN &operator*=(T s) noexcept { return *this = *this * s; }
+    constexpr VectorN &operator/=(T s) noexcept { return *this = *this / s; }
+
+    // Dot product
+    [[nodiscard]] constexpr T dot(const VectorN &o) const noexcept
+    {
+        // Integer loops of dot products vectorize better across vectors than within one
+        if constexpr (simd_size > 0 && std::is_floating_point_v<T>)
+        {
+            if (!VECTORS_CONSTANT_EVALUATED())
+            {
+                assert(padding_is_zero() && o.padding_is_zero());
+                auto sums{simd::mul(load(0), o.load(0))};
+                for (std::size_t i = 4; i < simd_size; i += 4)
+                    sums = simd::add(sums, simd::mul(load(i), o.load(i)));
+                T r{simd::hsum(sums)};
+                for (std::size_t i = simd_size; i < N; ++i)
+                    r += (*this)[i] * o[i];
+                return r;
+            }
+        }
+        return dot(o, indices{});
+    }
+
+    // Dot product of integer vectors in vec::wide_t<T>, exact where dot() would overflow
+    [[nodiscard]] constexpr vec::wide_t<T> dot_wide(const VectorN &o) const noexcept
+    {
+        static_assert(std::is_integral_v<T>, "dot_wide requires an integer vector");
+        return dot_wide(o, indices{});
+    }
+
+    /**
+     * @brief Dot product of integer vectors, or std::nullopt if it overflows
+     *
+     * Products and partial sums are taken in vec::wide_t<T> with overflow
+     * checks; the result must then fit in T.
+     */
+    [[nodiscard]] constexpr std::optional<T> dot_checked(const VectorN &o) const noexcept
+    {
+        static_assert(std::is_integral_v<T>, "dot_checked requires an integer vector");
+        using W = vec::wide_t<T>;
+        W r{0};
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            W p{0};
+            if (vec::detail::mul_overflow(static_cast<W>((*this)[i]), static_cast<W>(o[i]), p) ||
+                vec::detail::add_overflow(r, p, r))
+                return std::nullopt;
+        }
+        if (r < static_cast<W>(std::numeric_limits<T>::min()) || r > static_cast<W>(std::numeric_limits<T>::max()))
+            return std::nullopt;
+        return static_cast<T>(r);
+    }
+
+    // Cross product
+    template <std::size_t M = N, std::enable_if_t<M == 3, int> = 0>
+    [[nodiscard]] constexpr VectorN cross(const VectorN &o) const noexcept
+    {
+        return VectorN(
+            this->y * o.z - this->z * o.y,
+            this->z * o.x - this->x * o.z,
+            this->x * o.y - this->y * o.x);
+    }
+
+    // Dot product accumulated with fused multiply-adds (one rounding per component)
+    [[nodiscard]] T dot_fma(const VectorN &o) const noexcept
+    {
+        static_assert(std::is_floating_point_v<T>, "dot_fma requires a floating-point vector");
+        T r{(*this)[0] * o[0]};
+        for (std::size_t i = 1; i < N; ++i)
+            r = std::fma((*this)[i], o[i], r);
+        return r;
+    }
+
+    // Cross product with each component within 1.5 ulp, even under cancellation
+    template <std::size_t M = N, std::enable_if_t<M == 3, int> = 0>
+    [[nodiscard]] VectorN cross_fma(const VectorN &o) const noexcept
+    {
+        static_assert(std::is_floating_point_v<T>, "cross_fma requires a floating-point vector");
+        using vec::detail::difference_of_products;
+        return VectorN(
+            difference_of_products(this->y, o.z, this->z, o.y),
+            difference_of_products(this->z, o.x, this->x, o.z),
+            difference_of_products(this->x, o.y, this->y, o.x));
+    }
+
+    // Norm (length), computed in P (float for float vectors, double otherwise)
+    template <typename P = vec::norm_precision_t<T>>
+    [[nodiscard]] constexpr P norm() const noexcept
+    {
+        return std::sqrt(norm_squared<P>());
+    }
+
+    template <typename P = vec::norm_precision_t<T>>
+    [[nodiscard]] constexpr P length() const noexcept
+    {
+        return norm<P>();
+    }
+
+    template <typename P = vec::norm_precision_t<T>>
+    [[nodiscard]] constexpr P norm_squared() const noexcept
+    {
+        if constexpr (simd_size > 0 && std::is_same_v<P, T>)
+        {
+            if (!VECTORS_CONSTANT_EVALUATED())
+                return dot(*this);
+        }
+        else if constexpr (simd_size > 0 && std::is_same_v<T, float> && std::is_same_v<P, double>)
+        {
+            if (!VECTORS_CONSTANT_EVALUATED())
+            {
+                assert(padding_is_zero());
+                P r{simd::norm_squared_double(load(0))};
+                for (std::size_t i = 4; i < simd_size; i += 4)
+                    r += simd::norm_squared_double(load(i));
+                for (std::size_t i = simd_size; i < N; ++i)
+                    r += static_cast<P>((*this)[i]) * (*this)[i];
+                return r;
+            }
+        }
+        return norm_squared<P>(indices{});
+    }
+
+    template <typename P = vec::norm_precision_t<T>>
+    [[nodiscard]] constexpr P normSquared() const noexcept
+    {
+        return norm_squared<P>();
+    }
+
+    // Squared norm accumulated with fused multiply-adds
+    [[nodiscard]] T norm_squared_fma() const noexcept
+    {
+        static_assert(std::is_floating_point_v<T>, "norm_squared_fma requires a floating-point vector");
+        return dot_fma(*this);
+    }
+
+    // Squared norm of an integer vector in vec::wide_norm_t<T>, exact for Vector2i, Vector3i and Vector4i
+    [[nodiscard]] constexpr vec::wide_norm_t<T> norm_squared_wide() const noexcept
+    {
+        static_assert(std::is_integral_v<T>, "norm_squared_wide requires an integer vector");
+        return norm_squared<vec::wide_norm_t<T>>(indices{});
+    }
+
+    /**
+     * @brief Normalized vector
+     *
+     * Integer vectors are divided by their norm rounded down. For Vector2i,
+     * Vector3i and Vector4i that norm is the exact integer square root of
+     * the squared norm taken in 64 bits, so large components lose nothing
+     * to double rounding.
+     */
+    template <typename P = vec::norm_precision_t<T>>
+    [[nodiscard]] constexpr VectorN normalize() const noexcept
+    {
+        if constexpr (vec::detail::integer_normalize<T, N>)
+        {
+            const std::uint64_t n{vec::detail::integer_sqrt(norm_squared<std::uint64_t>(indices{}))};
+            return map([n](T a) { return vec::detail::divide_by_norm(a, n); }, indices{});
+        }
+        else
+        {
+            const P n{this->template norm<P>()};
+            return n != 0 ? *this / static_cast<T>(n) : *this;
+        }
+    }
+
+    // Approximate reciprocal norm (relative error below 1e-6, see vec::detail::rsqrt_approx)
+    [[nodiscard]] T inv_norm_fast() const noexcept
+    {
+        static_assert(std::is_floating_point_v<T>, "inv_norm_fast requires a floating-point vector");
+        return vec::detail::rsqrt_approx(norm_squared<T>());
+    }
+
+    // Approximate normalized vector, one reciprocal square root and N multiplies
+    [[nodiscard]] VectorN normalize_fast() const noexcept
+    {
+        static_assert(std::is_floating_point_v<T>, "normalize_fast requires a floating-point vector");
+        const T n2{norm_squared<T>()};
+        return n2 != 0 ? *this * vec::detail::rsqrt_approx(n2) : *this;
+    }
+
+    // Component-wise minimum and maximum, as std::min / std::max of each pair
+    [[nodiscard]] constexpr VectorN min(const VectorN &o) const noexcept
+    {
+        return zip(o, vec::detail::min_op{});
+    }
+    [[nodiscard]] constexpr VectorN max(const VectorN &o) const noexcept
+    {
+        return zip(o, vec::detail::max_op{});
+    }
+
+    // Components limited to [lo, hi], as std::clamp of each component (lo <= hi)
+    [[nodiscard]] constexpr VectorN clamp(const VectorN &lo, const VectorN &hi) const noexcept
+    {
+        return max(lo).min(hi);
+    }
+    [[nodiscard]] constexpr VectorN clamp(T lo, T hi) const noexcept
+    {
+        return clamp(splat(lo, indices{}), splat(hi, indices{}));
+    }
+
+    // Absolute value of components
+    [[nodiscard]] constexpr VectorN abs() const noexcept
+    {
+        return map(vec::detail::abs_op{});
+    }
+
+    // Components rounded down / up to integral values
+    [[nodiscard]] VectorN floor() const noexcept
+    {
+        return map([](T a) { return static_cast<T>(std::floor(a)); }, indices{});
+    }
+    [[nodiscard]] VectorN ceil() const noexcept
+    {
+        return map([](T a) { return static_cast<T>(std::ceil(a)); }, indices{});
+    }
+
+    // Linear interpolation: *this at t = 0, o at t = 1
+    [[nodiscard]] constexpr VectorN lerp(const VectorN &o, T t) const noexcept
+    {
+        return *this + (o - *this) * t;
+    }
+
+    // Sign of components
+    [[nodiscard]] constexpr VectorN sign() const noexcept
+    {
+        return map([](T a) { return a >= 0 ? static_cast<T>(1) : static_cast<T>(-1); }, indices{});
+    }
+
+    // Power (component-wise); integers by repeated squaring, see vec::detail::integer_pow
+    [[nodiscard]] constexpr VectorN pow(T exp) const noexcept
+    {
+        return map([exp](T a) { return vec::detail::power(a, exp); }, indices{});
+    }
+
+    // Power with an exponent known at compile time, e.g. v.pow<2>(): multiplies instead of std::pow
+    template <int E>
+    [[nodiscard]] constexpr VectorN pow() const noexcept
+    {
+        return map([](T a) { return vec::detail::static_pow<E>(a); }, indices{});
+    }
+
+    /**
+     * @brief Components I... as a new vector, e.g. swizzle<2, 1, 0>() is (z, y, x)
+     *
+     * Four-component swizzles of float and double Vector4 compile to a single
+     * register shuffle outside of constant evaluation. On a non-const vector
+     * a swizzle without repeated components returns a writable
+     * vec::detail::swizzle_ref instead, so v.swizzle<0, 1>() = ... assigns.
+     */
+    template <std::size_t... I>
+    [[nodiscard]] constexpr VectorN<T, sizeof...(I)> swizzle() const noexcept
+    {
+        static_assert(sizeof...(I) > 0 && ((I < N) && ...), "swizzle component out of range");
+        if constexpr (N == 4 && sizeof...(I) == 4 && simd::enabled)
+        {
+            if (!VECTORS_CONSTANT_EVALUATED())
+            {
+                VectorN r;
+                simd::store(r.data(), simd::template shuffle<static_cast<int>(I)...>(load(0)));
+                return r;
+            }
+        }
+        return VectorN<T, sizeof...(I)>((*this)[I]...);
+    }
+
+    template <std::size_t... I>
+    [[nodiscard]] constexpr auto swizzle() noexcept
+    {
+        if constexpr (vec::detail::distinct_components<I...>())
+            return vec::detail::swizzle_ref<VectorN, I...>(*this);
+        else
+            return std::as_const(*this).template swizzle<I...>();
+    }
+
+    // Named swizzles of Vector2/3/4: v.xy(), v.zyx(), v.xxyy(), ... (writable as above)
+    VECTORS_SWIZZLE_1(x, 0)
+    VECTORS_SWIZZLE_1(y, 1)
+    VECTORS_SWIZZLE_1(z, 2)
+    VECTORS_SWIZZLE_1(w, 3)
+
+    // Stream output, e.g. "Vector3(x=1, y=2, z=3)", "Vector3A(x=1, y=2, z=3)" or "Vector8(1, 2, ...)"
+    friend std::ostream &operator<<(std::ostream &os, const VectorN &v) noexcept
+    {
+        os << "Vector" << N << (Padded ? "A(" : "(");
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            if (i > 0)
+                os << ", ";
+            if constexpr (named_components)
+                os << "xyzw"[i] << "=";
+            os << v[i];
+        }
+        os << ")";
+        return os;
+    }
+
+    // Conversion to a vector of another scalar type
+    template <typename K>
+    explicit constexpr operator VectorN<K, N, Padded>() const noexcept
+    {
+        return convert<K>(indices{});
+    }
+
+private:
+    // Register view of the four components starting at i
+    typename simd::reg load(std::size_t i) const noexcept { return simd::load(data() + i); }
+
+    // The invariant the four-lane reductions of a padded vector rely on
+    bool padding_is_zero() const noexcept
+    {
+        if constexpr (Padded)
+            return this->padding == T{};
+        else
+            return true;
+    }
+
+    // r with the padding lane cleared again if Op does not keep zeros zero, or took a broadcast scalar
+    template <typename Op, bool Broadcast = false>
+    static typename simd::reg keep_padding(typename simd::reg r) noexcept
+    {
+        if constexpr (Padded && (Broadcast || !Op::keeps_zero))
+            return simd::zero_w(r);
+        else
+            return r;
+    }
+
+    // Op (see vec::detail::plus_op) applied to each component
+    template <typename Op>
+    constexpr VectorN map(Op op) const noexcept
+    {
+        if constexpr (simd_size > 0)
+        {
+            if (!VECTORS_CONSTANT_EVALUATED())
+            {
+                VectorN r;
+                for (std::size_t i = 0; i < simd_size; i += 4)
+                    simd::store(r.data() + i, keep_padding<Op>(Op::template simd<simd>(load(i))));
+                for (std::size_t i = simd_size; i < N; ++i)
+                    r[i] = op((*this)[i]);
+                return r;
+            }
+        }
+        return map(op, indices{});
+    }
+
+    template <typename F, std::size_t... I>
+    constexpr VectorN map(F f, std::index_sequence<I...>) const noexcept
+    {
+        return VectorN(f((*this)[I])...);
+    }
+
+    // Op applied to each pair of components
+    template <typename Op>
+    constexpr VectorN zip(const VectorN &o, Op op) const noexcept
+    {
+        if constexpr (simd_size > 0)
+        {
+            if (!VECTORS_CONSTANT_EVALUATED())
+            {
+                VectorN r;
+                for (std::size_t i = 0; i < simd_size; i += 4)
+                    simd::store(r.data() + i, keep_padding<Op>(Op::template simd<simd>(load(i), o.load(i))));
+                for (std::size_t i = simd_size; i < N; ++i)
+                    r[i] = op((*this)[i], o[i]);
+                return r;
+            }
+        }
+        return zip(o, op, indices{});
+    }
+
+    template <typename F, std::size_t... I>
+    constexpr VectorN zip(const VectorN &o, F f, std::index_sequence<I...>) const noexcept
+    {
+        return VectorN(f((*this)[I], o[I])...);
+    }
+
+    // Op applied to each component and s, broadcast to a register on the SIMD backend
+    template <typename Op>
+    constexpr VectorN zip(T s, Op op) const noexcept
+    {
+        if constexpr (simd_size > 0)
+        {
+            if (!VECTORS_CONSTANT_EVALUATED())
+            {
+                const auto b{simd::set1(s)};
+                VectorN r;
+                for (std::size_t i = 0; i < simd_size; i += 4)
+                    simd::store(r.data() + i, keep_padding<Op, true>(Op::template simd<simd>(load(i), b)));
+                for (std::size_t i = simd_size; i < N; ++i)
+                    r[i] = op((*this)[i], s);
+                return r;
+            }
+        }
+        return zip(splat(s, indices{}), op, indices{});
+    }
+
+    template <std::size_t... I>
+    static constexpr VectorN splat(T s, std::index_sequence<I...>) noexcept
+    {
+        return VectorN(((void)I, s)...);
+    }
+
+    template <std::size_t... I>
+    constexpr bool equal(const VectorN &o, std::index_sequence<I...>) const noexcept
+    {
+        return (... && ((*this)[I] == o[I]));
+    }
+
+    // Sums in component order: ((x * o.x + y * o.y) + z * o.z) + ...
+    template <std::size_t... I>
+    constexpr T dot(const VectorN &o, std::index_sequence<I...>) const noexcept
+    {
+        return (... + ((*this)[I] * o[I]));
+    }
+
+    template <typename P, std::size_t... I>
+    constexpr P norm_squared(std::index_sequence<I...>) const noexcept
+    {
+        return (... + (static_cast<P>((*this)[I]) * (*this)[I]));
+    }
+
+    template <std::size_t... I>
+    constexpr vec::wide_t<T> dot_wide(const VectorN &o, std::index_sequence<I...>) const noexcept
+    {
+        return (... + (static_cast<vec::wide_t<T>>((*this)[I]) * o[I]));
+    }
+
+    template <typename K, std::size_t... I>
+    constexpr VectorN<K, N, Padded> convert(std::index_sequence<I...>) const noexcept
+    {
+        return VectorN<K, N, Padded>((*this)[I]...);
+    }
+};
+
+#undef VECTORS_SWIZZLE_1
+#undef VECTORS_SWIZZLE_2
+#undef VECTORS_SWIZZLE_3
+#undef VECTORS_SWIZZLE
+
+// Scalar * vector
+template <typename T, std::size_t N, bool Padded>
+constexpr VectorN<T, N, Padded> operator*(T s, const VectorN<T, N, Padded> &v) noexcept
+{
+    return v * s;
+}
+
+namespace vec::detail
+{
+    /**
+     * @brief Writable swizzle, returned by v.xy() etc. on a non-const vector
+     *
+     * Assignment writes the components back (v.zx() = Vector2f(1, 2) sets z
+     * to 1 and x to 2); reading converts to a VectorN<T, sizeof...(I)>. The
+     * proxy refers to v: convert it (or swizzle a const vector) to keep a copy.
+     */
+    template <typename V, std::size_t... I>
+    class swizzle_ref
+    {
+        using T = typename V::value_type;
+
+    public:
+        using vector_type = VectorN<T, sizeof...(I)>;
+
+        explicit constexpr swizzle_ref(V &v) noexcept : v_(v) {}
+        constexpr swizzle_ref(const swizzle_ref &) noexcept = default;
+
+        // o is a copy, so overlapping assignments such as v.xy() = v.yx() are safe
+        constexpr swizzle_ref &operator=(vector_type o) noexcept
+        {
+            assign(o, std::make_index_sequence<sizeof...(I)>{});
+            return *this;
+        }
+        constexpr swizzle_ref &operator=(const swizzle_ref &o) noexcept { return *this = o.value(); }
+
+        [[nodiscard]] constexpr vector_type value() const noexcept { return std::as_const(v_).template swizzle<I...>(); }
+        constexpr operator vector_type() const noexcept { return value(); }
+
+        // Compound assignment
+        constexpr swizzle_ref &operator+=(const vector_type &o) noexcept { return *this = value() + o; }
+        constexpr swizzle_ref &operator-=(const vector_type &o) noexcept { return *this = value() - o; }
+        constexpr swizzle_ref &operator*=(const vector_type &o) noexcept { return *this = value() * o; }
+        constexpr swizzle_ref &operator/=(const vector_type &o) noexcept { return *this = value() / o; }
+
+        constexpr swizzle_ref &operator+=(T s) noexcept { return *this = value() + s; }
+        constexpr swizzle_ref &operator-=(T s) noexcept { return *this = value() - s; }
+        constexpr swizzle_ref &operator*=(T s) noexcept { return *this = value() * s; }
+        constexpr swizzle_ref &operator/=(T s) noexcept { return *this = value() / s; }
+
+        // Operators with the proxy on the left (on the right it converts to vector_type)
+        friend constexpr bool operator==(const swizzle_ref &a, const vector_type &b) noexcept { return a.value() == b; }
+        friend constexpr vector_type operator+(const swizzle_ref &a, const vector_type &b) noexcept { return a.value() + b; }
+        friend constexpr vector_type operator-(const swizzle_ref &a, const vector_type &b) noexcept { return a.value() - b; }
+        friend constexpr vector_type operator*(const swizzle_ref &a, const vector_type &b) noexcept { return a.value() * b; }
+        friend constexpr vector_type operator/(const swizzle_ref &a, const vector_type &b) noexcept { return a.value() / b; }
+        friend constexpr vector_type operator+(const swizzle_ref &a, T s) noexcept { return a.value() + s; }
+        friend constexpr vector_type operator-(const swizzle_ref &a, T s) noexcept { return a.value() - s; }
+        friend constexpr vector_type operator*(const swizzle_ref &a, T s) noexcept { return a.value() * s; }
+        friend constexpr vector_type operator/(const swizzle_ref &a, T s) noexcept { return a.value() / s; }
+
+    private:
+        template <std::size_t... J>
+        constexpr void assign(const vector_type &o, std::index_sequence<J...>) noexcept
+        {
+            ((v_[I] = o[J]), ...);
+        }
+
+        V &v_;
+    };
+} // namespace vec::detail
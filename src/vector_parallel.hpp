@@ -0,0 +1,194 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "aabb.hpp"
+#include "thread_pool.hpp"
+#include "vector_kernels.hpp"
+#include "vector_random.hpp"
+#include "vector_traits.hpp"
+
+/*
+ * Parallel bulk operations over arrays of vectors
+ *
+ * Arrays are split into contiguous chunks run on a ThreadPool (the global
+ * pool unless one is passed). Small arrays form a single chunk and run on the
+ * calling thread.
+ *
+ * Element-wise operations (transform, normalize, generate) and bounds give
+ * the same results as their serial counterparts. Sums are formed per chunk
+ * and the partial sums are then added in chunk order; the chunk boundaries
+ * depend on the reduction mode:
+ *
+ *     reduction::fast           a few chunks per thread: reproducible from
+ *                               run to run on the same pool size
+ *     reduction::deterministic  fixed-size chunks: bit-identical results for
+ *                               any pool size, at the cost of more partials
+ */
+namespace vec
+{
+    enum class reduction
+    {
+        fast,
+        deterministic
+    };
+
+    namespace detail
+    {
+        // Smallest chunk worth handing to another thread
+        inline constexpr std::size_t parallel_grain{16 * kernel_block};
+
+        // Chunk size of reduction::deterministic
+        inline constexpr std::size_t deterministic_chunk{64 * kernel_block};
+
+        // Chunks per participant in fast mode, so that stealing can balance the load
+        inline constexpr std::size_t chunks_per_thread{4};
+
+        // Elements per chunk, a multiple of kernel_block
+        inline std::size_t chunk_size(std::size_t n, reduction mode, const ThreadPool &pool) noexcept
+        {
+            if (mode == reduction::deterministic)
+                return deterministic_chunk;
+            const std::size_t chunks{pool.size() * chunks_per_thread};
+            const std::size_t size{std::max(parallel_grain, (n + chunks - 1) / chunks)};
+            return (size + kernel_block - 1) / kernel_block * kernel_block;
+        }
+
+        // f(begin, end) over consecutive chunks of [0, n)
+        template <typename F>
+        void parallel_ranges(std::size_t n, std::size_t chunk, ThreadPool &pool, F f)
+        {
+            pool.parallel_for((n + chunk - 1) / chunk, [&](std::size_t c)
+                              { f(c * chunk, std::min(n, (c + 1) * chunk)); });
+        }
+
+        // f(begin, end) per chunk, partial results combined in chunk order
+        template <typename R, typename F, typename Combine>
+        R parallel_reduce(std::size_t n, std::size_t chunk, ThreadPool &pool, F f, Combine combine)
+        {
+            const std::size_t chunks{(n + chunk - 1) / chunk};
+            std::vector<R> partial(chunks);
+            pool.parallel_for(chunks, [&](std::size_t c)
+                              { partial[c] = f(c * chunk, std::min(n, (c + 1) * chunk)); });
+            R r{partial[0]};
+            for (std::size_t c = 1; c < chunks; ++c)
+                r = combine(r, partial[c]);
+            return r;
+        }
+
+        // Sum of in[begin, end) accumulated in vector type A
+        template <typename A, typename V>
+        A serial_sum(const V *in, std::size_t begin, std::size_t end) noexcept
+        {
+            A s{};
+            for (std::size_t i = begin; i < end; ++i)
+                s += static_cast<A>(in[i]);
+            return s;
+        }
+
+        // Scalar type of centroids: the vector's own for floating-point vectors, double otherwise
+        template <typename V>
+        using centroid_scalar_t = std::conditional_t<std::is_floating_point_v<scalar_t<V>>, scalar_t<V>, double>;
+    } // namespace detail
+
+    // Centroid of an array of V
+    template <typename V>
+    using centroid_t = detail::vector_of_t<detail::centroid_scalar_t<V>, detail::vector_traits<V>::size>;
+
+    // out[i] = f(in[i]); f is called concurrently and must not throw
+    template <typename V, typename U, typename F>
+    void parallel_transform(const V *in, U *out, std::size_t n, F f, ThreadPool &pool = ThreadPool::global())
+    {
+        detail::parallel_ranges(n, detail::chunk_size(n, reduction::fast, pool), pool,
+                                [&](std::size_t begin, std::size_t end)
+                                {
+                                    for (std::size_t i = begin; i < end; ++i)
+                                        out[i] = f(in[i]);
+                                });
+    }
+
+    // vec::normalize() split across the pool; in and out may be the same array
+    template <typename V>
+    void parallel_normalize(const V *in, V *out, std::size_t n, ThreadPool &pool = ThreadPool::global())
+    {
+        detail::parallel_ranges(n, detail::chunk_size(n, reduction::fast, pool), pool,
+                                [&](std::size_t begin, std::size_t end)
+                                { normalize(in + begin, out + begin, end - begin); });
+    }
+
+    /**
+     * @brief vec::generate() split across the pool
+     *
+     * Chunks start on multiples of kernel_block, each from a copy of rng
+     * advanced to its first vector, so the output is the same as one
+     * generate() call on any pool size. rng ends where generate() leaves it.
+     */
+    template <typename D>
+    void parallel_generate(Philox4x32 &rng, const D &dist, typename D::result_type *out, std::size_t n,
+                           ThreadPool &pool = ThreadPool::global())
+    {
+        const Philox4x32 start{rng};
+        detail::parallel_ranges(n, detail::chunk_size(n, reduction::fast, pool), pool,
+                                [&](std::size_t begin, std::size_t end)
+                                {
+                                    Philox4x32 chunk{start};
+                                    chunk.discard(begin * D::words);
+                                    generate(chunk, dist, out + begin, end - begin);
+                                });
+        rng.discard(n * D::words);
+    }
+
+    // Sum of n vectors, accumulated in V
+    template <typename V>
+    V parallel_sum(const V *in, std::size_t n, reduction mode = reduction::fast,
+                   ThreadPool &pool = ThreadPool::global())
+    {
+        if (n == 0)
+            return V();
+        return detail::parallel_reduce<V>(
+            n, detail::chunk_size(n, mode, pool), pool,
+            [in](std::size_t begin, std::size_t end) { return detail::serial_sum<V>(in, begin, end); },
+            [](const V &a, const V &b) { return a + b; });
+    }
+
+    /**
+     * @brief Mean of n > 0 vectors
+     *
+     * Accumulated in double precision (long double for long double vectors),
+     * so large float arrays do not lose their low-order contributions. Integer
+     * vectors have a double-precision centroid.
+     */
+    template <typename V>
+    centroid_t<V> parallel_centroid(const V *in, std::size_t n, reduction mode = reduction::fast,
+                                    ThreadPool &pool = ThreadPool::global())
+    {
+        assert(n > 0);
+        using A = detail::vector_of_t<std::common_type_t<detail::scalar_t<V>, double>, detail::vector_traits<V>::size>;
+        const A sum{detail::parallel_reduce<A>(
+            n, detail::chunk_size(n, mode, pool), pool,
+            [in](std::size_t begin, std::size_t end) { return detail::serial_sum<A>(in, begin, end); },
+            [](const A &a, const A &b) { return a + b; })};
+        return static_cast<centroid_t<V>>(sum / static_cast<detail::scalar_t<A>>(n));
+    }
+
+    // Component-wise minimum and maximum of n > 0 vectors
+    template <typename V>
+    std::pair<V, V> parallel_bounds(const V *in, std::size_t n, ThreadPool &pool = ThreadPool::global())
+    {
+        assert(n > 0);
+        using bounds = std::pair<V, V>;
+        return detail::parallel_reduce<bounds>(
+            n, detail::chunk_size(n, reduction::fast, pool), pool,
+            [in](std::size_t begin, std::size_t end)
+            {
+                const AABB<V> b{bounds_of(in + begin, end - begin)};
+                return bounds{b.min(), b.max()};
+            },
+            [](const bounds &a, const bounds &b) { return bounds{a.first.min(b.first), a.second.max(b.second)}; });
+    }
+} // namespace vec
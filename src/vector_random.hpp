@@ -0,0 +1,506 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#include "simd.hpp"
+#include "vector_array.hpp"
+#include "vector_dispatch.hpp"
+#include "vector_kernels.hpp"
+#include "vector_math.hpp"
+
+/*
+ * Random vectors
+ *
+ * Philox4x32 is the counter-based generator of Salmon et al. (Random123,
+ * ten rounds): word i of a stream is a pure function of (seed, stream, i),
+ * so generating a block of words is a loop of independent iterations the
+ * compiler vectorizes, jumping ahead is free, and different streams never
+ * overlap. It is a UniformRandomBitGenerator, so it also drives the std::
+ * distributions.
+ *
+ * The distributions fill arrays of Vector2/3/4<float/double> a block of
+ * kernel_block vectors at a time: the block's words come from one fill(),
+ * then each component is computed with contiguous loops (sin and cos from
+ * vector_math.hpp) and interleaved into the output.
+ *
+ *     UniformBox<V>        uniform in the box [lo, hi), or the cube [lo, hi)^N
+ *     OnUnitSphere<V>      uniform on the unit circle (2D) or sphere (3D)
+ *     InUnitBall<V>        uniform in the unit disk (2D) or ball (3D)
+ *     CosineHemisphere<T>  Vector3<T> about +z, density cos(theta) / pi
+ *
+ * Every vector of a distribution takes the same number of words
+ * (D::words), so generate(rng, dist, out, n) advances rng by n * D::words.
+ * Its output depends on the generator's position and on where the blocks
+ * start (one sample at a time differs from one call for many). Splitting an
+ * array into chunks that start on multiples of kernel_block, each from a
+ * copy of the generator advanced with discard(begin * D::words), gives the
+ * same vectors as one call, on any number of threads; vec::parallel_generate
+ * in vector_parallel.hpp does this. Independent work (e.g. per-thread
+ * estimators) takes one stream each: Philox4x32(seed, thread).
+ *
+ * vec::dispatched::generate runs the same code at the CPU's instruction-set
+ * level (vector_dispatch.hpp). Components are built from 24 random bits
+ * (float) or 52 (double).
+ */
+namespace vec
+{
+    namespace detail
+    {
+        using philox_block = std::array<std::uint32_t, 4>;
+
+        // Philox4x32-10 of counter c under key (k0, k1)
+        inline philox_block philox4x32(philox_block c, std::uint32_t k0, std::uint32_t k1) noexcept
+        {
+            for (int round = 0; round < 10; ++round)
+            {
+                const std::uint64_t p0{std::uint64_t{0xD2511F53u} * c[0]};
+                const std::uint64_t p1{std::uint64_t{0xCD9E8D57u} * c[2]};
+                c = {static_cast<std::uint32_t>(p1 >> 32) ^ c[1] ^ k0, static_cast<std::uint32_t>(p1),
+                     static_cast<std::uint32_t>(p0 >> 32) ^ c[3] ^ k1, static_cast<std::uint32_t>(p0)};
+                k0 += 0x9E3779B9u;
+                k1 += 0xBB67AE85u;
+            }
+            return c;
+        }
+    } // namespace detail
+
+    /**
+     * @brief Counter-based random bit generator (Philox4x32-10)
+     *
+     * The key is the seed; the counter is the stream (high half) and the
+     * index of a block of four words (low half). position() counts the
+     * words taken from the stream.
+     */
+    class Philox4x32
+    {
+    public:
+        using result_type = std::uint32_t;
+
+        explicit Philox4x32(std::uint64_t seed = 0, std::uint64_t stream = 0) noexcept
+            : seed_{seed}, stream_{stream}
+        {
+        }
+
+        [[nodiscard]] static constexpr result_type min() noexcept { return 0; }
+        [[nodiscard]] static constexpr result_type max() noexcept { return std::numeric_limits<result_type>::max(); }
+
+        [[nodiscard]] std::uint64_t seed() const noexcept { return seed_; }
+        [[nodiscard]] std::uint64_t stream() const noexcept { return stream_; }
+        [[nodiscard]] std::uint64_t position() const noexcept { return position_; }
+
+        // Four words of a block of this stream
+        [[nodiscard]] detail::philox_block block(std::uint64_t index) const noexcept
+        {
+            return detail::philox4x32({static_cast<std::uint32_t>(index), static_cast<std::uint32_t>(index >> 32),
+                                       static_cast<std::uint32_t>(stream_), static_cast<std::uint32_t>(stream_ >> 32)},
+                                      static_cast<std::uint32_t>(seed_), static_cast<std::uint32_t>(seed_ >> 32));
+        }
+
+        result_type operator()() noexcept
+        {
+            const std::uint64_t index{position_ / 4};
+            if (!cached_ || cached_index_ != index)
+            {
+                cache_ = block(index);
+                cached_index_ = index;
+                cached_ = true;
+            }
+            return cache_[position_++ % 4];
+        }
+
+        // Skip n words in constant time
+        void discard(std::uint64_t n) noexcept { position_ += n; }
+
+        // The next n words, the same as n calls of operator()
+        void fill(std::uint32_t *out, std::size_t n) noexcept
+        {
+            std::size_t i{0};
+            for (; i < n && position_ % 4 != 0; ++i)
+                out[i] = (*this)();
+            for (; n - i >= 4 * lanes; i += 4 * lanes)
+                fill_lanes(out + i);
+            for (; i < n; ++i)
+                out[i] = (*this)();
+        }
+
+        // Same seed, stream and position
+        [[nodiscard]] bool operator==(const Philox4x32 &other) const noexcept
+        {
+            return seed_ == other.seed_ && stream_ == other.stream_ && position_ == other.position_;
+        }
+
+        [[nodiscard]] bool operator!=(const Philox4x32 &other) const noexcept { return !(*this == other); }
+
+    private:
+        // Blocks computed side by side, one array per counter word
+        static constexpr std::size_t lanes{32};
+
+        // The next lanes blocks, from a block boundary
+        void fill_lanes(std::uint32_t *out) noexcept
+        {
+            std::uint32_t c0[lanes], c1[lanes], c2[lanes], c3[lanes];
+            const std::uint64_t first{position_ / 4};
+            for (std::size_t j = 0; j < lanes; ++j)
+            {
+                c0[j] = static_cast<std::uint32_t>(first + j);
+                c1[j] = static_cast<std::uint32_t>((first + j) >> 32);
+                c2[j] = static_cast<std::uint32_t>(stream_);
+                c3[j] = static_cast<std::uint32_t>(stream_ >> 32);
+            }
+            auto k0{static_cast<std::uint32_t>(seed_)};
+            auto k1{static_cast<std::uint32_t>(seed_ >> 32)};
+            for (int round = 0; round < 10; ++round)
+            {
+                // The rounds of detail::philox4x32
+                for (std::size_t j = 0; j < lanes; ++j)
+                {
+#if defined(VECTORS_SIMD_SSE2) && !defined(__SSE4_1__)
+                    // No 32-bit vector multiply before SSE4.1: both halves from the 64-bit product
+                    const std::uint64_t p0{std::uint64_t{0xD2511F53u} * c0[j]};
+                    const std::uint64_t p1{std::uint64_t{0xCD9E8D57u} * c2[j]};
+                    c0[j] = static_cast<std::uint32_t>(p1 >> 32) ^ c1[j] ^ k0;
+                    c2[j] = static_cast<std::uint32_t>(p0 >> 32) ^ c3[j] ^ k1;
+                    c1[j] = static_cast<std::uint32_t>(p1);
+                    c3[j] = static_cast<std::uint32_t>(p0);
+#else
+                    // High halves from 64-bit products, low halves from 32-bit ones: fewer shuffles
+                    const std::uint32_t a0{c0[j]};
+                    const std::uint32_t a2{c2[j]};
+                    c0[j] = static_cast<std::uint32_t>(std::uint64_t{0xCD9E8D57u} * a2 >> 32) ^ c1[j] ^ k0;
+                    c2[j] = static_cast<std::uint32_t>(std::uint64_t{0xD2511F53u} * a0 >> 32) ^ c3[j] ^ k1;
+                    c1[j] = 0xCD9E8D57u * a2;
+                    c3[j] = 0xD2511F53u * a0;
+#endif
+                }
+                k0 += 0x9E3779B9u;
+                k1 += 0xBB67AE85u;
+            }
+            for (std::size_t j = 0; j < lanes; ++j)
+            {
+                out[4 * j] = c0[j];
+                out[4 * j + 1] = c1[j];
+                out[4 * j + 2] = c2[j];
+                out[4 * j + 3] = c3[j];
+            }
+            position_ += 4 * lanes;
+        }
+
+        std::uint64_t seed_;
+        std::uint64_t stream_;
+        std::uint64_t position_{0};
+        detail::philox_block cache_{};
+        std::uint64_t cached_index_{0};
+        bool cached_{false};
+    };
+
+    namespace detail
+    {
+        // Words of randomness per component
+        template <typename T>
+        inline constexpr std::size_t random_words{sizeof(T) / sizeof(std::uint32_t)};
+
+        /*
+         * Uniform [0, 1) from stream k of a block of m elements, whose words
+         * are laid out component-major (word k of element j at w[k * m + j])
+         */
+        inline void uniform_block(const std::uint32_t *w, std::size_t m, std::size_t k, float *out) noexcept
+        {
+            const std::uint32_t *s{w + k * m};
+            for (std::size_t j = 0; j < m; ++j)
+                out[j] = static_cast<float>(static_cast<std::int32_t>(s[j] >> 8)) * 0x1p-24f;
+        }
+
+        // Exponent of 1.0 and 52 random mantissa bits, minus 1.0
+        inline void uniform_block(const std::uint32_t *w, std::size_t m, std::size_t k, double *out) noexcept
+        {
+            const std::uint32_t *hi{w + 2 * k * m};
+            const std::uint32_t *lo{hi + m};
+            for (std::size_t j = 0; j < m; ++j)
+            {
+                const std::uint64_t bits{0x3FF0000000000000u | std::uint64_t{hi[j]} << 20 | lo[j] >> 12};
+                out[j] = from_bits(bits) - 1.0;
+            }
+        }
+
+        // Angle 2 pi u and its cosine and sine
+        template <typename T>
+        void circle_block(const std::uint32_t *w, std::size_t m, std::size_t k, T *c, T *s) noexcept
+        {
+            constexpr T two_pi{static_cast<T>(6.28318530717958647692)};
+            T angle[kernel_block];
+            uniform_block(w, m, k, angle);
+            for (std::size_t j = 0; j < m; ++j)
+                angle[j] *= two_pi;
+            for (std::size_t j = 0; j < m; ++j)
+                c[j] = math_sin<true>(angle[j]);
+            for (std::size_t j = 0; j < m; ++j)
+                s[j] = math_sin<false>(angle[j]);
+        }
+
+        // Uniform on the unit circle or sphere from streams 0 (and 1), scaled by r if given
+        template <typename T, std::size_t N>
+        void sphere_block(const std::uint32_t *w, std::size_t m, T (&block)[N][kernel_block], const T *r) noexcept
+        {
+            static_assert(N == 2 || N == 3, "spheres are 2D or 3D");
+            if constexpr (N == 2)
+            {
+                circle_block(w, m, 0, block[0], block[1]);
+                if (r)
+                    for (std::size_t c = 0; c < 2; ++c)
+                        for (std::size_t j = 0; j < m; ++j)
+                            block[c][j] *= r[j];
+            }
+            else
+            {
+                // z uniform in (-1, 1] (Archimedes), then a point on the circle of radius sqrt(1 - z^2)
+                T ring[kernel_block];
+                uniform_block(w, m, 0, block[2]);
+                for (std::size_t j = 0; j < m; ++j)
+                {
+                    block[2][j] = 1 - 2 * block[2][j];
+                    ring[j] = 1 - block[2][j] * block[2][j];
+                }
+                sqrt_block(ring, m);
+                if (r)
+                    for (std::size_t j = 0; j < m; ++j)
+                    {
+                        ring[j] *= r[j];
+                        block[2][j] *= r[j];
+                    }
+                circle_block(w, m, 1, block[0], block[1]);
+                for (std::size_t c = 0; c < 2; ++c)
+                    for (std::size_t j = 0; j < m; ++j)
+                        block[c][j] *= ring[j];
+            }
+        }
+
+        // One sample of D
+        template <typename D>
+        typename D::result_type sample(Philox4x32 &rng, const D &dist) noexcept
+        {
+            using V = typename D::result_type;
+            using T = scalar_t<V>;
+            constexpr std::size_t N{vector_traits<V>::size};
+            std::uint32_t w[D::words];
+            rng.fill(w, D::words);
+            T block[N][kernel_block];
+            dist.transform(w, 1, block);
+            V r;
+            for (std::size_t c = 0; c < N; ++c)
+                r[c] = block[c][0];
+            return r;
+        }
+
+        // store(i, m, block) for consecutive blocks of the n samples
+        template <typename D, typename Store>
+        void generate_blocks(Philox4x32 &rng, const D &dist, std::size_t n, Store store) noexcept
+        {
+            using V = typename D::result_type;
+            using T = scalar_t<V>;
+            constexpr std::size_t N{vector_traits<V>::size};
+            std::uint32_t w[D::words * kernel_block];
+            T block[N][kernel_block];
+            for (std::size_t i = 0; i < n; i += kernel_block)
+            {
+                const std::size_t m{std::min(kernel_block, n - i)};
+                rng.fill(w, D::words * m);
+                dist.transform(w, m, block);
+                store(i, m, block);
+            }
+        }
+    } // namespace detail
+
+    // Uniform in the box [lo, hi)
+    template <typename V>
+    class UniformBox
+    {
+    public:
+        using result_type = V;
+        using scalar_type = detail::scalar_t<V>;
+        static constexpr std::size_t size{detail::vector_traits<V>::size};
+        static constexpr std::size_t words{size * detail::random_words<scalar_type>};
+
+        static_assert(detail::math_scalar<scalar_type>, "random vectors need float or double components");
+
+        UniformBox(const V &lo, const V &hi) noexcept : lo_{lo}, hi_{hi} {}
+
+        // The cube [lo, hi)^N
+        UniformBox(scalar_type lo, scalar_type hi) noexcept
+        {
+            for (std::size_t c = 0; c < size; ++c)
+            {
+                lo_[c] = lo;
+                hi_[c] = hi;
+            }
+        }
+
+        [[nodiscard]] V operator()(Philox4x32 &rng) const noexcept { return detail::sample(rng, *this); }
+
+        // Samples from m elements' words, laid out component-major
+        void transform(const std::uint32_t *w, std::size_t m, scalar_type (&block)[size][kernel_block]) const noexcept
+        {
+            for (std::size_t c = 0; c < size; ++c)
+            {
+                detail::uniform_block(w, m, c, block[c]);
+                const scalar_type lo{lo_[c]};
+                const scalar_type extent{hi_[c] - lo_[c]};
+                for (std::size_t j = 0; j < m; ++j)
+                    block[c][j] = lo + extent * block[c][j];
+            }
+        }
+
+    private:
+        V lo_;
+        V hi_;
+    };
+
+    // Uniform on the unit circle (Vector2) or sphere (Vector3)
+    template <typename V>
+    class OnUnitSphere
+    {
+    public:
+        using result_type = V;
+        using scalar_type = detail::scalar_t<V>;
+        static constexpr std::size_t size{detail::vector_traits<V>::size};
+        static constexpr std::size_t words{(size - 1) * detail::random_words<scalar_type>};
+
+        static_assert(detail::math_scalar<scalar_type>, "random vectors need float or double components");
+
+        [[nodiscard]] V operator()(Philox4x32 &rng) const noexcept { return detail::sample(rng, *this); }
+
+        void transform(const std::uint32_t *w, std::size_t m, scalar_type (&block)[size][kernel_block]) const noexcept
+        {
+            detail::sphere_block(w, m, block, static_cast<const scalar_type *>(nullptr));
+        }
+    };
+
+    /**
+     * @brief Uniform in the unit disk (Vector2) or ball (Vector3)
+     *
+     * A point on the sphere scaled by a radius with density proportional to
+     * r^(N-1): sqrt(u) in the disk, the largest of three uniforms in the
+     * ball (which avoids a cube root).
+     */
+    template <typename V>
+    class InUnitBall
+    {
+    public:
+        using result_type = V;
+        using scalar_type = detail::scalar_t<V>;
+        static constexpr std::size_t size{detail::vector_traits<V>::size};
+        static constexpr std::size_t words{(size == 2 ? 2 : 5) * detail::random_words<scalar_type>};
+
+        static_assert(detail::math_scalar<scalar_type>, "random vectors need float or double components");
+
+        [[nodiscard]] V operator()(Philox4x32 &rng) const noexcept { return detail::sample(rng, *this); }
+
+        void transform(const std::uint32_t *w, std::size_t m, scalar_type (&block)[size][kernel_block]) const noexcept
+        {
+            scalar_type r[kernel_block];
+            detail::uniform_block(w, m, size - 1, r);
+            if constexpr (size == 2)
+                detail::sqrt_block(r, m);
+            else
+            {
+                scalar_type u[kernel_block];
+                for (std::size_t k = 3; k < 5; ++k)
+                {
+                    detail::uniform_block(w, m, k, u);
+                    for (std::size_t j = 0; j < m; ++j)
+                        r[j] = std::max(r[j], u[j]);
+                }
+            }
+            detail::sphere_block(w, m, block, r);
+        }
+    };
+
+    /**
+     * @brief Directions about +z with density cos(theta) / pi
+     *
+     * Malley's method: a uniform point in the unit disk, lifted onto the
+     * hemisphere. The usual importance sampling for diffuse reflection.
+     */
+    template <typename T>
+    class CosineHemisphere
+    {
+    public:
+        using result_type = Vector3<T>;
+        using scalar_type = T;
+        static constexpr std::size_t size{3};
+        static constexpr std::size_t words{2 * detail::random_words<T>};
+
+        static_assert(detail::math_scalar<T>, "random vectors need float or double components");
+
+        [[nodiscard]] Vector3<T> operator()(Philox4x32 &rng) const noexcept { return detail::sample(rng, *this); }
+
+        void transform(const std::uint32_t *w, std::size_t m, T (&block)[3][kernel_block]) const noexcept
+        {
+            // u = r^2 of the disk point, so z = sqrt(1 - u)
+            T r[kernel_block];
+            detail::uniform_block(w, m, 0, r);
+            for (std::size_t j = 0; j < m; ++j)
+                block[2][j] = 1 - r[j];
+            detail::sqrt_block(r, m);
+            detail::sqrt_block(block[2], m);
+            detail::circle_block(w, m, 1, block[0], block[1]);
+            for (std::size_t c = 0; c < 2; ++c)
+                for (std::size_t j = 0; j < m; ++j)
+                    block[c][j] *= r[j];
+        }
+    };
+
+    /**
+     * @brief n samples of dist into out
+     *
+     * Advances rng by n * D::words words.
+     */
+    template <typename D>
+    void generate(Philox4x32 &rng, const D &dist, typename D::result_type *out, std::size_t n) noexcept
+    {
+        using V = typename D::result_type;
+        using T = detail::scalar_t<V>;
+        constexpr std::size_t N{detail::vector_traits<V>::size};
+        T *dst{detail::scalars(out)};
+        detail::generate_blocks(rng, dist, n, [&](std::size_t i, std::size_t m, const T (&block)[N][kernel_block])
+                                { detail::store_block(dst + i * N, m, block); });
+    }
+
+    // Into a structure-of-arrays container, the same samples as into an array of vectors
+    template <typename D, typename T, std::size_t N>
+    void generate(Philox4x32 &rng, const D &dist, VectorArray<T, N> &out) noexcept
+    {
+        static_assert(std::is_same_v<typename D::result_type, VectorN<T, N>>, "distribution and array differ");
+        detail::generate_blocks(rng, dist, out.size(), [&](std::size_t i, std::size_t m, const T (&block)[N][kernel_block])
+                                {
+                                    for (std::size_t c = 0; c < N; ++c)
+                                        std::copy(block[c], block[c] + m, out.data(c) + i);
+                                });
+    }
+
+    namespace detail
+    {
+        struct generate_kernel
+        {
+            template <typename D>
+            static void run(Philox4x32 *rng, const D *dist, typename D::result_type *out, std::size_t n) noexcept
+            {
+                vec::generate(*rng, *dist, out, n);
+            }
+        };
+    } // namespace detail
+
+    namespace dispatched
+    {
+        // vec::generate() at active_simd_level(): the same words, components within a rounding
+        template <typename D>
+        void generate(Philox4x32 &rng, const D &dist, typename D::result_type *out, std::size_t n) noexcept
+        {
+            detail::dispatch<detail::generate_kernel>(&rng, &dist, out, n);
+        }
+    } // namespace dispatched
+} // namespace vec
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "vector2.hpp"
+#include "vector3.hpp"
+#include "vector3a.hpp"
+#include "vector4.hpp"
+#include "vector_n.hpp"
+
+namespace vec::detail
+{
+    // Vector class holding N components of type T
+    template <typename T, std::size_t N>
+    struct vector_of
+    {
+        using type = VectorN<T, N>;
+    };
+
+    template <typename T, std::size_t N>
+    using vector_of_t = typename vector_of<T, N>::type;
+
+    // Scalar type and dimension of a vector class
+    template <typename V>
+    struct vector_traits;
+
+    template <typename T, std::size_t N, bool Padded>
+    struct vector_traits<VectorN<T, N, Padded>>
+    {
+        using scalar_type = T;
+        static constexpr std::size_t size = N;
+    };
+
+    template <typename V>
+    using scalar_t = typename vector_traits<V>::scalar_type;
+
+    template <typename V>
+    using norm_t = decltype(std::declval<const V &>().norm());
+
+    // Component I of a vector
+    template <std::size_t I, typename V>
+    constexpr auto &component(V &v) noexcept
+    {
+        return v[I];
+    }
+} // namespace vec::detail
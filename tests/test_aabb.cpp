@@ -0,0 +1,139 @@
+#include <aabb.hpp>
+
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <vector>
+
+void test_empty()
+{
+    constexpr AABB3f empty;
+    static_assert(empty.empty());
+    static_assert(!AABB3f(Vector3f(1.0f, 2.0f, 3.0f)).empty());
+    assert(!empty.contains(Vector3f()));
+    assert(!empty.intersects(AABB3f(Vector3f(), Vector3f(1.0f, 1.0f, 1.0f))));
+    assert(AABB<Vector3i>().empty());
+
+    // Merging into an empty box gives the merged thing
+    AABB3f box;
+    box.merge(Vector3f(1.0f, -1.0f, 2.0f));
+    assert(box == AABB3f(Vector3f(1.0f, -1.0f, 2.0f)));
+    assert(AABB3f().merge(box) == box && AABB3f(box).merge(AABB3f()) == box);
+}
+
+void test_merge_contains()
+{
+    AABB3d box(Vector3d(0.0, 0.0, 0.0));
+    box.merge(Vector3d(1.0, -2.0, 3.0)).merge(Vector3d(-1.0, 4.0, 1.0));
+    assert(box.min() == Vector3d(-1.0, -2.0, 0.0) && box.max() == Vector3d(1.0, 4.0, 3.0));
+    assert(box.center() == Vector3d(0.0, 1.0, 1.5) && box.extent() == Vector3d(2.0, 6.0, 3.0));
+
+    assert(box.contains(Vector3d(0.0, 0.0, 0.0)) && box.contains(Vector3d(1.0, 4.0, 3.0)));
+    assert(!box.contains(Vector3d(0.0, 4.5, 0.0)));
+    assert(box.contains(AABB3d(Vector3d(0.0, 0.0, 0.0), Vector3d(1.0, 1.0, 1.0))));
+    assert(!box.contains(AABB3d(Vector3d(0.0, 0.0, 0.0), Vector3d(2.0, 1.0, 1.0))));
+    assert(box.intersects(AABB3d(Vector3d(1.0, 4.0, 3.0), Vector3d(5.0, 5.0, 5.0))));
+    assert(!box.intersects(AABB3d(Vector3d(1.5, 0.0, 0.0), Vector3d(5.0, 5.0, 5.0))));
+
+    // NaN components of a merged point are ignored
+    const double nan{std::numeric_limits<double>::quiet_NaN()};
+    AABB3d copy{box};
+    assert(copy.merge(Vector3d(nan, 10.0, nan)) == AABB3d(box.min(), Vector3d(1.0, 10.0, 3.0)));
+
+    AABB<Vector3Af> aligned;
+    aligned.merge(Vector3Af(1.0f, 2.0f, 3.0f)).merge(Vector3Af(-1.0f, 5.0f, 0.0f));
+    assert(aligned == AABB<Vector3Af>(Vector3Af(-1.0f, 2.0f, 0.0f), Vector3Af(1.0f, 5.0f, 3.0f)));
+}
+
+void test_ray()
+{
+    const AABB3f box(Vector3f(-1.0f, -1.0f, -1.0f), Vector3f(1.0f, 1.0f, 1.0f));
+    const float inf{std::numeric_limits<float>::infinity()};
+
+    // Along +x from outside, from inside, away from the box
+    auto hit{box.intersect(Vector3f(-3.0f, 0.0f, 0.0f), Vector3f(1.0f, inf, inf))};
+    assert(hit && hit->first == 2.0f && hit->second == 4.0f);
+    hit = box.intersect(Vector3f(0.0f, 0.0f, 0.0f), Vector3f(1.0f, inf, inf));
+    assert(hit && hit->first == 0.0f && hit->second == 1.0f);
+    assert(!box.intersect(Vector3f(3.0f, 0.0f, 0.0f), Vector3f(1.0f, inf, inf)));
+    assert(!box.intersect(Vector3f(-3.0f, 0.0f, 0.0f), Vector3f(1.0f, inf, inf), 1.5f));
+
+    // Parallel to a slab it misses, and in the plane of a face (0 * inf)
+    assert(!box.intersect(Vector3f(-3.0f, 2.0f, 0.0f), Vector3f(1.0f, inf, inf)));
+    hit = box.intersect(Vector3f(-3.0f, 1.0f, 0.0f), Vector3f(1.0f, inf, inf));
+    assert(hit && hit->first == 2.0f && hit->second == 4.0f);
+
+    // Diagonal, direction (-1, -1, -1)
+    hit = box.intersect(Vector3f(2.0f, 2.0f, 2.0f), Vector3f(-1.0f, -1.0f, -1.0f));
+    assert(hit && hit->first == 1.0f && hit->second == 3.0f);
+
+    const AABB2d square(Vector2d(0.0, 0.0), Vector2d(1.0, 1.0));
+    assert(square.intersect(Vector2d(-1.0, 0.5), Vector2d(1.0, 2.0)));
+    assert(!square.intersect(Vector2d(-1.0, 0.5), Vector2d(1.0, 0.25)));
+}
+
+template <typename V>
+void check_bounds_of(const std::vector<V> &points)
+{
+    for (std::size_t n = 0; n <= points.size(); ++n)
+    {
+        AABB<V> expected;
+        for (std::size_t i = 0; i < n; ++i)
+            expected.merge(points[i]);
+        assert(vec::bounds_of(points.data(), n) == expected);
+    }
+}
+
+void test_bounds_of()
+{
+    assert(vec::bounds_of(static_cast<const Vector3f *>(nullptr), 0).empty());
+
+    std::vector<Vector2f> v2;
+    std::vector<Vector3f> v3;
+    std::vector<Vector4d> v4;
+    std::vector<Vector3Ad> v3a;
+    std::vector<Vector3i> v3i;
+    for (int i = 0; i < 37; ++i)
+    {
+        const float f{std::sin(0.37f * i) * static_cast<float>(i)};
+        const float g{std::cos(1.3f * i) * 10.0f};
+        v2.emplace_back(f, g);
+        v3.emplace_back(g, f, f * g);
+        v4.emplace_back(f, g, -f, 1.0 / (i + 1));
+        v3a.emplace_back(g, -f, f);
+        v3i.emplace_back(i * 7 % 11, -i, i * i % 13);
+    }
+    check_bounds_of(v2);
+    check_bounds_of(v3);
+    check_bounds_of(v4);
+    check_bounds_of(v3a);
+    check_bounds_of(v3i);
+
+    // NaN components are skipped, infinities kept
+    const float nan{std::numeric_limits<float>::quiet_NaN()};
+    const float inf{std::numeric_limits<float>::infinity()};
+    v3[0] = Vector3f(nan, nan, nan);
+    v3[5] = Vector3f(inf, 0.0f, nan);
+    v3[30] = Vector3f(0.0f, -inf, 0.0f);
+    const AABB3f box{vec::bounds_of(v3.data(), v3.size())};
+    assert(box.max().x == inf && box.min().y == -inf && !std::isnan(box.min().z) && !std::isnan(box.max().z));
+    check_bounds_of(v3);
+}
+
+void test_stream_output()
+{
+    std::ostringstream oss{};
+    oss << AABB2f(Vector2f(0.0f, 1.0f), Vector2f(2.0f, 3.0f));
+    assert(oss.str() == "AABB(min=Vector2(x=0, y=1), max=Vector2(x=2, y=3))");
+}
+
+int main()
+{
+    test_empty();
+    test_merge_contains();
+    test_ray();
+    test_bounds_of();
+    test_stream_output();
+    return 0;
+}
@@ -0,0 +1,164 @@
+#include <matrix.hpp>
+
+#include <cassert>
+#include <cmath>
+#include <sstream>
+#include <type_traits>
+#include <vector>
+
+[[nodiscard]] bool approx_equal(double a, double b, double e = 1e-10)
+{
+    return std::fabs(a - b) < e;
+}
+
+template <typename T, std::size_t N>
+[[nodiscard]] bool approx_equal(const MatrixN<T, N> &a, const MatrixN<T, N> &b, double e = 1e-10)
+{
+    for (std::size_t r = 0; r < N; ++r)
+        for (std::size_t c = 0; c < N; ++c)
+            if (!approx_equal(a(r, c), b(r, c), e))
+                return false;
+    return true;
+}
+
+// Rotation by 90 degrees about z, scale by 2 and translation by (1, 2, 3); all elements exact
+constexpr Matrix4d transform{Vector4d(0.0, 2.0, 0.0, 0.0), Vector4d(-2.0, 0.0, 0.0, 0.0),
+                             Vector4d(0.0, 0.0, 2.0, 0.0), Vector4d(1.0, 2.0, 3.0, 1.0)};
+
+void test_layout()
+{
+    // Column-major: column c is contiguous
+    constexpr Matrix2i m{Vector2i(1, 2), Vector2i(3, 4)};
+    static_assert(m(0, 0) == 1 && m(1, 0) == 2 && m(0, 1) == 3 && m(1, 1) == 4);
+    static_assert(m[1] == Vector2i(3, 4) && m.row(0) == Vector2i(1, 3));
+    assert(m.data()[1] == 2 && m.data()[2] == 3);
+    static_assert(sizeof(Matrix4f) == 16 * sizeof(float) && alignof(Matrix4f) == 16);
+    static_assert(sizeof(Matrix3d) == 9 * sizeof(double));
+    static_assert(std::is_same_v<Matrix3f, MatrixN<float, 3>>);
+
+    static_assert(Matrix3i() == Matrix3i(Vector3i(0, 0, 0), Vector3i(0, 0, 0), Vector3i(0, 0, 0)));
+    static_assert(Matrix3i::identity()(1, 1) == 1 && Matrix3i::identity()(0, 1) == 0);
+}
+
+void test_arithmetic()
+{
+    constexpr Matrix2i a{Vector2i(1, 2), Vector2i(3, 4)};
+    constexpr Matrix2i b{Vector2i(0, 1), Vector2i(1, 0)};
+    static_assert(a + b == Matrix2i(Vector2i(1, 3), Vector2i(4, 4)));
+    static_assert(a - a == Matrix2i());
+    static_assert(-a == a * -1 && 2 * a == a + a);
+    static_assert(a * 2 / 2 == a);
+
+    // b swaps the columns of a (a * b) or the rows of a (b * a)
+    static_assert(a * b == Matrix2i(Vector2i(3, 4), Vector2i(1, 2)));
+    static_assert(b * a == Matrix2i(Vector2i(2, 1), Vector2i(4, 3)));
+    static_assert(a * Vector2i(1, 1) == Vector2i(4, 6));
+    static_assert(a * Matrix2i::identity() == a);
+
+    Matrix2i m{a};
+    m *= b;
+    m += a;
+    assert(m == Matrix2i(Vector2i(4, 6), Vector2i(4, 6)));
+}
+
+void test_transform()
+{
+    constexpr Vector4d p(1.0, 0.0, 0.0, 1.0);
+    static_assert(transform * p == Vector4d(1.0, 4.0, 3.0, 1.0));
+    static_assert(transform * Vector4d(0.0, 1.0, 0.0, 0.0) == Vector4d(-2.0, 0.0, 0.0, 0.0));
+
+    // Runtime (SIMD) results must match the constexpr (scalar) ones
+    Matrix4d rt{transform};
+    Vector4d rp{p};
+    assert(rt * rp == transform * p);
+    constexpr Matrix4d twice{transform * transform};
+    assert(rt * rt == twice);
+    assert(twice * p == transform * (transform * p));
+
+    const Matrix4f f{static_cast<Matrix4f>(transform)};
+    assert(f * Vector4f(1.0f, 0.0f, 0.0f, 1.0f) == Vector4f(1.0f, 4.0f, 3.0f, 1.0f));
+}
+
+void test_transpose_determinant_inverse()
+{
+    constexpr Matrix3i m{Vector3i(2, 0, 1), Vector3i(1, 3, 0), Vector3i(0, 1, 4)};
+    static_assert(m.transpose().transpose() == m && m.transpose()(0, 1) == m(1, 0));
+    static_assert(m.trace() == 9);
+    static_assert(m.determinant() == 25);
+    static_assert(Matrix4i::identity().determinant() == 1);
+    static_assert(Matrix2i(Vector2i(1, 2), Vector2i(3, 4)).determinant() == -2);
+
+    // det(transform) = 2^3
+    assert(transform.determinant() == 8.0);
+    const Matrix4d inv{transform.inverse()};
+    assert(approx_equal(inv * transform, Matrix4d::identity()));
+    assert(approx_equal(transform * inv, Matrix4d::identity()));
+    assert(inv * Vector4d(1.0, 4.0, 3.0, 1.0) == Vector4d(1.0, 0.0, 0.0, 1.0));
+
+    const Matrix3d md{static_cast<Matrix3d>(m)};
+    assert(approx_equal(md.inverse() * md, Matrix3d::identity()));
+    const Matrix2f m2(Vector2f(4.0f, 2.0f), Vector2f(7.0f, 6.0f));
+    assert(approx_equal(m2.inverse(), Matrix2f(Vector2f(0.6f, -0.2f), Vector2f(-0.7f, 0.4f)), 1e-6));
+
+    // Singular: non-finite elements
+    const Matrix2d singular(Vector2d(1.0, 2.0), Vector2d(2.0, 4.0));
+    assert(singular.determinant() == 0.0 && !std::isfinite(singular.inverse()(0, 0)));
+}
+
+void test_batch()
+{
+    std::vector<Vector3d> points;
+    std::vector<Vector4d> vectors;
+    for (int i = 0; i < 1000; ++i)
+    {
+        points.emplace_back(0.5 * i, -0.25 * (i % 13), 2.0);
+        vectors.emplace_back(0.5 * i, -0.25 * (i % 13), 2.0, i % 2);
+    }
+
+    std::vector<Vector3d> out(points.size());
+    vec::transform_points(transform, points.data(), out.data(), points.size());
+    for (std::size_t i = 0; i < points.size(); ++i)
+    {
+        const Vector4d r{transform * Vector4d(points[i].x, points[i].y, points[i].z, 1.0)};
+        assert(out[i] == Vector3d(r.x, r.y, r.z));
+    }
+
+    // In place, same as the member product
+    std::vector<Vector4d> v{vectors};
+    vec::transform_many(transform, v.data(), v.data(), v.size());
+    for (std::size_t i = 0; i < v.size(); ++i)
+        assert(v[i] == transform * vectors[i]);
+
+    // 3x3 (padded columns) and 2x2 (scalar) matrices, down to a single element
+    const Matrix3d m3{Vector3d(1.0, 2.0, 0.0), Vector3d(0.0, 1.0, -1.0), Vector3d(4.0, 0.0, 0.5)};
+    for (std::size_t n : {std::size_t{1}, std::size_t{2}, points.size()})
+    {
+        std::vector<Vector3d> p3(points.begin(), points.begin() + static_cast<std::ptrdiff_t>(n));
+        vec::transform_many(m3, p3.data(), p3.data(), n);
+        for (std::size_t i = 0; i < n; ++i)
+            assert(p3[i] == m3 * points[i]);
+    }
+    const Matrix2f m2{Vector2f(0.0f, 1.0f), Vector2f(-1.0f, 0.0f)};
+    const Vector2f in2[] = {Vector2f(1.0f, 2.0f), Vector2f(3.0f, -4.0f)};
+    Vector2f out2[2];
+    vec::transform_many(m2, in2, out2, 2);
+    assert(out2[0] == Vector2f(-2.0f, 1.0f) && out2[1] == Vector2f(4.0f, 3.0f));
+}
+
+void test_stream_output()
+{
+    std::ostringstream oss{};
+    oss << Matrix2i(Vector2i(1, 2), Vector2i(3, 4));
+    assert(oss.str() == "Matrix2((1, 3), (2, 4))");
+}
+
+int main()
+{
+    test_layout();
+    test_arithmetic();
+    test_transform();
+    test_transpose_determinant_inverse();
+    test_batch();
+    test_stream_output();
+    return 0;
+}
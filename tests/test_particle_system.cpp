@@ -0,0 +1,178 @@
+#include <particle_system.hpp>
+
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+// Harmonic oscillator x'' = -x, and constant gravity with linear drag
+const auto spring = [](const Vector3d &x, const Vector3d &, double) { return -x; };
+const auto drag = [](const Vector3f &, const Vector3f &v, float) { return Vector3f(0, -9.81f, 0) - 0.5f * v; };
+
+[[nodiscard]] bool near(const Vector3d &a, const Vector3d &b, double tolerance)
+{
+    return (a - b).length() <= tolerance;
+}
+
+[[nodiscard]] vec::ParticleSystem<double> make_oscillators(std::size_t n)
+{
+    vec::ParticleSystem<double> p;
+    p.reserve(n);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const double s{1.0 + double(i % 7)};
+        p.add(Vector3d(s, 0, -s), Vector3d(0, s, 0));
+    }
+    return p;
+}
+
+void test_container()
+{
+    vec::ParticleSystem<float> p(3);
+    assert(p.size() == 3 && !p.empty() && p.time() == 0);
+    assert(p.position()[2] == Vector3f() && p.velocity()[2] == Vector3f());
+    p.add(Vector3f(1, 2, 3), Vector3f(4, 5, 6));
+    assert(p.size() == 4 && p.position()[3] == Vector3f(1, 2, 3) && p.velocity()[3] == Vector3f(4, 5, 6));
+    assert(p.acceleration()[3] == Vector3f());
+    p.resize(10);
+    assert(p.size() == 10 && p.acceleration().size() == 10);
+
+    vec::ParticleSystem<float> none;
+    none.step_euler(0.1f);
+    none.step_rk4(0.1f, drag);
+    assert(none.empty() && none.time() == 0.2f);
+}
+
+// Semi-implicit Euler: the stored accelerations, or the field's, as the compound assignments would
+void test_euler()
+{
+    vec::ThreadPool pool(3);
+    const std::size_t n{10000};
+    vec::ParticleSystem<float> p;
+    std::vector<Vector3f> x(n), v(n), a(n);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        x[i] = Vector3f(float(i), 0, 1);
+        v[i] = Vector3f(1, float(i % 5), 0);
+        a[i] = Vector3f(0, -1, float(i % 3));
+        p.add(x[i], v[i]);
+        p.acceleration()[i] = a[i];
+    }
+    const float dt{0.01f};
+    for (int step = 0; step < 10; ++step)
+    {
+        p.step_euler(dt, pool);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            v[i] += a[i] * dt;
+            x[i] += v[i] * dt;
+        }
+    }
+    assert(std::fabs(p.time() - 0.1f) < 1e-6f);
+    for (std::size_t i = 0; i < n; ++i)
+        assert((Vector3f(p.position()[i]) - x[i]).length() < 1e-3f &&
+               (Vector3f(p.velocity()[i]) - v[i]).length() < 1e-5f);
+
+    // With a field; the stored accelerations are left alone
+    vec::ParticleSystem<float> q;
+    q.add(Vector3f(0, 10, 0), Vector3f(2, 0, 0));
+    q.step_euler(dt, drag, pool);
+    const Vector3f a0{drag(Vector3f(0, 10, 0), Vector3f(2, 0, 0), 0)};
+    assert(q.acceleration()[0] == Vector3f());
+    assert((Vector3f(q.velocity()[0]) - (Vector3f(2, 0, 0) + a0 * dt)).length() < 1e-6f);
+}
+
+// Error at t = 1 of an oscillator, over dt = 1 / steps
+template <typename Step>
+double oscillator_error(std::size_t steps, Step step)
+{
+    vec::ParticleSystem<double> p;
+    p.add(Vector3d(1, 0, 0));
+    p.evaluate(spring);
+    for (std::size_t k = 0; k < steps; ++k)
+        step(p, 1.0 / double(steps));
+    return (Vector3d(p.position()[0]) - Vector3d(std::cos(p.time()), 0, 0)).length();
+}
+
+// Velocity Verlet is second order and exact for constant acceleration
+void test_verlet()
+{
+    const auto verlet = [](vec::ParticleSystem<double> &p, double dt) { p.step_verlet(dt, spring); };
+    const double coarse{oscillator_error(50, verlet)};
+    const double fine{oscillator_error(100, verlet)};
+    assert(fine < 1e-4 && std::fabs(coarse / fine - 4) < 0.2);
+
+    // Energy stays bounded over many periods
+    vec::ParticleSystem<double> p{make_oscillators(1000)};
+    p.evaluate(spring);
+    std::vector<double> energy(p.size());
+    for (std::size_t i = 0; i < p.size(); ++i)
+        energy[i] = Vector3d(p.position()[i]).norm_squared() + Vector3d(p.velocity()[i]).norm_squared();
+    for (int step = 0; step < 10000; ++step)
+        p.step_verlet(0.01, spring);
+    for (std::size_t i = 0; i < p.size(); ++i)
+    {
+        const double e{Vector3d(p.position()[i]).norm_squared() + Vector3d(p.velocity()[i]).norm_squared()};
+        assert(std::fabs(e - energy[i]) < 1e-4 * energy[i]);
+    }
+
+    const auto gravity = [](const Vector3d &, const Vector3d &, double) { return Vector3d(0, 0, -10); };
+    vec::ParticleSystem<double> ball;
+    ball.add(Vector3d(0, 0, 100), Vector3d(3, 0, 20));
+    ball.evaluate(gravity);
+    for (int step = 0; step < 8; ++step)
+        ball.step_verlet(0.25, gravity);
+    assert(near(ball.position()[0], Vector3d(6, 0, 100 + 40 - 20), 1e-12));
+    assert(near(ball.velocity()[0], Vector3d(3, 0, 0), 1e-12));
+}
+
+// Classical Runge-Kutta is fourth order
+void test_rk4()
+{
+    const auto rk4 = [](vec::ParticleSystem<double> &p, double dt) { p.step_rk4(dt, spring); };
+    const double coarse{oscillator_error(20, rk4)};
+    const double fine{oscillator_error(40, rk4)};
+    assert(fine < 1e-7 && std::fabs(coarse / fine - 16) < 1.5);
+
+    // Drag and gravity: v(t) = g / k + (v0 - g / k) e^(-k t)
+    vec::ParticleSystem<float> p;
+    p.add(Vector3f(0, 0, 0), Vector3f(4, 0, 0));
+    for (int step = 0; step < 100; ++step)
+        p.step_rk4(0.01f, drag);
+    const float decay{std::exp(-0.5f)};
+    const Vector3f expected(4 * decay, -9.81f / 0.5f * (1 - decay), 0);
+    assert((Vector3f(p.velocity()[0]) - expected).length() < 1e-4f);
+    assert(p.acceleration()[0] == Vector3f());
+}
+
+// Chunks split the same work: any pool size gives the same state
+void test_pools()
+{
+    vec::ThreadPool one(1);
+    vec::ThreadPool four(4);
+    vec::ParticleSystem<double> a{make_oscillators(100000)};
+    vec::ParticleSystem<double> b{make_oscillators(100000)};
+    for (int step = 0; step < 3; ++step)
+    {
+        a.step_rk4(0.01, spring, one);
+        b.step_rk4(0.01, spring, four);
+        a.step_verlet(0.01, spring, one);
+        b.step_verlet(0.01, spring, four);
+        a.step_euler(0.01, one);
+        b.step_euler(0.01, four);
+    }
+    for (std::size_t i = 0; i < a.size(); ++i)
+        assert(Vector3d(a.position()[i]) == Vector3d(b.position()[i]) &&
+               Vector3d(a.velocity()[i]) == Vector3d(b.velocity()[i]));
+    assert(a.time() == b.time());
+}
+
+int main()
+{
+    test_container();
+    test_euler();
+    test_verlet();
+    test_rk4();
+    test_pools();
+    return 0;
+}
@@ -0,0 +1,128 @@
+#include <quaternion.hpp>
+
+#include <cassert>
+#include <cmath>
+#include <sstream>
+#include <vector>
+
+constexpr double pi{3.14159265358979323846};
+
+[[nodiscard]] bool approx_equal(double a, double b, double e = 1e-10)
+{
+    return std::fabs(a - b) < e;
+}
+
+template <typename T>
+[[nodiscard]] bool approx_equal(const Vector3<T> &a, const Vector3<T> &b, double e = 1e-10)
+{
+    return approx_equal(a.x, b.x, e) && approx_equal(a.y, b.y, e) && approx_equal(a.z, b.z, e);
+}
+
+template <typename T>
+[[nodiscard]] bool approx_equal(const Quaternion<T> &a, const Quaternion<T> &b, double e = 1e-10)
+{
+    return approx_equal(a.x(), b.x(), e) && approx_equal(a.y(), b.y(), e) && approx_equal(a.z(), b.z(), e) &&
+           approx_equal(a.w(), b.w(), e);
+}
+
+void test_basics()
+{
+    constexpr Quaterniond id;
+    static_assert(id == Quaterniond::identity() && id.w() == 1.0 && id.vec() == Vector3d(0.0, 0.0, 0.0));
+    static_assert(sizeof(Quaternionf) == sizeof(Vector4f) && alignof(Quaternionf) == alignof(Vector4f));
+
+    constexpr Quaterniond a(1.0, 2.0, 3.0, 4.0);
+    static_assert(a.coeffs() == Vector4d(1.0, 2.0, 3.0, 4.0));
+    static_assert(a.conjugate() == Quaterniond(-1.0, -2.0, -3.0, 4.0));
+    static_assert(a.norm_squared() == 30.0 && a.dot(id) == 4.0);
+    static_assert(a * id == a && id * a == a);
+    static_assert(a + a == a * 2.0 && a - a == Quaterniond(0.0, 0.0, 0.0, 0.0));
+
+    // i * j = k, j * i = -k
+    constexpr Quaterniond i(1.0, 0.0, 0.0, 0.0);
+    constexpr Quaterniond j(0.0, 1.0, 0.0, 0.0);
+    static_assert(i * j == Quaterniond(0.0, 0.0, 1.0, 0.0));
+    static_assert(j * i == Quaterniond(0.0, 0.0, -1.0, 0.0));
+
+    assert(approx_equal(a * a.inverse(), id));
+    assert(approx_equal(a.normalize().norm(), 1.0));
+}
+
+void test_rotate()
+{
+    const Quaterniond qz{Quaterniond::from_axis_angle(Vector3d(0.0, 0.0, 1.0), pi / 2)};
+    assert(approx_equal(qz.rotate(Vector3d(1.0, 0.0, 0.0)), Vector3d(0.0, 1.0, 0.0)));
+    assert(approx_equal(qz * Vector3d(0.0, 0.0, 2.0), Vector3d(0.0, 0.0, 2.0)));
+
+    // Composition: rotate by qx, then by qz
+    const Quaterniond qx{Quaterniond::from_axis_angle(Vector3d(1.0, 0.0, 0.0), pi / 2)};
+    const Vector3d v(0.3, -1.2, 2.5);
+    assert(approx_equal((qz * qx).rotate(v), qz.rotate(qx.rotate(v))));
+    assert(approx_equal(qz.inverse().rotate(qz.rotate(v)), v));
+
+    // Rotations preserve length; q and -q are the same rotation
+    const Quaterniond q{Quaterniond(0.2, -0.4, 0.7, 0.5).normalize()};
+    assert(approx_equal(q.rotate(v).length(), v.length()));
+    assert(approx_equal((-q).rotate(v), q.rotate(v)));
+
+    // Same rotation as the matrices
+    assert(approx_equal(q.to_matrix3() * v, q.rotate(v)));
+    const Vector4d h{q.to_matrix4() * Vector4d(v.x, v.y, v.z, 1.0)};
+    assert(approx_equal(Vector3d(h.x, h.y, h.z), q.rotate(v)) && h.w == 1.0);
+}
+
+void test_interpolation()
+{
+    const Vector3d axis(0.0, 1.0, 0.0);
+    const Quaterniond a{Quaterniond::from_axis_angle(axis, 0.0)};
+    const Quaterniond b{Quaterniond::from_axis_angle(axis, pi / 2)};
+
+    assert(approx_equal(vec::slerp(a, b, 0.0), a) && approx_equal(vec::slerp(a, b, 1.0), b));
+    assert(approx_equal(vec::slerp(a, b, 0.5), Quaterniond::from_axis_angle(axis, pi / 4)));
+    assert(approx_equal(vec::slerp(a, b, 0.25), Quaterniond::from_axis_angle(axis, pi / 8)));
+
+    // Shorter arc: -b is the same rotation as b
+    assert(approx_equal(vec::slerp(a, -b, 0.5), Quaterniond::from_axis_angle(axis, pi / 4)));
+
+    // nlerp agrees at the midpoint, stays unit length elsewhere
+    assert(approx_equal(vec::nlerp(a, b, 0.5), vec::slerp(a, b, 0.5)));
+    assert(approx_equal(vec::nlerp(a, b, 0.3).norm(), 1.0));
+
+    // Nearly identical inputs
+    const Quaterniond c{Quaterniond::from_axis_angle(axis, 1e-6)};
+    assert(approx_equal(vec::slerp(a, c, 0.5), Quaterniond::from_axis_angle(axis, 0.5e-6)));
+}
+
+void test_batch()
+{
+    const Quaternionf q{Quaternionf(0.2f, -0.4f, 0.7f, 0.5f).normalize()};
+    std::vector<Vector3f> in;
+    for (int i = 0; i < 1000; ++i)
+        in.emplace_back(0.5f * i, -0.25f * (i % 13), 2.0f);
+
+    // Same rotation as the member (within rounding), also in place
+    std::vector<Vector3f> out(in.size());
+    vec::rotate_many(q, in.data(), out.data(), in.size());
+    for (std::size_t i = 0; i < in.size(); ++i)
+        assert(approx_equal(out[i], q.rotate(in[i]), 1e-3));
+    std::vector<Vector3f> inplace{in};
+    vec::rotate_many(q, inplace.data(), inplace.data(), inplace.size());
+    assert(inplace == out);
+}
+
+void test_stream_output()
+{
+    std::ostringstream oss{};
+    oss << Quaternionf();
+    assert(oss.str() == "Quaternion(x=0, y=0, z=0, w=1)");
+}
+
+int main()
+{
+    test_basics();
+    test_rotate();
+    test_interpolation();
+    test_batch();
+    test_stream_output();
+    return 0;
+}
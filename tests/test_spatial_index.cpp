@@ -0,0 +1,176 @@
+#include <spatial_index.hpp>
+#include <vector_random.hpp>
+
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+// Deterministic points in [0, scale)^N
+template <typename V>
+std::vector<V> make_points(std::size_t n, double scale, std::uint64_t seed)
+{
+    using T = vec::detail::scalar_t<V>;
+    std::vector<V> points(n);
+    vec::Philox4x32 rng{seed};
+    vec::generate(rng, vec::UniformBox<V>(T(0), static_cast<T>(scale)), points.data(), n);
+    return points;
+}
+
+template <typename V, typename D = vec::detail::distance_t<V>>
+std::vector<vec::Neighbor<D>> brute_force_knn(const std::vector<V> &points, const V &q, std::size_t k)
+{
+    std::vector<vec::Neighbor<D>> all;
+    for (std::size_t i = 0; i < points.size(); ++i)
+        all.push_back({i, (points[i] - q).norm_squared()});
+    std::sort(all.begin(), all.end());
+    all.resize(std::min(k, all.size()));
+    return all;
+}
+
+template <typename V, typename D = vec::detail::distance_t<V>>
+std::vector<vec::Neighbor<D>> brute_force_radius(const std::vector<V> &points, const V &q, D r)
+{
+    std::vector<vec::Neighbor<D>> all;
+    for (std::size_t i = 0; i < points.size(); ++i)
+        if ((points[i] - q).norm_squared() <= r * r)
+            all.push_back({i, (points[i] - q).norm_squared()});
+    std::sort(all.begin(), all.end());
+    return all;
+}
+
+template <typename V>
+void check_against_brute_force(double scale, double cell_size)
+{
+    using D = vec::detail::distance_t<V>;
+    const std::vector<V> points{make_points<V>(2000, scale, 1)};
+    const std::vector<V> queries{make_points<V>(50, scale * 1.2, 2)};
+
+    const vec::KdTree<V> tree(points.data(), points.size());
+    vec::HashGrid<V> grid(static_cast<D>(cell_size));
+    for (const V &p : points)
+        grid.insert(p);
+    assert(tree.size() == points.size() && grid.size() == points.size());
+
+    std::vector<vec::Neighbor<D>> found;
+    for (const V &q : queries)
+        for (std::size_t k : {std::size_t{1}, std::size_t{7}, std::size_t{64}})
+        {
+            const std::vector<vec::Neighbor<D>> expected{brute_force_knn(points, q, k)};
+            tree.knn(q, k, found);
+            assert(found == expected);
+            grid.knn(q, k, found);
+            assert(found == expected);
+        }
+    for (const V &q : queries)
+    {
+        const D r{static_cast<D>(scale * 0.1)};
+        const std::vector<vec::Neighbor<D>> expected{brute_force_radius(points, q, r)};
+        tree.radius(q, r, found);
+        assert(found == expected);
+        grid.radius(q, r, found);
+        assert(found == expected);
+    }
+}
+
+void test_knn_radius()
+{
+    check_against_brute_force<Vector3d>(100.0, 5.0);
+    check_against_brute_force<Vector3f>(1.0, 0.05);
+    check_against_brute_force<Vector2d>(10.0, 0.3);
+    check_against_brute_force<Vector4d>(1.0, 0.1);
+    // Cells far too small or too large still give exact results
+    check_against_brute_force<Vector3d>(100.0, 0.01);
+    check_against_brute_force<Vector2f>(1.0, 100.0);
+}
+
+void test_duplicates_and_small()
+{
+    // Ties are broken by index, as in a sorted brute force search
+    const std::vector<Vector2d> same(20, Vector2d(1.0, 1.0));
+    const vec::KdTree<Vector2d> tree(same.data(), same.size());
+    std::vector<vec::Neighbor<double>> found;
+    tree.knn(Vector2d(0.0, 0.0), 3, found);
+    assert(found.size() == 3 && found[0].index == 0 && found[2].index == 2 && found[1].distance_squared == 2.0);
+
+    // k larger than the index, empty indexes, k == 0
+    tree.knn(Vector2d(), 50, found);
+    assert(found.size() == 20);
+    tree.knn(Vector2d(), 0, found);
+    assert(found.empty());
+    const vec::KdTree<Vector3f> empty_tree(nullptr, 0);
+    std::vector<vec::Neighbor<float>> found_f{{1, 1.0f}};
+    empty_tree.knn(Vector3f(), 4, found_f);
+    assert(found_f.empty());
+    const vec::HashGrid<Vector3d> empty_grid(1.0);
+    empty_grid.knn(Vector3d(), 4, found);
+    assert(found.empty());
+    empty_grid.radius(Vector3d(), 4.0, found);
+    assert(found.empty());
+}
+
+void test_grid_updates()
+{
+    vec::HashGrid<Vector3d> grid(1.0);
+    const std::size_t a{grid.insert(Vector3d(0.5, 0.5, 0.5))};
+    const std::size_t b{grid.insert(Vector3d(10.0, 0.0, 0.0))};
+    const std::size_t c{grid.insert(Vector3d(-3.0, 2.0, 1.0))};
+    assert(grid.size() == 3 && grid.contains(b) && grid.point(c) == Vector3d(-3.0, 2.0, 1.0));
+
+    std::vector<vec::Neighbor<double>> found;
+    grid.knn(Vector3d(9.0, 0.0, 0.0), 1, found);
+    assert(found.size() == 1 && found[0].index == b && found[0].distance_squared == 1.0);
+
+    // Move within a cell and across cells
+    grid.move(b, Vector3d(10.2, 0.0, 0.0));
+    grid.move(a, Vector3d(8.5, 0.0, 0.0));
+    grid.knn(Vector3d(9.0, 0.0, 0.0), 2, found);
+    assert(found.size() == 2 && found[0].index == a && found[1].index == b);
+    assert(grid.point(a) == Vector3d(8.5, 0.0, 0.0));
+
+    // Removed ids disappear from queries and are reused
+    grid.remove(a);
+    assert(grid.size() == 2 && !grid.contains(a));
+    grid.knn(Vector3d(9.0, 0.0, 0.0), 3, found);
+    assert(found.size() == 2 && found[0].index == b && found[1].index == c);
+    const std::size_t d{grid.insert(Vector3d(100.0, 100.0, 100.0))};
+    assert(d == a && grid.contains(d));
+    grid.radius(Vector3d(100.0, 100.0, 99.0), 1.0, found);
+    assert(found.size() == 1 && found[0].index == d);
+
+    grid.clear();
+    assert(grid.empty() && !grid.contains(b));
+}
+
+void test_batch()
+{
+    const std::vector<Vector3d> points{make_points<Vector3d>(5000, 1.0, 3)};
+    const std::vector<Vector3d> queries{make_points<Vector3d>(300, 1.0, 4)};
+    const vec::KdTree<Vector3d> tree(points.data(), points.size());
+    vec::HashGrid<Vector3d> grid(0.05);
+    for (const Vector3d &p : points)
+        grid.insert(p);
+
+    constexpr std::size_t k{5};
+    vec::ThreadPool pool(4);
+    std::vector<vec::Neighbor<double>> from_tree(queries.size() * k);
+    std::vector<vec::Neighbor<double>> from_grid(queries.size() * k);
+    tree.knn_many(queries.data(), queries.size(), k, from_tree.data(), pool);
+    grid.knn_many(queries.data(), queries.size(), k, from_grid.data(), pool);
+    assert(from_tree == from_grid);
+
+    std::vector<vec::Neighbor<double>> found;
+    for (std::size_t i = 0; i < queries.size(); ++i)
+    {
+        tree.knn(queries[i], k, found);
+        assert(std::equal(found.begin(), found.end(), from_tree.begin() + static_cast<std::ptrdiff_t>(i * k)));
+    }
+}
+
+int main()
+{
+    test_knn_radius();
+    test_duplicates_and_small();
+    test_grid_updates();
+    test_batch();
+    return 0;
+}
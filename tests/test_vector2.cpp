@@ -2,6 +2,7 @@
 
 #include <cassert>
 #include <sstream>
+#include <type_traits>
 
 [[nodiscard]] bool approx_equal(double a, double b, double e = 1e-10)
 {
@@ -275,7 +276,7 @@ void test_norm()
 
     // Float
     constexpr Vector2f vf(-0.5f, 0.5f);
-    assert(vf.norm() == vf.length() && approx_equal(vf.norm(), std::sqrt(0.5)));
+    assert(vf.norm() == vf.length() && approx_equal(vf.norm(), std::sqrt(0.5), 1e-6));
 
     // Double
     constexpr Vector2d vd(1.234, 5.678);
@@ -312,6 +313,55 @@ void test_normalize()
     assert(vd.normalize() == Vector2d(-4.0 / 5.0, 3.0 / 5.0));
 }
 
+void test_norm_precision()
+{
+    // Float vectors compute norms in float, other types in double
+    constexpr Vector2i vi(3, 4);
+    constexpr Vector2f vf(0.1f, 0.2f);
+    constexpr Vector2d vd(1.0, 2.0);
+    static_assert(std::is_same_v<decltype(vi.norm()), double> && std::is_same_v<decltype(vi.norm_squared()), double>);
+    static_assert(std::is_same_v<decltype(vf.norm()), float> && std::is_same_v<decltype(vf.norm_squared()), float>);
+    static_assert(std::is_same_v<decltype(vd.norm()), double> && std::is_same_v<decltype(vd.length()), double>);
+
+    // Explicit precision
+    static_assert(std::is_same_v<decltype(vf.norm<double>()), double>);
+    assert(approx_equal(vf.norm(), vf.norm<double>(), 1e-5));
+    assert(approx_equal(vf.norm<double>(), std::sqrt(static_cast<double>(0.1f) * 0.1f + static_cast<double>(0.2f) * 0.2f)));
+    assert(vf.length<double>() == vf.norm<double>());
+    assert(approx_equal(vf.normalize<double>(), vf.normalize(), 1e-6));
+    static_assert(vi.norm_squared<float>() == 25.0f);
+}
+
+void test_normalize_fast()
+{
+    // Within 1e-6 of the exact result
+    constexpr Vector2f vf(3.0f, -4.0f);
+    assert(approx_equal(vf.normalize_fast(), vf.normalize<double>(), 1e-6));
+    assert(approx_equal(vf.inv_norm_fast(), 1.0 / vf.norm<double>(), 1e-6 / vf.norm<double>()));
+
+    constexpr Vector2d vd(1e-3, 2e-3);
+    assert(approx_equal(vd.normalize_fast(), vd.normalize(), 1e-6));
+
+    // Zero vectors are left unchanged
+    assert(Vector2f().normalize_fast() == Vector2f());
+}
+
+void test_fma()
+{
+    constexpr Vector2f vf(1.5f, -2.0f);
+    constexpr Vector2f wf(4.0f, 0.5f);
+    assert(vf.dot_fma(wf) == vf.dot(wf) && vf.norm_squared_fma() == 6.25f);
+
+    // (-1) * 1 + (1 + e)(1 - e) = -e^2: the product rounds to 1 without FMA
+    const double e{std::ldexp(1.0, -30)};
+    const Vector2d a(-1.0, 1.0 + e);
+    const Vector2d b(1.0, 1.0 - e);
+    assert(a.dot_fma(b) == -e * e);
+
+    const float ef{std::ldexp(1.0f, -13)};
+    assert(Vector2f(-1.0f, 1.0f + ef).dot_fma(Vector2f(1.0f, 1.0f - ef)) == -ef * ef);
+}
+
 void test_sign()
 {
     // Int
@@ -384,6 +434,9 @@ int main()
     test_norm();
     test_norm_squared();
     test_normalize();
+    test_norm_precision();
+    test_normalize_fast();
+    test_fma();
     test_sign();
     test_pow();
     test_convert();
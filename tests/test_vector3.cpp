@@ -1,7 +1,10 @@
 #include <vector3.hpp>
 
 #include <cassert>
+#include <cstdint>
+#include <limits>
 #include <sstream>
+#include <type_traits>
 
 [[nodiscard]] bool approx_equal(double a, double b, double e = 1e-10)
 {
@@ -348,6 +351,73 @@ void test_normalize()
     assert(approx_equal(vd.normalize(), Vector3d(0.6, 0.8, 0.0)));
 }
 
+void test_norm_precision()
+{
+    // Float vectors compute norms in float, other types in double
+    constexpr Vector3i vi(3, 4, 12);
+    constexpr Vector3f vf(0.1f, 0.2f, 0.3f);
+    constexpr Vector3d vd(1.0, 2.0, 2.0);
+    static_assert(std::is_same_v<decltype(vi.norm()), double> && std::is_same_v<decltype(vi.norm_squared()), double>);
+    static_assert(std::is_same_v<decltype(vf.norm()), float> && std::is_same_v<decltype(vf.norm_squared()), float>);
+    static_assert(std::is_same_v<decltype(vd.norm()), double> && std::is_same_v<decltype(vd.length()), double>);
+
+    // Explicit precision
+    static_assert(std::is_same_v<decltype(vf.norm<double>()), double>);
+    assert(approx_equal(vf.norm(), vf.norm<double>(), 1e-5));
+    assert(approx_equal(vf.norm<double>(), std::sqrt(static_cast<double>(0.1f) * 0.1f + static_cast<double>(0.2f) * 0.2f + static_cast<double>(0.3f) * 0.3f)));
+    assert(vf.length<double>() == vf.norm<double>());
+    assert(approx_equal(vf.normalize<double>(), vf.normalize(), 1e-6));
+    static_assert(vi.norm_squared<float>() == 169.0f);
+}
+
+void test_normalize_fast()
+{
+    // Within 1e-6 of the exact result
+    constexpr Vector3f vf(0.1f, -20.0f, 3.5f);
+    assert(approx_equal(vf.normalize_fast(), vf.normalize<double>(), 1e-6));
+    assert(approx_equal(vf.inv_norm_fast(), 1.0 / vf.norm<double>(), 1e-6 / vf.norm<double>()));
+
+    constexpr Vector3d vd(1e3, 2e3, -5e2);
+    assert(approx_equal(vd.normalize_fast(), vd.normalize(), 1e-6));
+
+    // Zero vectors are left unchanged
+    assert(Vector3f().normalize_fast() == Vector3f());
+
+    // Subnormal and infinite squared norms fall back to the exact 1 / sqrt
+    constexpr Vector3f tiny(1e-19f, 0.0f, 0.0f);
+    assert(approx_equal(tiny.normalize_fast(), Vector3f(1.0f, 0.0f, 0.0f), 1e-6));
+    assert(approx_equal(tiny.inv_norm_fast() * 1e-19, 1.0, 1e-6));
+    constexpr Vector3f huge(1e20f, -1e20f, 0.0f);
+    assert(huge.inv_norm_fast() == 0.0f);
+    assert(huge.normalize_fast() == Vector3f());
+}
+
+void test_fma()
+{
+    // Same results as the plain versions on exact inputs
+    constexpr Vector3d vd(1.5, 2.5, 0.5);
+    constexpr Vector3d wd(2.0, 1.0, 4.0);
+    assert(vd.dot_fma(wd) == 7.5 && vd.norm_squared_fma() == vd.norm_squared());
+    assert(vd.cross_fma(wd) == vd.cross(wd));
+    assert(Vector3f(1.0f, 2.0f, 3.0f).cross_fma(Vector3f(4.0f, 5.0f, 6.0f)) == Vector3f(-3.0f, 6.0f, -3.0f));
+
+    // Nearly parallel vectors: x * o.y - y * o.x = (1 + e)(1 - e) - 1 = -e^2
+    // cancels completely when the products are rounded first
+    const double e{std::ldexp(1.0, -30)};
+    const Vector3d a(1.0 + e, 1.0, 0.0);
+    const Vector3d b(1.0, 1.0 - e, 0.0);
+    assert(a.cross_fma(b) == Vector3d(0.0, 0.0, -e * e));
+    assert(b.cross_fma(a) == Vector3d(0.0, 0.0, e * e));
+
+    const float ef{std::ldexp(1.0f, -13)};
+    const Vector3f af(0.0f, 1.0f + ef, 1.0f);
+    const Vector3f bf(0.0f, 1.0f, 1.0f - ef);
+    assert(af.cross_fma(bf) == Vector3f(-ef * ef, 0.0f, 0.0f));
+
+    // Catastrophic cancellation in the dot product
+    assert(Vector3d(-1.0, 1.0 + e, 0.0).dot_fma(Vector3d(1.0, 1.0 - e, 3.0)) == -e * e);
+}
+
 void test_sign()
 {
     // Int
@@ -376,6 +446,85 @@ void test_pow()
     // Double
     constexpr Vector3d vd(2.0, 1.0, 3.0);
     assert(approx_equal(vd.pow(3.0), Vector3d(8.0, 1.0, 27.0)));
+
+    // Compile-time exponents: products only, so exact where std::pow is exact
+    static_assert(vi.pow<3>() == Vector3i(8, 27, 1) && vi.pow<0>() == Vector3i(1, 1, 1));
+    static_assert(vd.pow<2>() == Vector3d(4.0, 1.0, 9.0) && vd.pow<-1>() == Vector3d(0.5, 1.0, 1.0 / 3.0));
+    static_assert(vf.pow<1>() == vf && vf.pow<-2>() == Vector3f(1.0f / 16.0f, 1.0f / 81.0f, 1.0f));
+    assert(vd.pow<7>() == vd.pow(7.0) && vd.pow<-3>() == Vector3d(0.125, 1.0, 1.0 / 27.0));
+}
+
+void test_integer()
+{
+    constexpr int big{std::numeric_limits<int>::max()};
+    constexpr int small{std::numeric_limits<int>::min()};
+
+    // Squared norms in unsigned 64 bits and dot products in 64 bits, exact where int overflows
+    constexpr Vector3i a(big, -big, big);
+    static_assert(std::is_same_v<decltype(a.dot_wide(a)), std::int64_t>);
+    static_assert(std::is_same_v<decltype(a.norm_squared_wide()), std::uint64_t>);
+    static_assert(std::is_same_v<decltype(Vector3<unsigned>().norm_squared_wide()), std::uint64_t>);
+    static_assert(Vector3i(1 << 30, -(1 << 30), 1 << 30).norm_squared_wide() == 3 * (std::uint64_t{1} << 60));
+    static_assert(a.norm_squared_wide() == 3 * std::uint64_t{big} * big);
+    static_assert(Vector3i(small, small, small).norm_squared_wide() == 3 * (std::uint64_t{1} << 62));
+    static_assert(Vector3i(small, 1, 0).dot_wide(Vector3i(small, big, 5)) == (std::int64_t{1} << 62) + big);
+    const Vector3i ra{a};
+    assert(ra.dot_wide(Vector3i(1, 1, 1)) == big);
+    assert(ra.norm_squared_wide() == 3 * std::uint64_t{big} * big);
+
+    // Checked dot products: std::nullopt exactly when the result leaves int
+    static_assert(Vector3i(2, 3, 4).dot_checked(Vector3i(5, 6, 7)) == 56);
+    static_assert(!Vector3i(big, 0, 0).dot_checked(Vector3i(2, 0, 0)));
+    static_assert(Vector3i(big, big, 7).dot_checked(Vector3i(1, -1, 1)) == 7);
+    static_assert(Vector3i(small, 0, 0).dot_checked(Vector3i(1, 0, 0)) == small);
+    static_assert(!Vector3i(small, 0, 0).dot_checked(Vector3i(-1, 0, 0)));
+    static_assert(!Vector3i(1 << 16, 0, 0).dot_checked(Vector3i(1 << 15, 0, 0)));
+    assert(!ra.dot_checked(ra) && ra.dot_checked(Vector3i(0, 1, 1)) == 0);
+
+    // 64-bit components have no wider type: products and partial sums are checked
+    using Vector3l = Vector3<std::int64_t>;
+    constexpr std::int64_t big_l{std::numeric_limits<std::int64_t>::max()};
+    static_assert(!Vector3l(big_l / 2 + 1, 0, 0).dot_checked(Vector3l(2, 0, 0)));
+    static_assert(!Vector3l(big_l, 1, 0).dot_checked(Vector3l(1, 1, 0)));
+    static_assert(Vector3l(big_l, -big_l, 1).dot_checked(Vector3l(1, 1, 5)) == 5);
+
+    // Powers by repeated squaring, wrapping around like unsigned arithmetic
+    static_assert(Vector3i(3, -2, 7).pow(5) == Vector3i(243, -32, 16807));
+    static_assert(Vector3i(2, -2, 0).pow(0) == Vector3i(1, 1, 1));
+    static_assert(Vector3i(1, -1, 4).pow(-3) == Vector3i(1, -1, 0));
+    static_assert(Vector3i(-1, 0, 2).pow(-2) == Vector3i(1, 0, 0));
+    static_assert(Vector3i(2, -1, -2).pow(31) == Vector3i(small, -1, small));
+    static_assert(Vector3i(2, -1, -2).pow<31>() == Vector3i(small, -1, small));
+    static_assert(Vector3i(1, -1, 4).pow<-3>() == Vector3i(1, -1, 0));
+    static_assert(Vector3<std::uint8_t>(3, 255, 16).pow<2>() == Vector3<std::uint8_t>(9, 1, 0));
+    assert(Vector3i(3, 0, 0).pow(21).x == static_cast<int>(10460353203ULL % (1ULL << 32)));
+    for (int e = 0; e <= 19; ++e)
+        assert(Vector3i(3, -3, 2).pow(e) ==
+               Vector3i(static_cast<int>(std::pow(3.0, e)), static_cast<int>(std::pow(-3.0, e)), 1 << e));
+
+    // Normalization divides by the exact integer norm, rounded down
+    static_assert(Vector3i(10, 0, 0).normalize() == Vector3i(1, 0, 0));
+    static_assert(Vector3i(7, 0, -1).normalize() == Vector3i(1, 0, 0));
+    static_assert(Vector3i(3, 4, 0).normalize() == Vector3i());
+    static_assert(Vector3i(big, 0, 0).normalize() == Vector3i(1, 0, 0));
+    static_assert(Vector3i(0, small, 0).normalize() == Vector3i(0, -1, 0));
+    static_assert(Vector3i(small, small, small).normalize() == Vector3i());
+    static_assert(Vector3i().normalize() == Vector3i());
+    assert(ra.normalize() == Vector3i());
+    assert(Vector3i(-5, 0, 0).normalize() == Vector3i(-1, 0, 0));
+
+    // Integer square root at the edges of 64 bits, constexpr and at runtime
+    constexpr std::uint64_t max_root{0xFFFFFFFFu};
+    static_assert(vec::detail::integer_sqrt(std::numeric_limits<std::uint64_t>::max()) == max_root);
+    static_assert(vec::detail::integer_sqrt(max_root * max_root) == max_root);
+    static_assert(vec::detail::integer_sqrt(max_root * max_root - 1) == max_root - 1);
+    static_assert(vec::detail::integer_sqrt(0) == 0 && vec::detail::integer_sqrt(3) == 1);
+    for (const std::uint64_t x : {std::numeric_limits<std::uint64_t>::max(), max_root * max_root,
+                                  max_root * max_root - 1, (std::uint64_t{1} << 52) + 1, std::uint64_t{99}})
+    {
+        const std::uint64_t r{vec::detail::integer_sqrt(x)};
+        assert(r * r <= x && (r == max_root || (r + 1) * (r + 1) > x));
+    }
 }
 
 void test_convert()
@@ -422,8 +571,12 @@ int main()
     test_norm();
     test_norm_squared();
     test_normalize();
+    test_norm_precision();
+    test_normalize_fast();
+    test_fma();
     test_sign();
     test_pow();
+    test_integer();
     test_convert();
     test_stream_output();
     return 0;
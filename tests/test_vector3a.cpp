@@ -0,0 +1,217 @@
+#include <vector3a.hpp>
+#include <vector2.hpp>
+#include <vector3.hpp>
+
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <sstream>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+[[nodiscard]] bool approx_equal(double a, double b, double e = 1e-10)
+{
+    return std::fabs(a - b) < e;
+}
+
+template <typename T>
+[[nodiscard]] bool approx_equal(const Vector3A<T> &a, const Vector3A<T> &b, double e = 1e-10)
+{
+    return approx_equal(a.x, b.x, e) && approx_equal(a.y, b.y, e) && approx_equal(a.z, b.z, e);
+}
+
+// Fourth lane, read through the register view
+template <typename T>
+[[nodiscard]] T padding(const Vector3A<T> &v)
+{
+    return v.data()[3];
+}
+
+void test_layout()
+{
+    static_assert(sizeof(Vector3Af) == 16 && alignof(Vector3Af) == 16);
+    static_assert(sizeof(Vector3Ad) == 32 && alignof(Vector3Ad) == 32);
+    static_assert(sizeof(Vector3Ai) == 4 * sizeof(int) && alignof(Vector3Ai) == 16);
+    static_assert(Vector3Af::size() == 3);
+
+    // The padding lane is a member of the same standard-layout storage as x, y and z
+    static_assert(std::is_standard_layout_v<Vector3Af> && std::is_trivially_copyable_v<Vector3Ad>);
+    static_assert(std::is_same_v<Vector3Ai, VectorN<int, 3, true>>);
+    constexpr Vector3Af v(1.0f, 2.0f, 3.0f);
+    static_assert(v.padding == 0.0f && (v / v).padding == 0.0f);
+
+    // Every element of an array starts on a register boundary
+    const std::vector<Vector3Af> points(5);
+    for (const Vector3Af &p : points)
+        assert(reinterpret_cast<std::uintptr_t>(&p) % 16 == 0);
+}
+
+void test_conversion()
+{
+    constexpr Vector3f packed(1.0f, -2.0f, 3.0f);
+    constexpr Vector3Af padded{packed};
+    static_assert(padded.x == 1.0f && padded.y == -2.0f && padded.z == 3.0f);
+    static_assert(Vector3f(padded) == packed);
+
+    // Implicit in both directions
+    const Vector3f back = padded + Vector3f(1.0f, 1.0f, 1.0f);
+    assert(back == Vector3f(2.0f, -1.0f, 4.0f));
+    static_assert(static_cast<Vector3Ai>(Vector3Ad(1.5, -1.5, 2.0)) == Vector3Ai(1, -1, 2));
+}
+
+void test_arithmetic()
+{
+    constexpr Vector3Ai a(1, 2, 3);
+    constexpr Vector3Ai b(4, 5, 6);
+    static_assert(a + b == Vector3Ai(5, 7, 9));
+    static_assert(b - a == Vector3Ai(3, 3, 3));
+    static_assert(a * b == Vector3Ai(4, 10, 18));
+    static_assert(b / a == Vector3Ai(4, 2, 2));
+    static_assert(2 * a - 1 == Vector3Ai(1, 3, 5));
+    static_assert(a.dot(b) == 32);
+    static_assert(a.cross(b) == Vector3Ai(-3, 6, -3));
+    static_assert(-a == Vector3Ai(-1, -2, -3));
+
+    Vector3Ai v{a};
+    v += b;
+    v *= 2;
+    assert(v == Vector3Ai(10, 14, 18));
+}
+
+void test_simd()
+{
+    // Runtime (SIMD) results must match the constexpr (scalar) ones
+    constexpr Vector3Af a(1.5f, -2.0f, 0.25f);
+    constexpr Vector3Af b(-0.5f, 4.0f, 2.0f);
+    Vector3Af ra{a};
+    Vector3Af rb{b};
+    constexpr Vector3Af sum{a + b};
+    constexpr Vector3Af quot{a / b};
+    constexpr Vector3Af scaled{a * 3.0f};
+    assert(ra + rb == sum);
+    assert(ra / rb == quot);
+    assert(ra * 3.0f == scaled);
+    assert(ra.dot(rb) == a.dot(b) && ra.dot(rb) == -8.25f);
+    assert(!(ra == rb));
+
+    constexpr Vector3Ad c(1.0, 2.0, 2.0);
+    Vector3Ad rc{c};
+    assert(rc.norm() == 3.0 && rc.norm_squared() == 9.0);
+    assert(Vector3Af(1.0f, 2.0f, 2.0f).norm<double>() == 3.0);
+    assert(rc - rc == Vector3Ad());
+
+    constexpr Vector3Ai d(7, -9, 40000);
+    constexpr Vector3Ai e(-2, 3, 40000);
+    Vector3Ai rd{d};
+    Vector3Ai re{e};
+    constexpr Vector3Ai prod_i{d * e};
+    constexpr Vector3Ai quot_i{d / e};
+    assert(rd + re == d + e && rd - re == d - e);
+    assert(rd * re == prod_i && rd / re == quot_i && quot_i == Vector3Ai(-3, -3, 1));
+    assert(rd.dot(re) == d.dot(e) && -rd == -d && rd.abs() == Vector3Ai(7, 9, 40000));
+    assert(rd.dot_wide(re) == std::int64_t{40000} * 40000 - 41 && !rd.dot_checked(re * 2));
+    assert(rd.norm_squared_wide() == 130 + std::uint64_t{40000} * 40000);
+    assert(rd.normalize() == Vector3Ai(0, 0, 1) && rd.pow(2) == Vector3Ai(49, 81, 1600000000));
+}
+
+void test_padding()
+{
+    // Operations that would turn a zero lane into NaN, a non-zero value or -0 keep it zero
+    const Vector3Af a(1.0f, 2.0f, 3.0f);
+    assert(padding(a / a) == 0.0f && !std::signbit(padding(a / a)));
+    assert(padding(a / 0.0f) == 0.0f);
+    assert(padding(-a) == 0.0f && !std::signbit(padding(-a)));
+    assert(padding(a + 5.0f) == 0.0f && padding(a - 5.0f) == 0.0f);
+    assert(padding(a * a) == 0.0f);
+
+    const Vector3Ad d(1.0, 2.0, 3.0);
+    assert(padding(d / d) == 0.0 && !std::signbit(padding(-d)));
+    assert(padding(d.normalize()) == 0.0);
+    assert(padding(Vector3Ad(Vector3d(1.0, 2.0, 3.0))) == 0.0);
+
+    const Vector3Ai i(1, 2, 3);
+    assert(padding(i / i) == 0 && padding(i / 2) == 0 && padding(-i) == 0 && padding(i + 5) == 0);
+}
+
+void test_norm()
+{
+    const Vector3Ad v(3.0, 4.0, 0.0);
+    static_assert(std::is_same_v<decltype(v.norm()), double>);
+    static_assert(std::is_same_v<decltype(Vector3Af().norm()), float>);
+    assert(v.length() == 5.0 && v.normSquared() == 25.0);
+    assert(approx_equal(v.normalize(), Vector3Ad(0.6, 0.8, 0.0)));
+    assert(approx_equal(v.normalize_fast(), Vector3Ad(0.6, 0.8, 0.0), 1e-6));
+    assert(approx_equal(v.inv_norm_fast(), 0.2, 1e-6));
+    assert(Vector3Ad().normalize() == Vector3Ad());
+}
+
+void test_fma()
+{
+    const Vector3Ad a(1.0, 2.0, 3.0);
+    const Vector3Ad b(4.0, 5.0, 6.0);
+    assert(a.dot_fma(b) == 32.0 && a.norm_squared_fma() == 14.0);
+    assert(a.cross_fma(b) == a.cross(b));
+}
+
+void test_sign_pow()
+{
+    constexpr Vector3Af v(-2.0f, 0.0f, 3.0f);
+    static_assert(v.sign() == Vector3Af(-1.0f, 1.0f, 1.0f));
+    assert(v.pow(2.0f) == Vector3Af(4.0f, 0.0f, 9.0f));
+    static_assert(v.pow<2>() == Vector3Af(4.0f, 0.0f, 9.0f) && v.pow<3>() == Vector3Af(-8.0f, 0.0f, 27.0f));
+}
+
+void test_min_max()
+{
+    constexpr Vector3Af a(1.0f, -2.0f, 3.0f);
+    constexpr Vector3Af b(0.0f, 5.0f, 3.0f);
+    static_assert(a.min(b) == Vector3Af(0.0f, -2.0f, 3.0f) && a.max(b) == Vector3Af(1.0f, 5.0f, 3.0f));
+    assert(a.min(b) == Vector3Af(0.0f, -2.0f, 3.0f) && a.max(b) == Vector3Af(1.0f, 5.0f, 3.0f));
+    assert(a.clamp(-1.0f, 2.0f) == Vector3Af(1.0f, -1.0f, 2.0f));
+    assert(a.abs() == Vector3Af(1.0f, 2.0f, 3.0f) && padding(a.abs()) == 0.0f);
+    assert(Vector3Ad(-0.5, 1.5, -2.0).floor() == Vector3Ad(-1.0, 1.0, -2.0));
+    assert(Vector3Ad(-0.5, 1.5, -2.0).ceil() == Vector3Ad(-0.0, 2.0, -2.0));
+    assert(a.lerp(b, 0.5f) == Vector3Af(0.5f, 1.5f, 3.0f));
+    assert(padding(a.min(b)) == 0.0f && padding(a.max(-b)) == 0.0f);
+}
+
+// The rest of the VectorN interface comes with the padded vector
+void test_shared_interface()
+{
+    Vector3Af v(1.0f, 2.0f, 3.0f);
+    static_assert(std::is_same_v<decltype(std::as_const(v).zyx()), Vector3f>);
+    assert(v.zyx() == Vector3f(3.0f, 2.0f, 1.0f) && v.xy() == Vector2f(1.0f, 2.0f));
+    v.zx() = Vector2f(-1.0f, 7.0f);
+    assert(v == Vector3Af(7.0f, 2.0f, -1.0f) && padding(v) == 0.0f);
+    assert(v.clamp(0.0f, 5.0f) == Vector3Af(5.0f, 2.0f, 0.0f));
+
+    constexpr int big{std::numeric_limits<int>::max()};
+    const Vector3Ai i(big, -big, big);
+    assert(i.norm_squared_wide() == Vector3i(i).norm_squared_wide() && i.pow<3>() == Vector3i(i).pow<3>());
+    assert(i / 7 == Vector3i(i) / 7 && padding(i / 7) == 0 && padding(i.normalize()) == 0);
+}
+
+void test_stream_output()
+{
+    std::ostringstream oss{};
+    oss << Vector3Ai(1, 2, 3);
+    assert(oss.str() == "Vector3A(x=1, y=2, z=3)");
+}
+
+int main()
+{
+    test_layout();
+    test_conversion();
+    test_arithmetic();
+    test_simd();
+    test_padding();
+    test_norm();
+    test_fma();
+    test_sign_pow();
+    test_min_max();
+    test_shared_interface();
+    test_stream_output();
+    return 0;
+}
@@ -1,7 +1,10 @@
 #include <vector4.hpp>
 
 #include <cassert>
+#include <cstdint>
+#include <limits>
 #include <sstream>
+#include <type_traits>
 
 [[nodiscard]] bool approx_equal(double a, double b, double e = 1e-10)
 {
@@ -331,6 +334,52 @@ void test_normalize()
     assert(vd.normalize() == Vector4d(1.0, 0.0, 0.0, 0.0));
 }
 
+void test_norm_precision()
+{
+    // Float vectors compute norms in float, other types in double
+    constexpr Vector4i vi(1, 2, 2, 4);
+    constexpr Vector4f vf(0.1f, 0.2f, 0.3f, 0.4f);
+    constexpr Vector4d vd(1.0, 2.0, 2.0, 4.0);
+    static_assert(std::is_same_v<decltype(vi.norm()), double> && std::is_same_v<decltype(vi.norm_squared()), double>);
+    static_assert(std::is_same_v<decltype(vf.norm()), float> && std::is_same_v<decltype(vf.norm_squared()), float>);
+    static_assert(std::is_same_v<decltype(vd.norm()), double> && std::is_same_v<decltype(vd.length()), double>);
+
+    // Explicit precision
+    static_assert(std::is_same_v<decltype(vf.norm<double>()), double>);
+    assert(approx_equal(vf.norm(), vf.norm<double>(), 1e-5));
+    assert(approx_equal(vf.norm<double>(), std::sqrt(static_cast<double>(0.1f) * 0.1f + static_cast<double>(0.2f) * 0.2f + static_cast<double>(0.3f) * 0.3f + static_cast<double>(0.4f) * 0.4f)));
+    assert(vf.length<double>() == vf.norm<double>());
+    assert(approx_equal(vf.normalize<double>(), vf.normalize(), 1e-6));
+    static_assert(vi.norm_squared<float>() == 25.0f);
+}
+
+void test_normalize_fast()
+{
+    // Within 1e-6 of the exact result
+    constexpr Vector4f vf(0.1f, -20.0f, 3.5f, 1.0f);
+    assert(approx_equal(vf.normalize_fast(), vf.normalize<double>(), 1e-6));
+    assert(approx_equal(vf.inv_norm_fast(), 1.0 / vf.norm<double>(), 1e-6 / vf.norm<double>()));
+
+    constexpr Vector4d vd(1e3, 2e3, -5e2, 7.0);
+    assert(approx_equal(vd.normalize_fast(), vd.normalize(), 1e-6));
+
+    // Zero vectors are left unchanged
+    assert(Vector4f().normalize_fast() == Vector4f());
+}
+
+void test_fma()
+{
+    constexpr Vector4f vf(1.0f, 0.0f, -1.0f, 2.0f);
+    constexpr Vector4f wf(2.0f, 3.0f, 1.0f, 0.5f);
+    assert(vf.dot_fma(wf) == 2.0f && vf.norm_squared_fma() == 6.0f);
+
+    // -1 + (1 + e)(1 - e) = -e^2 survives only if the product is not rounded first
+    const double e{std::ldexp(1.0, -30)};
+    const Vector4d a(-1.0, 0.0, 1.0 + e, 0.0);
+    const Vector4d b(1.0, 5.0, 1.0 - e, 7.0);
+    assert(a.dot_fma(b) == -e * e);
+}
+
 void test_sign()
 {
     // Int
@@ -398,6 +447,90 @@ void test_stream_output()
     assert(oss.str() == "Vector4(x=1.124, y=2, z=-1.45, w=0)");
 }
 
+void test_simd()
+{
+    static_assert(alignof(Vector4f) == 16 && sizeof(Vector4f) == 16);
+    static_assert(alignof(Vector4d) == 32 && sizeof(Vector4d) == 32);
+
+    // Runtime (SIMD) results must match the constexpr (scalar) ones
+    constexpr Vector4f a_f(1.5f, -2.0f, 0.25f, 8.0f);
+    constexpr Vector4f b_f(-0.5f, 4.0f, 2.0f, 0.125f);
+    Vector4f ra_f{a_f};
+    Vector4f rb_f{b_f};
+    constexpr Vector4f sum_f{a_f + b_f};
+    constexpr Vector4f diff_f{a_f - b_f};
+    constexpr Vector4f prod_f{a_f * b_f};
+    constexpr Vector4f quot_f{a_f / b_f};
+    constexpr Vector4f neg_f{-a_f};
+    constexpr Vector4f scaled_f{a_f * 3.0f};
+    constexpr float dot_f{a_f.dot(b_f)};
+    assert(ra_f + rb_f == sum_f);
+    assert(ra_f - rb_f == diff_f);
+    assert(ra_f * rb_f == prod_f);
+    assert(ra_f / rb_f == quot_f);
+    assert(-ra_f == neg_f);
+    assert(ra_f * 3.0f == scaled_f);
+    assert(ra_f.dot(rb_f) == dot_f);
+    assert(!(ra_f == rb_f));
+    assert(approx_equal(ra_f.norm<double>(), std::sqrt(1.5 * 1.5 + 4.0 + 0.0625 + 64.0)));
+    assert(approx_equal(ra_f.norm(), std::sqrt(1.5 * 1.5 + 4.0 + 0.0625 + 64.0), 1e-5));
+    ra_f += rb_f;
+    assert(ra_f == sum_f);
+    ra_f -= rb_f;
+    ra_f *= 3.0f;
+    assert(ra_f == scaled_f);
+
+    constexpr Vector4d a_d(1.5, -2.0, 0.25, 8.0);
+    constexpr Vector4d b_d(-0.5, 4.0, 2.0, 0.125);
+    Vector4d ra_d{a_d};
+    Vector4d rb_d{b_d};
+    constexpr Vector4d sum_d{a_d + b_d};
+    constexpr Vector4d quot_d{a_d / b_d};
+    constexpr double dot_d{a_d.dot(b_d)};
+    assert(ra_d + rb_d == sum_d);
+    assert(ra_d / rb_d == quot_d);
+    assert(-ra_d == Vector4d(-1.5, 2.0, -0.25, -8.0));
+    assert(ra_d.dot(rb_d) == dot_d);
+    assert(approx_equal(ra_d.normalize().norm(), 1.0));
+    ra_d /= 2.0;
+    assert(ra_d == Vector4d(0.75, -1.0, 0.125, 4.0));
+
+    // 32-bit integer lanes
+    static_assert(alignof(Vector4i) == 16 && sizeof(Vector4i) == 16);
+    constexpr int big{std::numeric_limits<int>::max()};
+    constexpr int small{std::numeric_limits<int>::min()};
+    constexpr Vector4i a_i(7, -9, 123456, -big);
+    constexpr Vector4i b_i(-3, 2, -7, big);
+    Vector4i ra_i{a_i};
+    Vector4i rb_i{b_i};
+    constexpr Vector4i sum_i{a_i + b_i};
+    constexpr Vector4i diff_i{a_i - Vector4i(3, 4, 5, 1)};
+    constexpr Vector4i prod_i{a_i * Vector4i(-300, 1000, 17, 1)};
+    constexpr Vector4i quot_i{a_i / b_i};
+    constexpr int dot_i{a_i.dot(Vector4i(1, 2, 3, 0))};
+    assert(ra_i + rb_i == sum_i);
+    assert(ra_i - Vector4i(3, 4, 5, 1) == diff_i);
+    assert(ra_i * Vector4i(-300, 1000, 17, 1) == prod_i);
+    assert(ra_i / rb_i == quot_i && quot_i == Vector4i(-2, -4, -17636, -1));
+    assert(ra_i / 2 == a_i / 2 && Vector4i(small, big, -big, 9) / 7 == Vector4i(small / 7, big / 7, -big / 7, 1));
+    assert(-ra_i == Vector4i(-7, 9, -123456, big));
+    assert(ra_i.abs() == Vector4i(7, 9, 123456, big));
+    assert(ra_i.min(rb_i) == Vector4i(-3, -9, -7, -big) && ra_i.max(rb_i) == Vector4i(7, 2, 123456, big));
+    assert(ra_i.clamp(-8, 8) == Vector4i(7, -8, 8, -8));
+    assert(ra_i.dot(Vector4i(1, 2, 3, 0)) == dot_i);
+    assert(ra_i.wzyx() == Vector4i(-big, 123456, -9, 7));
+    assert(!(ra_i == rb_i) && ra_i == a_i);
+
+    // Exact 64-bit squared norms and normalization at the edges of int
+    assert(Vector4i(1 << 30, -(1 << 30), 1 << 30, -(1 << 30)).norm_squared_wide() == std::uint64_t{1} << 62);
+    assert(Vector4i(big, -big, big, small).norm_squared_wide() == 3 * std::uint64_t{big} * big + (std::uint64_t{1} << 62));
+    static_assert(Vector4i(small, small, small, small).normalize() == Vector4i());
+    assert(Vector4i(small, small, small, small).normalize() == Vector4i());
+    assert(Vector4i(0, 0, small, 0).normalize() == Vector4i(0, 0, -1, 0));
+    assert(Vector4i(big, big, big, big).normalize() == Vector4i());
+    assert(Vector4i(0, big, 0, 0).normalize() == Vector4i(0, 1, 0, 0));
+}
+
 int main()
 {
     test_addition();
@@ -408,9 +541,13 @@ int main()
     test_norm();
     test_norm_squared();
     test_normalize();
+    test_norm_precision();
+    test_normalize_fast();
+    test_fma();
     test_sign();
     test_pow();
     test_convert();
     test_stream_output();
+    test_simd();
     return 0;
 }
@@ -0,0 +1,271 @@
+#include <vector_array.hpp>
+#include <vector_random.hpp>
+
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+void test_element_access()
+{
+    Vector3fArray a(3);
+    assert(a.size() == 3 && !a.empty());
+    assert(a[0] == Vector3f(0.0f, 0.0f, 0.0f));
+
+    a[1] = Vector3f(1.0f, 2.0f, 3.0f);
+    assert(a[1] == Vector3f(1.0f, 2.0f, 3.0f));
+    assert(a.x()[1] == 1.0f && a.y()[1] == 2.0f && a.z()[1] == 3.0f);
+
+    a[1] += Vector3f(1.0f, 1.0f, 1.0f);
+    a[2] = a[1];
+    a[2] *= 2.0f;
+    assert(a[1] == Vector3f(2.0f, 3.0f, 4.0f));
+    assert(a[2] == Vector3f(4.0f, 6.0f, 8.0f));
+
+    const Vector3f v = a[2];
+    assert(v == Vector3f(4.0f, 6.0f, 8.0f));
+
+    a.push_back(Vector3f(-1.0f, -2.0f, -3.0f));
+    assert(a.size() == 4 && a[3] == Vector3f(-1.0f, -2.0f, -3.0f));
+
+    // Streams are cache-line aligned
+    assert(reinterpret_cast<std::uintptr_t>(a.x()) % 64 == 0);
+    assert(reinterpret_cast<std::uintptr_t>(a.z()) % 64 == 0);
+
+    // Array-of-structures round trip
+    const Vector4i aos[] = {Vector4i(1, 2, 3, 4), Vector4i(5, 6, 7, 8)};
+    const Vector4iArray b(aos, 2);
+    assert(b[1] == Vector4i(5, 6, 7, 8) && b.w()[0] == 4);
+    Vector4i back[2];
+    b.copy_to(back);
+    assert(back[0] == aos[0] && back[1] == aos[1]);
+
+    a.clear();
+    assert(a.empty());
+}
+
+void test_arithmetic()
+{
+    const Vector2dArray a{Vector2d(1.0, 2.0), Vector2d(-3.0, 4.0), Vector2d(0.5, 0.25)};
+    const Vector2dArray b{Vector2d(2.0, 2.0), Vector2d(1.0, -1.0), Vector2d(4.0, 0.5)};
+
+    for (std::size_t i = 0; i < a.size(); ++i)
+    {
+        assert((a + b)[i] == a[i] + b[i]);
+        assert((a - b)[i] == a[i] - b[i]);
+        assert((a * b)[i] == a[i] * b[i]);
+        assert((a / b)[i] == a[i] / b[i]);
+        assert((a * 3.0)[i] == a[i] * 3.0);
+        assert((3.0 * a)[i] == a[i] * 3.0);
+        assert((a - 1.0)[i] == a[i] - 1.0);
+        assert((a + Vector2d(1.0, -1.0))[i] == a[i] + Vector2d(1.0, -1.0));
+        assert((-a)[i] == -a[i]);
+    }
+
+    Vector2dArray c{a};
+    c += b;
+    c -= b;
+    c *= 2.0;
+    c /= 2.0;
+    for (std::size_t i = 0; i < a.size(); ++i)
+        assert(c[i] == a[i]);
+}
+
+void test_products()
+{
+    const Vector3iArray a{Vector3i(1, 0, 0), Vector3i(1, 2, 3)};
+    const Vector3iArray b{Vector3i(0, 1, 0), Vector3i(4, 5, 6)};
+
+    const auto dots = a.dot(b);
+    assert(dots[0] == 0 && dots[1] == 32);
+
+    const Vector3iArray c = a.cross(b);
+    assert(c[0] == Vector3i(0, 0, 1));
+    assert(c[1] == Vector3i(1, 2, 3).cross(Vector3i(4, 5, 6)));
+}
+
+void test_norms()
+{
+    Vector3fArray a;
+    for (int i = 0; i < 37; ++i)
+        a.push_back(Vector3f(0.5f * i, -1.25f * i, 3.0f - i));
+
+    const auto norms = a.norm();
+    const auto squared = a.norm_squared();
+    const Vector3fArray n = a.normalize();
+    for (std::size_t i = 0; i < a.size(); ++i)
+    {
+        const Vector3f v = a[i];
+        assert(norms[i] == v.norm() && a.length()[i] == v.length());
+        assert(squared[i] == v.norm_squared());
+        assert(n[i] == v.normalize());
+    }
+
+    // Zero vectors are left unchanged
+    const Vector2fArray zero(4);
+    assert(zero.normalize()[3] == Vector2f(0.0f, 0.0f));
+}
+
+void test_sign_pow()
+{
+    const Vector4dArray a{Vector4d(-2.0, 0.0, 3.0, -0.5), Vector4d(1.0, 2.0, -3.0, 4.0)};
+    const Vector4dArray s = a.sign();
+    const Vector4dArray p = a.pow(2.0);
+    const Vector4dArray q = a.pow<3>();
+    for (std::size_t i = 0; i < a.size(); ++i)
+    {
+        assert(s[i] == a[i].sign());
+        assert(p[i] == a[i].pow(2.0));
+        assert(q[i] == a[i].pow<3>());
+    }
+}
+
+// Integer arrays take the members' exact paths: wrapping pow and integer-root normalize
+void test_integer_edges()
+{
+    constexpr int lo{std::numeric_limits<int>::min()};
+    constexpr int hi{std::numeric_limits<int>::max()};
+    const Vector3iArray a{Vector3i(100000, 7, 0), Vector3i(lo, 0, 0),     Vector3i(hi, -hi, hi),
+                          Vector3i(2000000000, 2000000000, 0), Vector3i(-1290, 1626, -2048),
+                          Vector3i(lo, lo, lo),  Vector3i(0, 0, 0),       Vector3i(3, -4, 12)};
+    const Vector3iArray cubes = a.pow(3);
+    const Vector3iArray static_cubes = a.pow<3>();
+    const Vector3iArray inverses = a.pow(-1);
+    const Vector3iArray n = a.normalize();
+    for (std::size_t i = 0; i < a.size(); ++i)
+    {
+        assert(cubes[i] == a[i].pow(3) && static_cubes[i] == a[i].pow<3>());
+        assert(inverses[i] == a[i].pow(-1));
+        assert(n[i] == a[i].normalize());
+    }
+    assert(Vector3i(cubes[0]).x == -1530494976);
+    assert(n[1] == Vector3i(-1, 0, 0) && n[7] == Vector3i(0, 0, 0));
+
+    // Four times INT_MIN squared wraps to zero and normalizes to zero
+    const Vector4iArray wrapped{Vector4i(lo, lo, lo, lo), Vector4i(lo, 0, lo, 0)};
+    const Vector4iArray w = wrapped.normalize();
+    assert(w[0] == Vector4i() && w[0] == wrapped[0].normalize() && w[1] == wrapped[1].normalize());
+}
+
+// Element-wise results are exact unless the compiler may contract the
+// members into FMAs; sums over components are in a different order in the
+// SIMD members of Vector4f
+#if defined(VECTORS_HAS_FMA)
+constexpr float element_error{1e-6f};
+#else
+constexpr float element_error{0.0f};
+#endif
+constexpr float sum_error{1e-6f};
+
+[[nodiscard]] bool same(float a, float b, float e)
+{
+    return a == b || (std::isnan(a) && std::isnan(b)) || std::fabs(a - b) <= e * (1.0f + std::fabs(b));
+}
+
+template <typename V>
+[[nodiscard]] bool same(const V &a, const V &b, float e)
+{
+    for (std::size_t c = 0; c < V::size(); ++c)
+        if (!same(a[c], b[c], e))
+            return false;
+    return true;
+}
+
+template <std::size_t N>
+VectorArray<float, N> make_array(std::size_t n, std::uint64_t seed)
+{
+    VectorArray<float, N> a(n);
+    vec::Philox4x32 rng{seed};
+    vec::generate(rng, vec::UniformBox<VectorN<float, N>>(-2.0f, 2.0f), a);
+    if (n > 5)
+        a[5] = vec::detail::vector_of_t<float, N>();
+    return a;
+}
+
+// Sizes around the sixteen-lane width exercise full registers and masked tails
+template <std::size_t N>
+void check_wide(std::size_t n)
+{
+    using V = vec::detail::vector_of_t<float, N>;
+    const VectorArray<float, N> a{make_array<N>(n, 1)};
+    const VectorArray<float, N> b{make_array<N>(n, 2)};
+    const V v{make_array<N>(1, 3)[0]};
+
+    const VectorArray<float, N> sum{a + b}, difference{a - b}, product{a * b}, quotient{a / b};
+    const VectorArray<float, N> scaled{a * 1.5f}, shifted{a - v}, divided{a / 3.0f}, negated{-a};
+    const VectorArray<float, N> normalized{a.normalize()};
+    const auto dots = a.dot(b);
+    const auto lengths = a.length();
+    const auto squared = a.norm_squared();
+    VectorArray<float, N> c{a};
+    c *= b;
+    c += 2.0f;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        assert(same(sum[i], a[i] + b[i], element_error) && same(difference[i], a[i] - b[i], element_error));
+        assert(same(product[i], a[i] * b[i], element_error) && same(quotient[i], a[i] / b[i], element_error));
+        assert(same(scaled[i], a[i] * 1.5f, element_error) && same(shifted[i], a[i] - v, element_error));
+        assert(same(divided[i], a[i] / 3.0f, element_error) && same(negated[i], -a[i], element_error));
+        assert(same(V(c[i]), a[i] * b[i] + 2.0f, element_error));
+        assert(same(normalized[i], V(a[i]).normalize(), sum_error));
+        assert(same(dots[i], V(a[i]).dot(b[i]), sum_error));
+        assert(same(lengths[i], V(a[i]).length(), sum_error) && same(squared[i], V(a[i]).norm_squared(), sum_error));
+    }
+
+    if constexpr (N == 3)
+    {
+        const Vector3fArray crossed{a.cross(b)};
+        for (std::size_t i = 0; i < n; ++i)
+            assert(same(crossed[i], Vector3f(a[i]).cross(b[i]), element_error));
+    }
+}
+
+// Kernels stop at n: streams are followed by guard values that must survive
+void test_masked_tails()
+{
+    for (const std::size_t n : {std::size_t{1}, std::size_t{15}, std::size_t{17}, std::size_t{40}})
+    {
+        std::vector<float> in(n + 16, 2.0f);
+        std::vector<float> out(n + 16, -7.0f);
+        vec::detail::soa_zip(in.data(), in.data(), out.data(), n, vec::detail::plus_op{});
+        vec::detail::soa_zip_scalar(out.data(), 1.0f, out.data(), n, vec::detail::divides_op{});
+        vec::detail::soa_map(out.data(), out.data(), n, vec::detail::negate_op{});
+        for (std::size_t i = 0; i < n + 16; ++i)
+            assert(out[i] == (i < n ? -4.0f : -7.0f));
+
+        // Three output streams of n + 16 in one buffer
+        const std::size_t stride{n + 16};
+        std::vector<float> r(3 * stride, -7.0f);
+        const vec::detail::const_streams<float, 3> s{in.data(), in.data(), in.data()};
+        const vec::detail::streams<float, 3> rs{r.data(), r.data() + stride, r.data() + 2 * stride};
+        vec::detail::soa_normalize(s, rs, n);
+        vec::detail::soa_cross(s, s, rs, n);
+        vec::detail::soa_norm_squared(s, r.data(), n, true);
+        for (std::size_t c = 0; c < 3; ++c)
+            for (std::size_t i = n; i < stride; ++i)
+                assert(r[c * stride + i] == -7.0f);
+    }
+}
+
+void test_wide()
+{
+    for (const std::size_t n : {0, 1, 15, 16, 17, 33, 1000})
+    {
+        check_wide<3>(n);
+        check_wide<4>(n);
+    }
+    test_masked_tails();
+}
+
+int main()
+{
+    test_element_access();
+    test_arithmetic();
+    test_products();
+    test_norms();
+    test_sign_pow();
+    test_integer_edges();
+    test_wide();
+    return 0;
+}
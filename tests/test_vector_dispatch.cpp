@@ -0,0 +1,162 @@
+#include <vector_dispatch.hpp>
+#include <vector_random.hpp>
+
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+constexpr vec::simd_level levels[] = {vec::simd_level::baseline, vec::simd_level::sse4_2, vec::simd_level::avx2,
+                                      vec::simd_level::avx512};
+
+// Sizes around the block length exercise full blocks and partial tails
+constexpr std::size_t sizes[] = {0, 1, 13, vec::kernel_block + 1, 1000};
+
+[[nodiscard]] bool approx_equal(double a, double b, double e)
+{
+    return std::fabs(a - b) <= e * (1.0 + std::fabs(b));
+}
+
+template <typename V>
+[[nodiscard]] bool components_equal(const V &a, const V &b, double e)
+{
+    for (std::size_t c = 0; c < vec::detail::vector_traits<V>::size; ++c)
+        if (!approx_equal(a[c], b[c], e))
+            return false;
+    return true;
+}
+
+template <typename V>
+std::vector<V> make_vectors(std::size_t n, std::uint64_t seed)
+{
+    std::vector<V> v(n);
+    vec::Philox4x32 rng{seed};
+    for (V &p : v)
+        for (std::size_t c = 0; c < vec::detail::vector_traits<V>::size; ++c)
+            p[c] = static_cast<vec::detail::scalar_t<V>>(static_cast<int>(rng() >> 20) - 2048);
+    return v;
+}
+
+void test_levels()
+{
+    static_assert(vec::parse_simd_level("avx2") == vec::simd_level::avx2);
+    static_assert(vec::parse_simd_level("sse4.2") == vec::simd_level::sse4_2);
+    static_assert(!vec::parse_simd_level("AVX2") && !vec::parse_simd_level(""));
+    for (const vec::simd_level level : levels)
+        assert(vec::parse_simd_level(vec::simd_level_name(level)) == level);
+
+    // Forced levels are capped by the CPU; unknown names are ignored
+    static_assert(vec::select_simd_level("sse4.2", vec::simd_level::avx512) == vec::simd_level::sse4_2);
+    static_assert(vec::select_simd_level("avx512", vec::simd_level::avx2) == vec::simd_level::avx2);
+    static_assert(vec::select_simd_level("fast", vec::simd_level::avx2) == vec::simd_level::avx2);
+    static_assert(vec::select_simd_level(nullptr, vec::simd_level::baseline) == vec::simd_level::baseline);
+
+    // The ctest run with VECTORS_SIMD_LEVEL set checks the override
+    assert(vec::active_simd_level() ==
+           vec::select_simd_level(std::getenv("VECTORS_SIMD_LEVEL"), vec::detect_simd_level()));
+#if !defined(VECTORS_DISPATCH)
+    assert(vec::detect_simd_level() == vec::simd_level::baseline);
+#endif
+}
+
+// Every level the CPU runs gives the results of the serial kernels
+template <typename V>
+void check_kernels(vec::simd_level level, double e)
+{
+    using T = vec::detail::scalar_t<V>;
+    using R = vec::detail::norm_t<V>;
+    using namespace vec::detail;
+    for (const std::size_t n : sizes)
+    {
+        const std::vector<V> a{make_vectors<V>(n, 1)};
+        const std::vector<V> b{make_vectors<V>(n, 2)};
+
+        std::vector<V> expected(n);
+        std::vector<V> out(n);
+        vec::normalize(a.data(), expected.data(), n);
+        kernel_for<normalize_kernel, const V *, V *, std::size_t>(level)(a.data(), out.data(), n);
+        for (std::size_t i = 0; i < n; ++i)
+            assert(components_equal(out[i], expected[i], e));
+
+        std::vector<R> r_expected(n);
+        std::vector<R> r(n);
+        vec::dot_many(a.data(), b.data(), r_expected.data(), n);
+        kernel_for<dot_many_kernel, const V *, const V *, R *, std::size_t>(level)(a.data(), b.data(), r.data(), n);
+        for (std::size_t i = 0; i < n; ++i)
+            assert(approx_equal(r[i], r_expected[i], e));
+
+        vec::length_many(a.data(), r_expected.data(), n);
+        kernel_for<length_many_kernel, const V *, R *, std::size_t>(level)(a.data(), r.data(), n);
+        for (std::size_t i = 0; i < n; ++i)
+            assert(approx_equal(r[i], r_expected[i], e));
+
+        expected = b;
+        out = b;
+        vec::axpy(T(3), a.data(), expected.data(), n);
+        kernel_for<axpy_kernel, T, const V *, V *, std::size_t>(level)(T(3), a.data(), out.data(), n);
+        for (std::size_t i = 0; i < n; ++i)
+            assert(components_equal(out[i], expected[i], e));
+    }
+}
+
+void test_kernels()
+{
+    for (const vec::simd_level level : levels)
+    {
+        if (level > vec::detect_simd_level())
+            break;
+        check_kernels<Vector2d>(level, 1e-14);
+        check_kernels<Vector3f>(level, 1e-6);
+        check_kernels<Vector4f>(level, 1e-6);
+        check_kernels<Vector3i>(level, 0.0);
+    }
+}
+
+void test_dispatched()
+{
+    const std::size_t n{700};
+    const std::vector<Vector3f> a{make_vectors<Vector3f>(n, 3)};
+    const std::vector<Vector3f> b{make_vectors<Vector3f>(n, 4)};
+
+    std::vector<Vector3f> expected(n);
+    std::vector<Vector3f> out(n);
+    vec::normalize_fast(a.data(), expected.data(), n);
+    vec::dispatched::normalize_fast(a.data(), out.data(), n);
+    for (std::size_t i = 0; i < n; ++i)
+        assert(components_equal(out[i], expected[i], 1e-6));
+
+    vec::cross_many(a.data(), b.data(), expected.data(), n);
+    vec::dispatched::cross_many(a.data(), b.data(), out.data(), n);
+    for (std::size_t i = 0; i < n; ++i)
+        assert(components_equal(out[i], expected[i], 1e-6));
+
+    // In place, as the serial kernel allows
+    out = a;
+    vec::normalize(a.data(), expected.data(), n);
+    vec::dispatched::normalize(out.data(), out.data(), n);
+    for (std::size_t i = 0; i < n; ++i)
+        assert(components_equal(out[i], expected[i], 1e-6));
+
+    // Exact 64-bit squared norms of int vectors
+    const std::vector<Vector4i> c{make_vectors<Vector4i>(n, 5)};
+    std::vector<std::uint64_t> norms(n);
+    vec::dispatched::norm_squared_many(c.data(), norms.data(), n);
+    for (std::size_t i = 0; i < n; ++i)
+        assert(norms[i] == c[i].norm_squared_wide());
+
+    std::vector<float> lengths(n);
+    vec::dispatched::axpy(0.5f, a.data(), out.data(), n);
+    vec::dispatched::dot_many(a.data(), b.data(), lengths.data(), n);
+    vec::dispatched::length_many(a.data(), lengths.data(), n);
+    for (std::size_t i = 0; i < n; ++i)
+        assert(approx_equal(lengths[i], a[i].length(), 1e-6));
+}
+
+int main()
+{
+    test_levels();
+    test_kernels();
+    test_dispatched();
+    return 0;
+}
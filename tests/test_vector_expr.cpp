@@ -0,0 +1,109 @@
+#include <vector_expr.hpp>
+
+#include <cassert>
+#include <cmath>
+#include <type_traits>
+
+// Inputs are small dyadic values, so every intermediate result is exact and
+// lazy and eager evaluation must agree bit for bit (with or without FMA contraction)
+
+void test_vector_expressions()
+{
+    constexpr Vector3d a(1.0, 2.0, -3.0);
+    constexpr Vector3d b(0.5, 0.25, 4.0);
+    constexpr Vector3d c(-1.0, 1.0, 2.0);
+
+    // Evaluated at compile time, same result as the eager operators
+    constexpr Vector3d r1 = vec::lazy(a) + vec::lazy(b) * 2.0 - c;
+    static_assert(r1 == a + b * 2.0 - c);
+    constexpr Vector3d r2 = vec::evaluate(2.0 * vec::lazy(a) / b);
+    static_assert(r2 == a * 2.0 / b);
+    constexpr Vector3d r3 = -(vec::lazy(a) - 1.0);
+    static_assert(r3 == -(a - 1.0));
+
+    // Types
+    static_assert(std::is_same_v<decltype(vec::evaluate(vec::lazy(a) + b)), Vector3d>);
+    static_assert(std::is_same_v<decltype(vec::evaluate(vec::lazy(Vector4i()) * 2)), Vector4i>);
+
+    // Runtime and in-place
+    Vector3d r{a};
+    vec::assign(r, vec::lazy(r) * 0.5 + r);
+    assert(r == a * 0.5 + a);
+
+    constexpr Vector4i vi(1, -2, 3, 4);
+    const Vector4i ri = vec::lazy(vi) * vi - 1;
+    assert(ri == vi * vi - 1);
+
+    const VectorN<float, 8> f(1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f);
+    const VectorN<float, 8> rf = vec::lazy(f) / 4.0f + f;
+    assert(rf == f / 4.0f + f);
+}
+
+void test_array_expressions()
+{
+    const Vector3dArray a{Vector3d(1.0, 2.0, 3.0), Vector3d(-3.0, 4.0, 0.5), Vector3d(0.5, 0.25, -8.0)};
+    const Vector3dArray b{Vector3d(2.0, 2.0, 1.0), Vector3d(1.0, -1.0, 0.25), Vector3d(4.0, 0.5, 2.0)};
+    const Vector3d v(1.0, -1.0, 0.5);
+
+    // Arrays, broadcast vectors and scalars in one pass
+    const Vector3dArray r = vec::lazy(a) * 3.0 + b - v;
+    const Vector3dArray expected{a * 3.0 + b - v};
+    assert(r.size() == a.size());
+    for (std::size_t i = 0; i < a.size(); ++i)
+        assert(r[i] == expected[i]);
+
+    static_assert(std::is_same_v<decltype(vec::evaluate(vec::lazy(a) / b)), Vector3dArray>);
+
+    // In place: each element only depends on the same element of the operands
+    Vector3dArray p{a};
+    vec::assign(p, vec::lazy(p) - b * 0.5);
+    for (std::size_t i = 0; i < a.size(); ++i)
+        assert(p[i] == a[i] - b[i] * 0.5);
+
+    // Output resized to the expression
+    Vector3dArray out;
+    vec::assign(out, -vec::lazy(b));
+    assert(out.size() == b.size() && out[2] == -b[2]);
+
+    // Integer arrays
+    const Vector2iArray ia{Vector2i(1, 2), Vector2i(-3, 4)};
+    const Vector2iArray ir = 2 * vec::lazy(ia) + ia / 2;
+    assert(ir[0] == Vector2i(2, 5) && ir[1] == Vector2i(-7, 10));
+}
+
+void test_fma()
+{
+    constexpr Vector3d a(1.0, 2.0, -3.0);
+    constexpr Vector3d b(0.5, 0.25, 4.0);
+    constexpr Vector3d c(-1.0, 1.0, 2.0);
+
+    // Exact inputs: fused and unfused agree
+    const Vector3d r = vec::fma(vec::lazy(a), b, c);
+    assert(r == a * b + c);
+
+    const Vector3dArray pos{a, b};
+    const Vector3dArray vel{c, c};
+    Vector3dArray next;
+    vec::assign(next, vec::fma(vec::lazy(vel), 0.5, pos));
+    assert(next[0] == c * 0.5 + a && next[1] == c * 0.5 + b);
+
+    // (1 + e)(1 - e) - 1 = -e^2 is only representable with a single rounding
+    const double e{std::ldexp(1.0, -30)};
+    const Vector2d x(1.0 + e, 1.0);
+    const Vector2d y(1.0 - e, 1.0);
+    const Vector2d fused = vec::fma(x, y, vec::lazy(Vector2d(-1.0, -1.0)));
+#if defined(VECTORS_HAS_FMA)
+    assert(fused.x == -e * e);
+#else
+    assert(fused.x == (1.0 + e) * (1.0 - e) - 1.0);
+#endif
+    assert(fused.y == 0.0);
+}
+
+int main()
+{
+    test_vector_expressions();
+    test_array_expressions();
+    test_fma();
+    return 0;
+}
@@ -0,0 +1,121 @@
+#include <vector_format.hpp>
+
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+void test_format()
+{
+    assert(vec::format(Vector3i(1, -20, 300)) == "1 -20 300");
+    assert(vec::format(Vector2f(0.1f, 1e30f), ',') == "0.1,1e+30");
+    assert(vec::format(Vector3d(0.1, -2.5, 1.0 / 3.0)) == "0.1 -2.5 0.3333333333333333");
+    assert(vec::format(VectorN<double, 5>(1.0, 2.0, 3.0, 4.0, 5.0)) == "1 2 3 4 5");
+
+    // Shortest round-trip text for extreme values
+    const Vector4d extremes(std::numeric_limits<double>::lowest(), std::numeric_limits<double>::denorm_min(),
+                            -std::numeric_limits<double>::min(), std::numeric_limits<double>::epsilon());
+    const std::string text{vec::format(extremes)};
+    assert((text.size() <= vec::max_format_chars<double, 4>));
+    assert(vec::parse_vector4<double>(text) == extremes);
+
+    // Too small a buffer
+    char buffer[8];
+    const std::to_chars_result r{vec::format(buffer, buffer + sizeof(buffer), Vector3f(1.5f, 2.5f, 3.5f))};
+    assert(r.ec == std::errc::value_too_large);
+    const std::to_chars_result ok{vec::format(buffer, buffer + sizeof(buffer), Vector3i(1, 2, 3))};
+    assert(ok.ec == std::errc{} && std::string(buffer, ok.ptr) == "1 2 3");
+}
+
+void test_parse()
+{
+    assert(vec::parse_vector3("1 2 3") == Vector3f(1.0f, 2.0f, 3.0f));
+    assert(vec::parse_vector3("1,2,3") == Vector3f(1.0f, 2.0f, 3.0f));
+    assert(vec::parse_vector3("  1.5,\t-2e3 , +0.25  ") == Vector3f(1.5f, -2000.0f, 0.25f));
+    assert(vec::parse_vector2<int>("7 -8") == Vector2i(7, -8));
+    assert(vec::parse_vector4<double>("0.1 0.2 0.3 0.4") == Vector4d(0.1, 0.2, 0.3, 0.4));
+
+    // The operator<< form
+    std::ostringstream oss{};
+    oss << Vector3f(1.5f, -2.0f, 3.0f);
+    assert(vec::parse_vector3(oss.str()) == Vector3f(1.5f, -2.0f, 3.0f));
+    using Vector5i = VectorN<int, 5>;
+    assert(vec::parse_vector<Vector5i>("Vector5(1, 2, 3, 4, 5)") == Vector5i(1, 2, 3, 4, 5));
+
+    const auto inf{vec::parse_vector2<double>("inf -inf")};
+    assert(inf && std::isinf(inf->x) && inf->y < 0);
+
+    // Malformed input
+    for (const char *bad : {"", "1 2", "1 2 3 4", "1,,2,3", "1 2 x", "1-2 3", "Vector3(x=1, y=2, z=3", "++1 2 3"})
+        assert(!vec::parse_vector3(bad));
+    assert(!vec::parse_vector3<int>("1.5 2 3"));
+
+    // from_chars contract: ptr past the vector, v untouched on failure
+    const char text[] = "1 2 3; 4 5 6";
+    Vector3f v(9.0f, 9.0f, 9.0f);
+    std::from_chars_result r{vec::parse(text, text + 12, v)};
+    assert(r.ec == std::errc{} && r.ptr == text + 5 && v == Vector3f(1.0f, 2.0f, 3.0f));
+    r = vec::parse(text + 5, text + 12, v);
+    assert(r.ec == std::errc::invalid_argument && r.ptr == text + 5 && v == Vector3f(1.0f, 2.0f, 3.0f));
+    r = vec::parse(text, text + 3, v);
+    assert(r.ec == std::errc::invalid_argument);
+
+    const char huge[] = "1 1e999 3";
+    r = vec::parse(huge, huge + 9, v);
+    assert(r.ec == std::errc::result_out_of_range && v == Vector3f(1.0f, 2.0f, 3.0f));
+}
+
+void test_round_trip()
+{
+    // Every float written by format() reads back exactly
+    for (float f = 1e-30f; f < 1e30f; f *= 1.37f)
+    {
+        const Vector3f v(f, -f / 3.0f, std::nextafter(f, 0.0f));
+        assert(vec::parse_vector3(vec::format(v)) == v);
+    }
+}
+
+void test_parse_vectors()
+{
+    const std::string text{"1 2 3\n4,5,6\r\n\n  \nVector3(x=7, y=8, z=9)\n10 11 12"};
+    std::vector<Vector3d> out;
+    std::from_chars_result r{vec::parse_vectors(text.data(), text.data() + text.size(), out)};
+    assert(r.ec == std::errc{} && r.ptr == text.data() + text.size());
+    assert(out.size() == 4 && out[1] == Vector3d(4.0, 5.0, 6.0) && out[3] == Vector3d(10.0, 11.0, 12.0));
+
+    // Stops at the first bad line, keeping the vectors before it
+    const std::string bad{"1 2 3\n4 5 6 7\n8 9 10\n"};
+    out.clear();
+    r = vec::parse_vectors(bad.data(), bad.data() + bad.size(), out);
+    assert(r.ec == std::errc::invalid_argument && r.ptr == bad.data() + 6 && out.size() == 1);
+}
+
+void test_stream_input()
+{
+    std::istringstream iss{"1 2 3\n  4, 5, 6 Vector3(x=7, y=8, z=9) 10 11"};
+    Vector3i a, b, c, d;
+    iss >> a >> b >> c;
+    assert(iss && a == Vector3i(1, 2, 3) && b == Vector3i(4, 5, 6) && c == Vector3i(7, 8, 9));
+    iss >> d;
+    assert(iss.fail() && d == Vector3i(0, 0, 0));
+
+    // Round trip through operator<< and operator>>
+    std::stringstream ss{};
+    ss << Vector2d(0.5, -0.25) << "\n" << Vector4f(1.0f, 2.0f, 3.0f, 4.0f);
+    Vector2d e;
+    Vector4f f;
+    ss >> e >> f;
+    assert(ss && e == Vector2d(0.5, -0.25) && f == Vector4f(1.0f, 2.0f, 3.0f, 4.0f));
+}
+
+int main()
+{
+    test_format();
+    test_parse();
+    test_round_trip();
+    test_parse_vectors();
+    test_stream_input();
+    return 0;
+}
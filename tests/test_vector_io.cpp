@@ -0,0 +1,149 @@
+#include <vector_io.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+const std::string path{(std::filesystem::temp_directory_path() / "test_vector_io.vec").string()};
+
+std::vector<Vector3f> make_points(std::size_t n)
+{
+    std::vector<Vector3f> points;
+    for (std::size_t i = 0; i < n; ++i)
+        points.emplace_back(0.1f * i, -1.0f / (i + 1), 3.0e30f + i);
+    return points;
+}
+
+template <typename F>
+bool throws(F f)
+{
+    try
+    {
+        f();
+    }
+    catch (const vec::vector_file_error &)
+    {
+        return true;
+    }
+    return false;
+}
+
+void test_round_trip()
+{
+    // Exact, bit for bit
+    const std::vector<Vector3f> points{make_points(1000)};
+    vec::write_vectors(path, points.data(), points.size());
+    assert(std::filesystem::file_size(path) == 32 + points.size() * sizeof(Vector3f));
+    assert(vec::read_vectors<Vector3f>(path) == points);
+
+    const std::vector<Vector4i> ints{Vector4i(1, -2, 3, -4), Vector4i(5, 6, 7, 8)};
+    vec::write_vectors(path, ints.data(), ints.size());
+    assert(vec::read_vectors<Vector4i>(path) == ints);
+
+    vec::write_vectors<Vector2d>(path, nullptr, 0);
+    assert(vec::read_vectors<Vector2d>(path).empty());
+}
+
+void test_streaming_writer()
+{
+    const std::vector<Vector3f> points{make_points(1000)};
+    {
+        vec::VectorFileWriter<Vector3f> writer(path);
+        for (std::size_t i = 0; i < points.size(); i += 300)
+            writer.write(points.data() + i, std::min<std::size_t>(300, points.size() - i));
+        assert(writer.size() == points.size());
+        // The destructor fills in the count
+    }
+    assert(vec::read_vectors<Vector3f>(path) == points);
+}
+
+void test_mapped()
+{
+    const std::vector<Vector3f> points{make_points(1000)};
+    vec::write_vectors(path, points.data(), points.size());
+
+    vec::MappedVectorFile<Vector3f> file(path);
+    assert(file.size() == points.size() && !file.empty());
+    assert(reinterpret_cast<std::uintptr_t>(file.data()) % 32 == 0);
+    assert(std::equal(file.begin(), file.end(), points.begin()));
+    assert(file[999] == points[999]);
+
+    vec::MappedVectorFile<Vector3f> moved{std::move(file)};
+    assert(moved.size() == points.size() && file.empty() && moved[1] == points[1]);
+}
+
+void test_errors()
+{
+    const std::vector<Vector3f> points{make_points(10)};
+    vec::write_vectors(path, points.data(), points.size());
+
+    // Wrong vector type
+    assert(throws([] { (void)vec::read_vectors<Vector3d>(path); }));
+    assert(throws([] { (void)vec::read_vectors<Vector3i>(path); }));
+    assert(throws([] { vec::MappedVectorFile<Vector4f> file(path); }));
+
+    // Truncated data
+    std::filesystem::resize_file(path, 32 + 9 * sizeof(Vector3f));
+    assert(throws([] { (void)vec::read_vectors<Vector3f>(path); }));
+    assert(throws([] { vec::MappedVectorFile<Vector3f> file(path); }));
+
+    // Not a vector file, empty file, missing file
+    std::ofstream(path) << "Vector3(x=1, y=2, z=3)";
+    assert(throws([] { (void)vec::read_vectors<Vector3f>(path); }));
+    std::ofstream(path, std::ios::trunc).close();
+    assert(throws([] { vec::MappedVectorFile<Vector3f> file(path); }));
+    std::filesystem::remove(path);
+    assert(throws([] { (void)vec::read_vectors<Vector3f>(path); }));
+    assert(throws([] { vec::MappedVectorFile<Vector3f> file(path); }));
+
+    // Messages name the file and the mismatch
+    std::string message;
+    try
+    {
+        vec::write_vectors(path, points.data(), points.size());
+        (void)vec::read_vectors<Vector2f>(path);
+    }
+    catch (const vec::vector_file_error &e)
+    {
+        message = e.what();
+    }
+    assert(message == path + ": holds float32[3] vectors, expected float32[2]");
+}
+
+void test_byte_order()
+{
+    // A file written on a machine of the other byte order
+    const std::vector<Vector2d> points{Vector2d(1.5, -2.0), Vector2d(1e300, 0.1)};
+    vec::write_vectors(path, points.data(), points.size());
+    std::vector<char> bytes(32 + points.size() * sizeof(Vector2d));
+    std::ifstream(path, std::ios::binary).read(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    const auto reverse = [&bytes](std::size_t offset, std::size_t size) {
+        std::reverse(bytes.begin() + static_cast<std::ptrdiff_t>(offset),
+                     bytes.begin() + static_cast<std::ptrdiff_t>(offset + size));
+    };
+    reverse(4, 4);
+    reverse(8, 2);
+    reverse(12, 4);
+    reverse(16, 8);
+    for (std::size_t i = 32; i < bytes.size(); i += sizeof(double))
+        reverse(i, sizeof(double));
+    std::ofstream(path, std::ios::binary).write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+
+    assert(vec::read_vectors<Vector2d>(path) == points);
+    assert(throws([] { vec::MappedVectorFile<Vector2d> file(path); }));
+}
+
+int main()
+{
+    test_round_trip();
+    test_streaming_writer();
+    test_mapped();
+    test_errors();
+    test_byte_order();
+    std::filesystem::remove(path);
+    return 0;
+}
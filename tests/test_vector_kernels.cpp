@@ -0,0 +1,238 @@
+#include <vector_kernels.hpp>
+#include <vector_random.hpp>
+
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+[[nodiscard]] bool approx_equal(double a, double b, double e = 1e-10)
+{
+    return std::fabs(a - b) < e;
+}
+
+template <typename T>
+[[nodiscard]] bool approx_equal(const Vector3<T> &a, const Vector3<T> &b, double e = 1e-10)
+{
+    return approx_equal(a.x, b.x, e) && approx_equal(a.y, b.y, e) && approx_equal(a.z, b.z, e);
+}
+
+// Exact equality is not used for floating-point results: FMA contraction
+// may differ between the kernels and the member functions.
+
+// Sizes around the block length exercise full blocks and partial tails
+constexpr std::size_t sizes[] = {0, 1, 7, vec::kernel_block - 1, vec::kernel_block, vec::kernel_block + 1, 1000};
+
+template <typename V>
+std::vector<V> make_vectors(std::size_t n);
+
+template <>
+std::vector<Vector3f> make_vectors(std::size_t n)
+{
+    std::vector<Vector3f> v;
+    for (std::size_t i = 0; i < n; ++i)
+        v.emplace_back(0.5f * i - 3.0f, 1.0f - 0.25f * i, (i % 7) * 1.5f);
+    return v;
+}
+
+template <>
+std::vector<Vector2d> make_vectors(std::size_t n)
+{
+    std::vector<Vector2d> v;
+    for (std::size_t i = 0; i < n; ++i)
+        v.emplace_back(0.1 * i, i % 3 == 0 ? 0.0 : -2.0);
+    return v;
+}
+
+// Components spanning the whole int range, so products overflow int
+template <>
+std::vector<Vector3i> make_vectors(std::size_t n)
+{
+    std::vector<Vector3i> v;
+    vec::Philox4x32 rng{1};
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const int x{static_cast<int>(rng())};
+        const int y{static_cast<int>(rng())};
+        const int z{static_cast<int>(rng())};
+        v.emplace_back(x, y, i % 9 == 0 ? std::numeric_limits<int>::min() : z);
+    }
+    return v;
+}
+
+template <>
+std::vector<Vector4i> make_vectors(std::size_t n)
+{
+    std::vector<Vector4i> v;
+    for (std::size_t i = 0; i < n; ++i)
+        v.emplace_back(static_cast<int>(i % 11), -3, static_cast<int>(i % 5), 2);
+    return v;
+}
+
+void test_normalize()
+{
+    for (const std::size_t n : sizes)
+    {
+        const std::vector<Vector3f> in{make_vectors<Vector3f>(n)};
+        std::vector<Vector3f> out(n);
+        vec::normalize(in.data(), out.data(), n);
+        for (std::size_t i = 0; i < n; ++i)
+            assert(approx_equal(out[i], in[i].normalize(), 1e-6));
+
+        // In place
+        std::vector<Vector3f> inplace{in};
+        vec::normalize(inplace.data(), inplace.data(), n);
+        for (std::size_t i = 0; i < n; ++i)
+            assert(inplace[i] == out[i]);
+
+        const std::vector<Vector4i> ints{make_vectors<Vector4i>(n)};
+        std::vector<Vector4i> ints_out(n);
+        vec::normalize(ints.data(), ints_out.data(), n);
+        for (std::size_t i = 0; i < n; ++i)
+            assert(ints_out[i] == ints[i].normalize());
+    }
+
+    // Full-range and extreme integer vectors follow the members' exact path
+    constexpr int lo{std::numeric_limits<int>::min()};
+    constexpr int hi{std::numeric_limits<int>::max()};
+    std::vector<Vector3i> ints{make_vectors<Vector3i>(1000)};
+    ints[3] = Vector3i(lo, 0, 0);
+    ints[4] = Vector3i(hi, -hi, hi);
+    ints[5] = Vector3i(2000000000, 2000000000, 0);
+    ints[6] = Vector3i(lo, lo, lo);
+    std::vector<Vector3i> ints_out(ints.size());
+    vec::normalize(ints.data(), ints_out.data(), ints.size());
+    for (std::size_t i = 0; i < ints.size(); ++i)
+        assert(ints_out[i] == ints[i].normalize());
+    assert(ints_out[3] == Vector3i(-1, 0, 0));
+
+    const Vector4i wrapped[] = {Vector4i(lo, lo, lo, lo), Vector4i(hi, hi, hi, hi), Vector4i(lo, hi, 0, 1)};
+    Vector4i wrapped_out[3];
+    vec::normalize(wrapped, wrapped_out, 3);
+    for (std::size_t i = 0; i < 3; ++i)
+        assert(wrapped_out[i] == wrapped[i].normalize());
+
+    // Zero vectors are left unchanged
+    const Vector2d zero[] = {Vector2d(0.0, 0.0)};
+    Vector2d zero_out[1];
+    vec::normalize(zero, zero_out, 1);
+    assert(zero_out[0] == Vector2d(0.0, 0.0));
+}
+
+void test_normalize_fast()
+{
+    for (const std::size_t n : sizes)
+    {
+        const std::vector<Vector3f> in{make_vectors<Vector3f>(n)};
+        std::vector<Vector3f> out(n);
+        vec::normalize_fast(in.data(), out.data(), n);
+        for (std::size_t i = 0; i < n; ++i)
+            assert(approx_equal(out[i], in[i].normalize_fast(), 1e-6));
+    }
+
+    // Documented bound: within 1e-6 of the exact unit vector over a wide range of magnitudes
+    std::vector<Vector3f> in;
+    for (int e = -30; e <= 30; ++e)
+        for (int i = 1; i <= 200; ++i)
+            in.emplace_back(std::ldexp(0.37f * i, e), std::ldexp(-1.0f + 0.01f * i, e), std::ldexp(0.5f, e));
+    std::vector<Vector3f> out(in.size());
+    vec::normalize_fast(in.data(), out.data(), in.size());
+    for (std::size_t i = 0; i < in.size(); ++i)
+    {
+        const Vector3d exact{static_cast<Vector3d>(in[i]).normalize()};
+        assert(approx_equal(static_cast<Vector3d>(out[i]), exact, 1e-6));
+    }
+
+    // Subnormal and infinite squared norms mixed into one block with normal ones
+    const std::vector<Vector3f> edges{Vector3f(1e-19f, 0.0f, 0.0f), Vector3f(3.0f, 4.0f, 0.0f), Vector3f(1e20f, -1e20f, 0.0f),
+                                      Vector3f(), Vector3f(0.0f, -1e-22f, 0.0f), Vector3f(1.0f, 2.0f, 2.0f)};
+    std::vector<Vector3f> edges_out(edges.size());
+    vec::normalize_fast(edges.data(), edges_out.data(), edges.size());
+    for (std::size_t i = 0; i < edges.size(); ++i)
+        assert(approx_equal(edges_out[i], edges[i].normalize_fast(), 1e-6));
+    assert(approx_equal(edges_out[0], Vector3f(1.0f, 0.0f, 0.0f), 1e-6));
+    assert(edges_out[2] == Vector3f());
+}
+
+void test_dot_cross()
+{
+    for (const std::size_t n : sizes)
+    {
+        const std::vector<Vector3f> a{make_vectors<Vector3f>(n)};
+        std::vector<Vector3f> b{a.rbegin(), a.rend()};
+        std::vector<float> dots(n);
+        std::vector<Vector3f> crosses(n);
+        vec::dot_many(a.data(), b.data(), dots.data(), n);
+        vec::cross_many(a.data(), b.data(), crosses.data(), n);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            assert(approx_equal(dots[i], a[i].dot(b[i]), 1e-4));
+            assert(approx_equal(crosses[i], a[i].cross(b[i]), 1e-4));
+        }
+
+        const std::vector<Vector4i> c{make_vectors<Vector4i>(n)};
+        std::vector<int> int_dots(n);
+        vec::dot_many(c.data(), c.data(), int_dots.data(), n);
+        for (std::size_t i = 0; i < n; ++i)
+            assert(int_dots[i] == c[i].dot(c[i]));
+
+        // Widening dot products in 64 bits; inputs within +-2^30 so the sums fit
+        std::vector<Vector3i> d{make_vectors<Vector3i>(n)};
+        for (Vector3i &v : d)
+            v = Vector3i(v.x / 2, v.y / 2, v.z / 2);
+        const std::vector<Vector3i> e{d.rbegin(), d.rend()};
+        std::vector<std::int64_t> wide_dots(n);
+        vec::dot_many(d.data(), e.data(), wide_dots.data(), n);
+        for (std::size_t i = 0; i < n; ++i)
+            assert(wide_dots[i] == d[i].dot_wide(e[i]));
+    }
+}
+
+void test_axpy()
+{
+    for (const std::size_t n : sizes)
+    {
+        const std::vector<Vector2d> x{make_vectors<Vector2d>(n)};
+        std::vector<Vector2d> y(n, Vector2d(1.0, -1.0));
+        vec::axpy(2.5, x.data(), y.data(), n);
+        for (std::size_t i = 0; i < n; ++i)
+            assert(approx_equal(y[i].x, 1.0 + x[i].x * 2.5) && approx_equal(y[i].y, -1.0 + x[i].y * 2.5));
+    }
+}
+
+void test_length()
+{
+    for (const std::size_t n : sizes)
+    {
+        const std::vector<Vector2d> v{make_vectors<Vector2d>(n)};
+        std::vector<double> lengths(n);
+        std::vector<double> squared(n);
+        vec::length_many(v.data(), lengths.data(), n);
+        vec::norm_squared_many(v.data(), squared.data(), n);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            assert(approx_equal(lengths[i], v[i].length()));
+            assert(approx_equal(squared[i], v[i].norm_squared()));
+        }
+
+        // Exact squared norms of full-range integer vectors
+        const std::vector<Vector3i> w{make_vectors<Vector3i>(n)};
+        std::vector<std::uint64_t> exact(n);
+        vec::norm_squared_many(w.data(), exact.data(), n);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            assert(exact[i] == w[i].norm_squared_wide());
+            assert(i % 9 != 0 || exact[i] >= std::uint64_t{1} << 62);
+        }
+    }
+}
+
+int main()
+{
+    test_normalize();
+    test_normalize_fast();
+    test_dot_cross();
+    test_axpy();
+    test_length();
+    return 0;
+}
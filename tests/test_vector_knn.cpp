@@ -0,0 +1,103 @@
+#include <vector_knn.hpp>
+#include <vector_random.hpp>
+
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+using Vector16f = VectorN<float, 16>;
+using Vector5d = VectorN<double, 5>;
+
+// Deterministic vectors with components in [-1, 1), integers in (-100, 100)
+template <typename V>
+std::vector<V> make_vectors(std::size_t n, std::uint64_t seed)
+{
+    using T = vec::detail::scalar_t<V>;
+    constexpr std::size_t N{vec::detail::vector_traits<V>::size};
+    const double scale{std::is_integral_v<T> ? 100.0 : 1.0};
+    std::vector<VectorN<double, N>> d(n);
+    vec::Philox4x32 rng{seed};
+    vec::generate(rng, vec::UniformBox<VectorN<double, N>>(-scale, scale), d.data(), n);
+    std::vector<V> v;
+    for (const VectorN<double, N> &p : d)
+        v.push_back(static_cast<VectorN<T, N>>(p));
+    return v;
+}
+
+[[nodiscard]] bool approx_equal(double a, double b, double e)
+{
+    return std::fabs(a - b) <= e * (1.0 + std::fabs(b));
+}
+
+template <typename V>
+void check_knn(std::size_t m, std::size_t n, std::size_t k, double e)
+{
+    using D = vec::detail::distance_t<V>;
+    const std::vector<V> queries{make_vectors<V>(m, 1)};
+    const std::vector<V> database{make_vectors<V>(n, 2)};
+    vec::ThreadPool pool(3);
+
+    std::vector<vec::Neighbor<D>> found(m * k);
+    vec::knn_brute_force(queries.data(), m, database.data(), n, k, found.data(), pool);
+
+    std::vector<D> distances(m * n);
+    std::vector<D> dots(m * n);
+    vec::squared_distances(queries.data(), m, database.data(), n, distances.data(), pool);
+    vec::dot_products(queries.data(), m, database.data(), n, dots.data(), pool);
+
+    for (std::size_t i = 0; i < m; ++i)
+    {
+        // Reference: sort every database vector by (a - b).norm_squared()
+        std::vector<vec::Neighbor<D>> expected;
+        for (std::size_t j = 0; j < n; ++j)
+        {
+            expected.push_back({j, (queries[i] - database[j]).norm_squared()});
+            assert(approx_equal(distances[i * n + j], expected.back().distance_squared, e));
+            assert(approx_equal(dots[i * n + j], static_cast<D>(queries[i].dot(database[j])), e));
+        }
+        std::sort(expected.begin(), expected.end());
+
+        // Same neighbours unless two distances are within rounding of each other
+        for (std::size_t r = 0; r < k; ++r)
+        {
+            const vec::Neighbor<D> &a{found[i * k + r]};
+            assert(approx_equal(a.distance_squared, expected[r].distance_squared, e));
+            assert(a.index == expected[r].index ||
+                   approx_equal(expected[r].distance_squared, expected[r + (r + 1 < n ? 1 : 0)].distance_squared, e) ||
+                   (r > 0 && approx_equal(expected[r].distance_squared, expected[r - 1].distance_squared, e)));
+        }
+    }
+}
+
+void test_knn()
+{
+    check_knn<Vector4f>(70, 3000, 10, 1e-5);
+    check_knn<Vector3d>(9, 1500, 1, 1e-12);
+    check_knn<Vector16f>(33, 500, 500, 1e-5);
+    check_knn<Vector5d>(130, 100, 7, 1e-12);
+    check_knn<Vector3i>(5, 200, 3, 0.0);
+    check_knn<Vector3Af>(17, 1030, 4, 1e-5);
+}
+
+void test_exact_matches()
+{
+    // A query in the database finds itself at distance 0
+    const std::vector<Vector4f> database{make_vectors<Vector4f>(1000, 5)};
+    std::vector<vec::Neighbor<float>> found(database.size());
+    vec::knn_brute_force(database.data(), database.size(), database.data(), database.size(), 1, found.data());
+    for (std::size_t i = 0; i < database.size(); ++i)
+        assert(found[i].index == i && found[i].distance_squared < 1e-6f);
+
+    // Nothing to do
+    vec::knn_brute_force(database.data(), 0, database.data(), database.size(), 1, found.data());
+    vec::knn_brute_force(database.data(), 5, database.data(), database.size(), 0, found.data());
+}
+
+int main()
+{
+    test_knn();
+    test_exact_matches();
+    return 0;
+}
@@ -0,0 +1,290 @@
+#include <vector_math.hpp>
+
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+// Error of r in units in the last place of T, against a long double reference
+template <typename T>
+[[nodiscard]] double ulp_error(T r, long double ref)
+{
+    const T rounded{static_cast<T>(ref)};
+    if (std::isnan(ref) || std::isnan(r))
+        return std::isnan(ref) && std::isnan(r) ? 0.0 : std::numeric_limits<double>::infinity();
+    if (std::isinf(rounded) || std::isinf(r))
+        return r == rounded ? 0.0 : std::numeric_limits<double>::infinity();
+    const T magnitude{std::fabs(rounded)};
+    const T ulp{std::nextafter(magnitude, std::numeric_limits<T>::infinity()) - magnitude};
+    return static_cast<double>(std::fabs(static_cast<long double>(r) - ref) / ulp);
+}
+
+// Same value, or both NaN; zeros compare their signs
+template <typename T>
+[[nodiscard]] bool same(T a, T b)
+{
+    return (std::isnan(a) && std::isnan(b)) || (a == b && std::signbit(a) == std::signbit(b));
+}
+
+// Uniform in [lo, hi)
+struct sampler
+{
+    std::uint64_t state;
+
+    double operator()(double lo, double hi)
+    {
+        state = state * 6364136223846793005u + 1442695040888963407u;
+        return lo + (hi - lo) * static_cast<double>(state >> 11) * 0x1p-53;
+    }
+};
+
+constexpr int samples{100000};
+
+template <typename T>
+constexpr bool is_float{sizeof(T) == sizeof(float)};
+
+template <typename T>
+void test_exp_log()
+{
+    sampler s{1};
+    for (int i = 0; i < samples; ++i)
+    {
+        // The whole range of finite nonzero results, and around zero
+        for (const double x : {s(is_float<T> ? -104.0 : -745.0, is_float<T> ? 88.7 : 709.7), s(-1.0, 1.0)})
+        {
+            const T a{static_cast<T>(x)};
+            assert(ulp_error(vec::detail::math_exp(a), std::exp(static_cast<long double>(a))) <= (is_float<T> ? 1 : 2));
+        }
+
+        // Every binade, subnormals included
+        const T b{static_cast<T>(std::exp2(s(is_float<T> ? -149.0 : -1074.0, is_float<T> ? 128.0 : 1024.0)))};
+        assert(ulp_error(vec::detail::math_log(b), std::log(static_cast<long double>(b))) <= 1);
+        const T c{static_cast<T>(s(0.5, 2.0))};
+        assert(ulp_error(vec::detail::math_log(c), std::log(static_cast<long double>(c))) <= 1);
+    }
+}
+
+template <typename T>
+void test_sin_cos()
+{
+    sampler s{2};
+    for (int i = 0; i < samples; ++i)
+        for (const double range : {1e8, 1e3, 4.0})
+        {
+            const T x{static_cast<T>(s(-range, range))};
+            assert(ulp_error(vec::detail::math_sin<false>(x), std::sin(static_cast<long double>(x))) <= 2);
+            assert(ulp_error(vec::detail::math_sin<true>(x), std::cos(static_cast<long double>(x))) <= 2);
+        }
+}
+
+template <typename T>
+void test_atan2()
+{
+    sampler s{3};
+    for (int i = 0; i < samples; ++i)
+    {
+        const T y{static_cast<T>(s(-1.0, 1.0) * std::exp2(s(-20.0, 20.0)))};
+        const T x{static_cast<T>(s(-1.0, 1.0) * std::exp2(s(-20.0, 20.0)))};
+        const long double ref{std::atan2(static_cast<long double>(y), static_cast<long double>(x))};
+        assert(ulp_error(vec::detail::math_atan2(y, x), ref) <= (is_float<T> ? 3 : 2));
+    }
+}
+
+template <typename T>
+void test_pow()
+{
+    sampler s{4};
+    for (int i = 0; i < samples; ++i)
+    {
+        const T x{static_cast<T>(s(0.0, 100.0))};
+        const T y{static_cast<T>(s(-20.0, 20.0))};
+        const long double ref{std::pow(static_cast<long double>(x), static_cast<long double>(y))};
+        const double bound{is_float<T> ? 1.0 : 1.0 + 2.0 * std::fabs(y * std::log(static_cast<double>(x)))};
+        assert(ulp_error(vec::detail::math_pow(x, y), ref) <= bound);
+    }
+
+    // Negative bases: integer exponents keep the sign of odd powers
+    assert(ulp_error(vec::detail::math_pow(T(-2), T(3)), -8.0L) <= 5);
+    assert(ulp_error(vec::detail::math_pow(T(-2), T(-2)), 0.25L) <= 4);
+    assert(vec::detail::math_pow(T(-3), T(1e30)) == std::numeric_limits<T>::infinity());
+}
+
+// Zeros, infinities, NaN and exact points agree with std::
+template <typename T>
+void test_special()
+{
+    constexpr T inf{std::numeric_limits<T>::infinity()};
+    constexpr T nan{std::numeric_limits<T>::quiet_NaN()};
+    const T values[] = {T(0), -T(0), T(1), T(-1), T(2), T(-2), T(0.5), T(-0.5), T(3), inf, -inf, nan,
+                        std::numeric_limits<T>::denorm_min(), std::numeric_limits<T>::max()};
+    for (const T a : values)
+    {
+        if (!std::isfinite(a) || a == 0 || a == 1)
+        {
+            assert(same(vec::detail::math_exp(a), std::exp(a)) || a == 1);
+            assert(same(vec::detail::math_log(a), std::log(a)));
+            assert(std::isnan(vec::detail::math_sin<false>(a)) == std::isnan(std::sin(a)));
+        }
+        assert(same(vec::detail::math_log(-std::fabs(a)), std::log(-std::fabs(a))) || a == 0);
+        for (const T b : values)
+        {
+            if (!std::isfinite(a) || !std::isfinite(b) || a == 0 || b == 0)
+                assert(same(vec::detail::math_atan2(a, b), static_cast<T>(std::atan2(a, b))));
+            if (!std::isfinite(a) || !std::isfinite(b) || a == 0 || b == 0 || a == 1 || b == 1 || a == -1)
+                assert(same(vec::detail::math_pow(a, b), std::pow(a, b)));
+        }
+    }
+    // Subnormal pairs: the ratio test must not push the reduced argument out of the fitted range
+    constexpr T tiny{std::numeric_limits<T>::denorm_min()};
+    const std::pair<T, T> subnormal[] = {{tiny, tiny}, {-tiny, tiny}, {tiny * 5, tiny * 12}, {tiny * 12, -tiny * 5},
+                                         {std::numeric_limits<T>::min() / 2, std::numeric_limits<T>::min() / 3}};
+    for (const auto &[y, x] : subnormal)
+        assert(ulp_error(vec::detail::math_atan2(y, x), std::atan2(static_cast<long double>(y), static_cast<long double>(x))) <= 2);
+    assert(same(vec::detail::math_sin<false>(-T(0)), -T(0)) && vec::detail::math_sin<true>(T(0)) == T(1));
+    assert(vec::detail::math_exp(T(0)) == T(1) && vec::detail::math_log(T(1)) == T(0));
+}
+
+// Within a few ulp component by component: VectorArray runs the kernels at active_simd_level()
+[[nodiscard]] bool near(const Vector4f &a, const Vector4f &b)
+{
+    for (std::size_t c = 0; c < 4; ++c)
+        if (ulp_error(a[c], b[c]) > 4)
+            return false;
+    return true;
+}
+
+// Vectors, structure-of-arrays containers and arrays of vectors all run the same kernels
+void test_vectors()
+{
+    const Vector3f v(0.5f, -2.0f, 10.0f);
+    const Vector3f e{vec::exp(v)};
+    const Vector3f l{vec::log(e)};
+    for (std::size_t c = 0; c < 3; ++c)
+    {
+        assert(ulp_error(e[c], std::exp(static_cast<long double>(v[c]))) <= 1);
+        assert(std::fabs(l[c] - v[c]) <= 1e-5f * std::fabs(v[c]));
+    }
+    const Vector2d r{vec::pow(Vector2d(2.0, 9.0), 0.5)};
+    assert(ulp_error(r.x, std::sqrt(2.0L)) <= 2 && ulp_error(r.y, 3.0L) <= 3);
+    const Vector4d p{vec::pow(Vector4d(2.0, -2.0, 0.0, 4.0), Vector4d(10.0, 3.0, 2.0, -0.5))};
+    assert(ulp_error(p.x, 1024.0L) <= 15 && ulp_error(p.y, -8.0L) <= 5 && p.z == 0.0 && ulp_error(p.w, 0.5L) <= 3);
+    const double quarter{std::atan(1.0)};
+    assert(vec::atan2(Vector2d(1.0, -1.0), Vector2d(0.0, 0.0)) == Vector2d(2.0 * quarter, -2.0 * quarter));
+
+    const std::size_t n{37};
+    sampler s{5};
+    std::vector<Vector4f> in(n);
+    std::vector<Vector4f> other(n);
+    for (std::size_t i = 0; i < n; ++i)
+        for (std::size_t c = 0; c < 4; ++c)
+        {
+            in[i][c] = static_cast<float>(s(-10.0, 10.0));
+            other[i][c] = static_cast<float>(s(0.0, 4.0));
+        }
+    const Vector4fArray a(in.data(), n);
+    const Vector4fArray b(other.data(), n);
+
+    std::vector<Vector4f> out(n);
+    vec::sin_many(in.data(), out.data(), n);
+    const Vector4fArray sines{vec::sin(a)};
+    for (std::size_t i = 0; i < n; ++i)
+        assert(out[i] == vec::sin(in[i]) && near(sines[i], out[i]));
+
+    vec::cos_many(in.data(), out.data(), n);
+    const Vector4fArray cosines{vec::cos(a)};
+    for (std::size_t i = 0; i < n; ++i)
+        assert(out[i] == vec::cos(in[i]) && near(cosines[i], out[i]));
+
+    vec::atan2_many(in.data(), other.data(), out.data(), n);
+    const Vector4fArray angles{vec::atan2(a, b)};
+    for (std::size_t i = 0; i < n; ++i)
+        assert(out[i] == vec::atan2(in[i], other[i]) && near(angles[i], out[i]));
+
+    vec::pow_many(other.data(), in.data(), out.data(), n);
+    const Vector4fArray powers{vec::pow(b, a)};
+    const Vector4fArray squares{vec::pow(b, 2.0f)};
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        assert(out[i] == vec::pow(other[i], in[i]) && near(powers[i], out[i]));
+        assert(near(squares[i], other[i].pow<2>()));
+    }
+
+    // In place
+    out = in;
+    vec::exp_many(out.data(), out.data(), n);
+    vec::log_many(out.data(), out.data(), n);
+    const Vector4fArray logs{vec::log(vec::exp(a))};
+    for (std::size_t i = 0; i < n; ++i)
+        for (std::size_t c = 0; c < 4; ++c)
+            assert(std::fabs(out[i][c] - in[i][c]) <= 1e-5f * (1.0f + std::fabs(in[i][c])) && near(logs[i], out[i]));
+}
+
+// The dispatched copies may contract into FMAs, so they agree within the documented bounds
+void test_dispatched()
+{
+    const std::size_t n{101};
+    sampler s{6};
+    std::vector<Vector3d> in(n);
+    std::vector<Vector3d> other(n);
+    for (std::size_t i = 0; i < n; ++i)
+        for (std::size_t c = 0; c < 3; ++c)
+        {
+            in[i][c] = s(-10.0, 10.0);
+            other[i][c] = s(0.0, 4.0);
+        }
+
+    std::vector<Vector3d> out(n);
+    vec::dispatched::exp_many(in.data(), out.data(), n);
+    for (std::size_t i = 0; i < n; ++i)
+        for (std::size_t c = 0; c < 3; ++c)
+            assert(ulp_error(out[i][c], std::exp(static_cast<long double>(in[i][c]))) <= 2);
+
+    vec::dispatched::log_many(other.data(), out.data(), n);
+    for (std::size_t i = 0; i < n; ++i)
+        for (std::size_t c = 0; c < 3; ++c)
+            assert(ulp_error(out[i][c], std::log(static_cast<long double>(other[i][c]))) <= 1);
+
+    vec::dispatched::sin_many(in.data(), out.data(), n);
+    for (std::size_t i = 0; i < n; ++i)
+        for (std::size_t c = 0; c < 3; ++c)
+            assert(ulp_error(out[i][c], std::sin(static_cast<long double>(in[i][c]))) <= 2);
+
+    vec::dispatched::cos_many(in.data(), out.data(), n);
+    for (std::size_t i = 0; i < n; ++i)
+        for (std::size_t c = 0; c < 3; ++c)
+            assert(ulp_error(out[i][c], std::cos(static_cast<long double>(in[i][c]))) <= 2);
+
+    vec::dispatched::atan2_many(in.data(), other.data(), out.data(), n);
+    for (std::size_t i = 0; i < n; ++i)
+        for (std::size_t c = 0; c < 3; ++c)
+            assert(ulp_error(out[i][c], std::atan2(static_cast<long double>(in[i][c]),
+                                                   static_cast<long double>(other[i][c]))) <= 2);
+
+    vec::dispatched::pow_many(other.data(), in.data(), out.data(), n);
+    for (std::size_t i = 0; i < n; ++i)
+        for (std::size_t c = 0; c < 3; ++c)
+        {
+            const double bound{1.0 + 2.0 * std::fabs(in[i][c] * std::log(other[i][c]))};
+            assert(ulp_error(out[i][c], std::pow(static_cast<long double>(other[i][c]),
+                                                 static_cast<long double>(in[i][c]))) <= bound);
+        }
+}
+
+int main()
+{
+    test_exp_log<float>();
+    test_exp_log<double>();
+    test_sin_cos<float>();
+    test_sin_cos<double>();
+    test_atan2<float>();
+    test_atan2<double>();
+    test_pow<float>();
+    test_pow<double>();
+    test_special<float>();
+    test_special<double>();
+    test_vectors();
+    test_dispatched();
+    return 0;
+}
@@ -0,0 +1,229 @@
+#include <vector_n.hpp>
+#include <vector2.hpp>
+#include <vector3.hpp>
+#include <vector4.hpp>
+
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <type_traits>
+
+[[nodiscard]] bool approx_equal(double a, double b, double e = 1e-10)
+{
+    return std::fabs(a - b) < e;
+}
+
+template <typename T, std::size_t N>
+[[nodiscard]] bool approx_equal(const VectorN<T, N> &a, const VectorN<T, N> &b, double e = 1e-10)
+{
+    for (std::size_t i = 0; i < N; ++i)
+        if (!approx_equal(a[i], b[i], e))
+            return false;
+    return true;
+}
+
+using Vector8i = VectorN<int, 8>;
+using Vector8f = VectorN<float, 8>;
+using Vector8d = VectorN<double, 8>;
+using Vector16f = VectorN<float, 16>;
+using Vector5d = VectorN<double, 5>;
+
+void test_aliases()
+{
+    static_assert(std::is_same_v<Vector2f, VectorN<float, 2>>);
+    static_assert(std::is_same_v<Vector3d, VectorN<double, 3>>);
+    static_assert(std::is_same_v<Vector4i, VectorN<int, 4>>);
+
+    // Named components map to indices
+    constexpr Vector3i v(1, 2, 3);
+    static_assert(v[0] == v.x && v[1] == v.y && v[2] == v.z);
+    Vector4f u(1.0f, 2.0f, 3.0f, 4.0f);
+    u[3] = 8.0f;
+    assert(u.w == 8.0f && u.data()[3] == 8.0f);
+    static_assert(Vector4f::size() == 4 && Vector8f::size() == 8);
+}
+
+void test_layout()
+{
+    // Tightly packed, multiples of four lanes aligned to the register width
+    static_assert(sizeof(Vector3f) == 3 * sizeof(float) && alignof(Vector3f) == alignof(float));
+    static_assert(sizeof(Vector8f) == 32 && alignof(Vector8f) == 16);
+    static_assert(sizeof(Vector8d) == 64 && alignof(Vector8d) == 32);
+    static_assert(sizeof(Vector16f) == 64 && alignof(Vector16f) == 16);
+    static_assert(sizeof(Vector5d) == 5 * sizeof(double) && alignof(Vector5d) == alignof(double));
+    static_assert(sizeof(Vector8i) == 8 * sizeof(int));
+}
+
+void test_arithmetic()
+{
+    constexpr Vector8i a_i(1, 2, 3, 4, 5, 6, 7, 8);
+    constexpr Vector8i b_i(8, 7, 6, 5, 4, 3, 2, 1);
+    static_assert(a_i + b_i == Vector8i(9, 9, 9, 9, 9, 9, 9, 9));
+    static_assert(a_i - 1 == Vector8i(0, 1, 2, 3, 4, 5, 6, 7));
+    static_assert(2 * a_i == Vector8i(2, 4, 6, 8, 10, 12, 14, 16));
+    static_assert(a_i.dot(b_i) == 120);
+    static_assert(-a_i == Vector8i(-1, -2, -3, -4, -5, -6, -7, -8));
+    {
+        Vector8i v{a_i};
+        v *= b_i;
+        v /= 2;
+        assert(v == Vector8i(4, 7, 9, 10, 10, 9, 7, 4));
+    }
+
+    constexpr Vector5d a_d(1.0, -2.0, 3.0, -4.0, 5.0);
+    constexpr Vector5d b_d(0.5, 0.5, 0.5, 0.5, 0.5);
+    static_assert(a_d * b_d == Vector5d(0.5, -1.0, 1.5, -2.0, 2.5));
+    static_assert(a_d.sign() == Vector5d(1.0, -1.0, 1.0, -1.0, 1.0));
+    static_assert(a_d.norm_squared() == 55.0);
+}
+
+void test_simd()
+{
+    // Runtime (SIMD) results must match the constexpr (scalar) ones
+    constexpr Vector8f a_f(1.5f, -2.0f, 0.25f, 8.0f, 3.0f, -0.5f, 4.0f, 1.0f);
+    constexpr Vector8f b_f(-0.5f, 4.0f, 2.0f, 0.125f, 1.0f, 2.0f, -8.0f, 0.5f);
+    Vector8f ra_f{a_f};
+    Vector8f rb_f{b_f};
+    constexpr Vector8f sum_f{a_f + b_f};
+    constexpr Vector8f quot_f{a_f / b_f};
+    constexpr Vector8f scaled_f{a_f * 3.0f};
+    assert(ra_f + rb_f == sum_f);
+    assert(ra_f / rb_f == quot_f);
+    assert(ra_f * 3.0f == scaled_f);
+    assert(-ra_f == Vector8f(-1.5f, 2.0f, -0.25f, -8.0f, -3.0f, 0.5f, -4.0f, -1.0f));
+    assert(ra_f.dot(rb_f) == a_f.dot(b_f) && ra_f.dot(rb_f) == -36.75f);
+    assert(!(ra_f == rb_f));
+    ra_f += rb_f;
+    assert(ra_f == sum_f);
+
+    // Tail components past the last full register
+    constexpr Vector5d a_d(1.0, -2.0, 3.0, -4.0, 5.0);
+    Vector5d ra_d{a_d};
+    assert(ra_d + ra_d == Vector5d(2.0, -4.0, 6.0, -8.0, 10.0));
+    assert(ra_d.dot(ra_d) == 55.0);
+    ra_d[4] = 6.0;
+    assert(!(ra_d == a_d));
+}
+
+template <typename V, typename = void>
+struct has_xw : std::false_type
+{
+};
+
+template <typename V>
+struct has_xw<V, std::void_t<decltype(std::declval<const V &>().xw())>> : std::true_type
+{
+};
+
+void test_swizzle()
+{
+    constexpr Vector4i v(1, 2, 3, 4);
+    static_assert(v.xyz() == Vector3i(1, 2, 3) && v.zyx() == Vector3i(3, 2, 1));
+    static_assert(v.xxyy() == Vector4i(1, 1, 2, 2) && v.wzyx() == Vector4i(4, 3, 2, 1));
+    static_assert(v.swizzle<3, 0>() == Vector2i(4, 1));
+    static_assert(Vector2i(1, 2).yx() == Vector2i(2, 1) && Vector2i(1, 2).yyy() == Vector3i(2, 2, 2));
+    static_assert(VectorN<int, 6>(1, 2, 3, 4, 5, 6).swizzle<5, 0>() == Vector2i(6, 1));
+    static_assert(std::is_same_v<decltype(v.xy()), Vector2i>);
+    static_assert(has_xw<Vector4f>::value && !has_xw<Vector3f>::value);
+
+    // Runtime (shuffle) results must match the constexpr (scalar) ones
+    constexpr Vector4f cf(1.5f, -2.0f, 0.25f, 8.0f);
+    constexpr Vector4d cd(1.5, -2.0, 0.25, 8.0);
+    const Vector4f f{cf};
+    const Vector4d d{cd};
+    assert(f.wzyx() == cf.wzyx() && f.yyzw() == cf.yyzw() && f.zxwy() == Vector4f(0.25f, 1.5f, 8.0f, -2.0f));
+    assert(d.wzyx() == cd.wzyx() && d.yyzw() == cd.yyzw() && d.zxwy() == Vector4d(0.25, 1.5, 8.0, -2.0));
+    assert(d.wwwx() == Vector4d(8.0, 8.0, 8.0, 1.5) && d.xyz() == Vector3d(1.5, -2.0, 0.25));
+
+    // Writable swizzles on non-const vectors
+    Vector4f w{cf};
+    w.zx() = Vector2f(10.0f, 20.0f);
+    assert(w == Vector4f(20.0f, -2.0f, 10.0f, 8.0f));
+    w.xy() = w.yx();
+    assert(w == Vector4f(-2.0f, 20.0f, 10.0f, 8.0f));
+    w.wzyx() = w;
+    assert(w == Vector4f(8.0f, 10.0f, 20.0f, -2.0f));
+    w.xyz() += Vector3f(1.0f, 1.0f, 1.0f);
+    w.yw() *= 2.0f;
+    assert(w == Vector4f(9.0f, 22.0f, 21.0f, -4.0f));
+
+    // Reading a writable swizzle gives a vector
+    const Vector3f r{w.xyz()};
+    assert(r == Vector3f(9.0f, 22.0f, 21.0f) && w.xyz() == r && w.xy() + w.zw() == Vector2f(30.0f, 18.0f));
+    assert(Vector2f(1.0f, 1.0f) + w.xy() == Vector2f(10.0f, 23.0f) && w.xy() * 2.0f == Vector2f(18.0f, 44.0f));
+    static_assert(std::is_same_v<decltype(w.xx()), Vector2f>);
+}
+
+void test_min_max()
+{
+    constexpr Vector4f a(1.0f, -2.0f, 3.0f, -4.0f);
+    constexpr Vector4f b(0.0f, 5.0f, 3.0f, -8.0f);
+    static_assert(a.min(b) == Vector4f(0.0f, -2.0f, 3.0f, -8.0f));
+    static_assert(a.max(b) == Vector4f(1.0f, 5.0f, 3.0f, -4.0f));
+    assert(a.min(b) == Vector4f(0.0f, -2.0f, 3.0f, -8.0f) && a.max(b) == Vector4f(1.0f, 5.0f, 3.0f, -4.0f));
+    assert(a.clamp(-1.0f, 2.0f) == Vector4f(1.0f, -1.0f, 2.0f, -1.0f));
+    assert(a.clamp(b, b + 1.0f) == Vector4f(1.0f, 5.0f, 3.0f, -7.0f));
+    assert(a.abs() == Vector4f(1.0f, 2.0f, 3.0f, 4.0f));
+    static_assert(Vector3i(-1, 0, 7).abs() == Vector3i(1, 0, 7));
+
+    // Same results as std::min / std::max: the first operand unless the second is strictly beyond it
+    const float nan{std::numeric_limits<float>::quiet_NaN()};
+    const Vector4f p(nan, 1.0f, 2.0f, 3.0f);
+    assert(std::isnan(p.min(a)[0]) && a.min(p)[0] == 1.0f && a.max(p)[0] == 1.0f);
+    assert(!std::signbit(Vector4f(-0.0f, 0.0f, 0.0f, 0.0f).abs()[0]));
+    assert(!std::signbit(Vector3f(-0.0f, 0.0f, 0.0f).abs()[0]));
+
+    const Vector8d c(0.5, -0.5, 1.5, -1.5, 2.0, -2.0, 0.0, 3.25);
+    assert(c.floor() == Vector8d(0.0, -1.0, 1.0, -2.0, 2.0, -2.0, 0.0, 3.0));
+    assert(c.ceil() == Vector8d(1.0, -0.0, 2.0, -1.0, 2.0, -2.0, 0.0, 4.0));
+    assert(c.min(-c) == -c.abs() && c.max(-c) == c.abs());
+
+    constexpr Vector3d from(0.0, 10.0, -4.0);
+    constexpr Vector3d to(1.0, 20.0, 4.0);
+    static_assert(from.lerp(to, 0.5) == Vector3d(0.5, 15.0, 0.0));
+    assert(from.lerp(to, 0.0) == from && from.lerp(to, 1.0) == to);
+    assert(Vector2i(0, 10).lerp(Vector2i(4, 20), 2) == Vector2i(8, 30));
+}
+
+void test_norm()
+{
+    constexpr Vector16f v(1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f,
+                          1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f);
+    static_assert(std::is_same_v<decltype(v.norm()), float>);
+    assert(v.norm() == 4.0f && v.norm<double>() == 4.0);
+    assert(approx_equal(v.normalize(), v / 4.0f));
+    assert(approx_equal(v.normalize_fast(), v / 4.0f, 1e-6));
+
+    constexpr Vector8d vd(1.0, 2.0, 2.0, 4.0, 0.0, 0.0, 0.0, 0.0);
+    assert(vd.norm() == 5.0);
+    assert(Vector8d().normalize() == Vector8d());
+}
+
+void test_convert()
+{
+    constexpr Vector8f vf(1.5f, -1.5f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f);
+    static_assert(static_cast<Vector8i>(vf) == Vector8i(1, -1, 2, 3, 4, 5, 6, 7));
+    assert(static_cast<Vector2d>(Vector2i(3, 4)).norm() == 5.0);
+}
+
+void test_stream_output()
+{
+    std::ostringstream oss{};
+    oss << VectorN<int, 5>(1, 2, 3, 4, 5) << " " << Vector2i(1, 2);
+    assert(oss.str() == "Vector5(1, 2, 3, 4, 5) Vector2(x=1, y=2)");
+}
+
+int main()
+{
+    test_aliases();
+    test_layout();
+    test_arithmetic();
+    test_simd();
+    test_swizzle();
+    test_min_max();
+    test_norm();
+    test_convert();
+    test_stream_output();
+    return 0;
+}
@@ -0,0 +1,171 @@
+#include <thread_pool.hpp>
+#include <vector_parallel.hpp>
+
+#include <atomic>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+[[nodiscard]] bool approx_equal(double a, double b, double e = 1e-10)
+{
+    return std::fabs(a - b) < e;
+}
+
+// Values spanning several orders of magnitude, so that summation order shows in the result
+std::vector<Vector3d> make_points(std::size_t n)
+{
+    std::vector<Vector3d> points;
+    points.reserve(n);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const double k{static_cast<double>(i)};
+        points.emplace_back(std::sin(k) * 1e6, std::cos(k) * 1e-3 + 1.0, 0.1 * static_cast<double>(i % 17) - 0.5);
+    }
+    return points;
+}
+
+void test_thread_pool()
+{
+    vec::ThreadPool pool(4);
+    assert(pool.size() == 4);
+    assert(vec::ThreadPool(0).size() == 1);
+
+    // Every index exactly once, also with uneven work per chunk
+    std::vector<std::atomic<int>> hits(1000);
+    pool.parallel_for(hits.size(), [&](std::size_t i)
+                      {
+                          volatile double sink{0.0};
+                          for (std::size_t k = 0; k < (i % 10) * 1000; ++k)
+                              sink = sink + 1.0;
+                          ++hits[i];
+                      });
+    for (const std::atomic<int> &h : hits)
+        assert(h == 1);
+
+    // Repeated loops reuse the workers
+    std::atomic<std::size_t> total{0};
+    for (int run = 0; run < 100; ++run)
+        pool.parallel_for(7, [&](std::size_t i) { total += i; });
+    assert(total == 100 * 21);
+
+    // Nested loops run inline
+    std::atomic<int> inner{0};
+    pool.parallel_for(8, [&](std::size_t)
+                      { pool.parallel_for(8, [&](std::size_t) { ++inner; }); });
+    assert(inner == 64);
+
+    pool.parallel_for(0, [](std::size_t) { assert(false); });
+}
+
+void test_transform_normalize()
+{
+    vec::ThreadPool pool(3);
+    const std::vector<Vector3d> in{make_points(100000)};
+
+    std::vector<double> lengths(in.size());
+    vec::parallel_transform(in.data(), lengths.data(), in.size(), [](const Vector3d &v) { return v.length(); }, pool);
+    for (std::size_t i = 0; i < in.size(); ++i)
+        assert(lengths[i] == in[i].length());
+
+    // Same results as the serial kernel
+    std::vector<Vector3d> serial(in.size());
+    std::vector<Vector3d> parallel(in.size());
+    vec::normalize(in.data(), serial.data(), in.size());
+    vec::parallel_normalize(in.data(), parallel.data(), in.size(), pool);
+    for (std::size_t i = 0; i < in.size(); ++i)
+        assert(parallel[i] == serial[i]);
+
+    // In place
+    vec::parallel_normalize(parallel.data(), parallel.data(), parallel.size(), pool);
+    assert(approx_equal(parallel[12345].length(), 1.0));
+}
+
+// The same vectors as one serial call, on any pool size
+void test_generate()
+{
+    const std::size_t n{100000};
+    vec::Philox4x32 serial_rng{9, 2};
+    std::vector<Vector3f> serial(n);
+    vec::generate(serial_rng, vec::OnUnitSphere<Vector3f>{}, serial.data(), n);
+
+    for (const std::size_t threads : {1, 3, 8})
+    {
+        vec::ThreadPool pool(threads);
+        vec::Philox4x32 rng{9, 2};
+        std::vector<Vector3f> parallel(n);
+        vec::parallel_generate(rng, vec::OnUnitSphere<Vector3f>{}, parallel.data(), n, pool);
+        assert(rng == serial_rng);
+        for (std::size_t i = 0; i < n; ++i)
+            assert(parallel[i] == serial[i]);
+    }
+}
+
+void test_sum_centroid()
+{
+    const std::vector<Vector3d> in{make_points(300000)};
+    vec::ThreadPool one(1);
+    vec::ThreadPool three(3);
+    vec::ThreadPool eight(8);
+
+    Vector3d serial;
+    for (const Vector3d &p : in)
+        serial += p;
+
+    // Deterministic mode: bit-identical for every pool size
+    const Vector3d d1{vec::parallel_sum(in.data(), in.size(), vec::reduction::deterministic, one)};
+    const Vector3d d3{vec::parallel_sum(in.data(), in.size(), vec::reduction::deterministic, three)};
+    const Vector3d d8{vec::parallel_sum(in.data(), in.size(), vec::reduction::deterministic, eight)};
+    assert(d1 == d3 && d1 == d8);
+    assert(approx_equal(d1.x, serial.x, 1e-3) && approx_equal(d1.y, serial.y, 1e-6));
+
+    // Fast mode: reproducible on the same pool
+    const Vector3d f3{vec::parallel_sum(in.data(), in.size(), vec::reduction::fast, three)};
+    assert(f3 == vec::parallel_sum(in.data(), in.size(), vec::reduction::fast, three));
+    assert(approx_equal(f3.y, serial.y, 1e-6));
+
+    // Small arrays are a single chunk: same as the serial loop
+    assert(vec::parallel_sum(in.data(), 1000, vec::reduction::fast, eight) ==
+           vec::detail::serial_sum<Vector3d>(in.data(), 0, 1000));
+    assert(vec::parallel_sum(in.data(), 0) == Vector3d());
+
+    const Vector3d c{vec::parallel_centroid(in.data(), in.size(), vec::reduction::deterministic, three)};
+    assert(c == d1 / static_cast<double>(in.size()));
+
+    // Float vectors are accumulated in double, integer centroids are double
+    const std::vector<Vector2f> f(1 << 20, Vector2f(0.1f, 3.0f));
+    const Vector2f cf{vec::parallel_centroid(f.data(), f.size(), vec::reduction::fast, three)};
+    assert(cf == Vector2f(0.1f, 3.0f));
+    const Vector4i vi[] = {Vector4i(1, 2, 3, 4), Vector4i(2, 2, 2, 2)};
+    static_assert(std::is_same_v<decltype(vec::parallel_centroid(vi, 2)), Vector4d>);
+    assert(vec::parallel_centroid(vi, 2) == Vector4d(1.5, 2.0, 2.5, 3.0));
+}
+
+void test_bounds()
+{
+    vec::ThreadPool pool(4);
+    const std::vector<Vector3d> in{make_points(200000)};
+    const auto [lo, hi] = vec::parallel_bounds(in.data(), in.size(), pool);
+
+    Vector3d serial_lo{in[0]};
+    Vector3d serial_hi{in[0]};
+    for (const Vector3d &p : in)
+        for (std::size_t c = 0; c < 3; ++c)
+        {
+            serial_lo[c] = std::min(serial_lo[c], p[c]);
+            serial_hi[c] = std::max(serial_hi[c], p[c]);
+        }
+    assert(lo == serial_lo && hi == serial_hi);
+    assert(lo.z == -0.5 && approx_equal(hi.z, 1.1));
+}
+
+int main()
+{
+    test_thread_pool();
+    test_transform_normalize();
+    test_generate();
+    test_sum_centroid();
+    test_bounds();
+    return 0;
+}
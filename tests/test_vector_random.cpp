@@ -0,0 +1,252 @@
+#include <vector_random.hpp>
+
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+// Known-answer vectors of the Random123 distribution
+void test_philox()
+{
+    using vec::detail::philox4x32;
+    assert((philox4x32({0, 0, 0, 0}, 0, 0) ==
+            vec::detail::philox_block{0x6627e8d5u, 0xe169c58du, 0xbc57ac4cu, 0x9b00dbd8u}));
+    assert((philox4x32({0xffffffffu, 0xffffffffu, 0xffffffffu, 0xffffffffu}, 0xffffffffu, 0xffffffffu) ==
+            vec::detail::philox_block{0x408f276du, 0x41c83b0eu, 0xa20bc7c6u, 0x6d5451fdu}));
+    assert((philox4x32({0x243f6a88u, 0x85a308d3u, 0x13198a2eu, 0x03707344u}, 0xa4093822u, 0x299f31d0u) ==
+            vec::detail::philox_block{0xd16cfe09u, 0x94fdccebu, 0x5001e420u, 0x24126ea1u}));
+
+    // The stream and seed are the high half of the counter and the key
+    const vec::Philox4x32 g{0x299f31d0a4093822u, 0x0370734413198a2eu};
+    assert((g.block(0x85a308d3243f6a88u) ==
+            vec::detail::philox_block{0xd16cfe09u, 0x94fdccebu, 0x5001e420u, 0x24126ea1u}));
+}
+
+// fill(), operator() and discard() walk the same stream from any position
+void test_engine()
+{
+    vec::Philox4x32 a{42, 7};
+    std::vector<std::uint32_t> expected(100);
+    for (std::uint32_t &w : expected)
+        w = a();
+    assert(a.position() == 100);
+
+    for (std::size_t start = 0; start < 9; ++start)
+        for (std::size_t n : {0, 1, 3, 4, 5, 17, 64})
+        {
+            vec::Philox4x32 b{42, 7};
+            b.discard(start);
+            std::vector<std::uint32_t> words(n);
+            b.fill(words.data(), n);
+            for (std::size_t i = 0; i < n; ++i)
+                assert(words[i] == expected[start + i]);
+            assert(b.position() == start + n && b() == expected[start + n]);
+        }
+
+    // Seeds and streams are independent sequences
+    vec::Philox4x32 other_stream{42, 8};
+    vec::Philox4x32 other_seed{43, 7};
+    int same{0};
+    for (const std::uint32_t w : expected)
+        same += (other_stream() == w) + (other_seed() == w);
+    assert(same <= 1);
+    assert(vec::Philox4x32(42, 7) == vec::Philox4x32(42, 7) && vec::Philox4x32(42, 7) != a);
+
+    // A UniformRandomBitGenerator
+    vec::Philox4x32 c{1};
+    std::uniform_int_distribution<int> die(1, 6);
+    int counts[7]{};
+    for (int i = 0; i < 60000; ++i)
+        ++counts[die(c)];
+    for (int k = 1; k <= 6; ++k)
+        assert(std::abs(counts[k] - 10000) < 500);
+}
+
+template <typename V>
+[[nodiscard]] double length(const V &v)
+{
+    double s{0};
+    for (std::size_t c = 0; c < vec::detail::vector_traits<V>::size; ++c)
+        s += double(v[c]) * double(v[c]);
+    return std::sqrt(s);
+}
+
+constexpr std::size_t count{100000};
+
+template <typename T>
+void test_box()
+{
+    using V = Vector3<T>;
+    const V lo(-1, 2, 10);
+    const V hi(1, 3, 20);
+    vec::Philox4x32 rng{3};
+    std::vector<V> v(count);
+    vec::generate(rng, vec::UniformBox<V>(lo, hi), v.data(), count);
+    assert(rng.position() == count * vec::UniformBox<V>::words);
+
+    V mean{};
+    for (const V &p : v)
+        for (std::size_t c = 0; c < 3; ++c)
+        {
+            assert(p[c] >= lo[c] && p[c] <= hi[c]);
+            mean[c] += p[c] / T(count);
+        }
+    for (std::size_t c = 0; c < 3; ++c)
+        assert(std::fabs(mean[c] - (lo[c] + hi[c]) / 2) < T(0.01) * (hi[c] - lo[c]));
+
+    // A cube is the box with the same bounds on every axis
+    vec::Philox4x32 cube_rng{3};
+    std::vector<V> cube(count);
+    vec::generate(cube_rng, vec::UniformBox<V>(T(-1), T(1)), cube.data(), count);
+    vec::Philox4x32 box_rng{3};
+    vec::generate(box_rng, vec::UniformBox<V>(V(-1, -1, -1), V(1, 1, 1)), v.data(), count);
+    assert(cube == v);
+}
+
+template <typename T>
+void test_sphere()
+{
+    vec::Philox4x32 rng{4};
+    std::vector<Vector2<T>> circle(count);
+    vec::generate(rng, vec::OnUnitSphere<Vector2<T>>{}, circle.data(), count);
+    double quadrant{0};
+    for (const Vector2<T> &p : circle)
+    {
+        assert(std::fabs(length(p) - 1) < 4 * std::numeric_limits<T>::epsilon());
+        quadrant += p.x > 0 && p.y > 0;
+    }
+    assert(std::fabs(quadrant / count - 0.25) < 0.005);
+
+    // z is uniform on the sphere, and so is every other axis
+    std::vector<Vector3<T>> sphere(count);
+    vec::generate(rng, vec::OnUnitSphere<Vector3<T>>{}, sphere.data(), count);
+    double squares[3]{};
+    for (const Vector3<T> &p : sphere)
+    {
+        assert(std::fabs(length(p) - 1) < 4 * std::numeric_limits<T>::epsilon());
+        for (std::size_t c = 0; c < 3; ++c)
+            squares[c] += double(p[c]) * double(p[c]) / count;
+    }
+    for (const double s : squares)
+        assert(std::fabs(s - 1.0 / 3) < 0.005);
+}
+
+template <typename T>
+void test_ball()
+{
+    vec::Philox4x32 rng{5};
+    std::vector<Vector2<T>> disk(count);
+    vec::generate(rng, vec::InUnitBall<Vector2<T>>{}, disk.data(), count);
+    double inner{0};
+    for (const Vector2<T> &p : disk)
+    {
+        assert(length(p) <= 1 + 4 * std::numeric_limits<T>::epsilon());
+        inner += length(p) < 0.5;
+    }
+    assert(std::fabs(inner / count - 0.25) < 0.005);
+
+    std::vector<Vector3<T>> ball(count);
+    vec::generate(rng, vec::InUnitBall<Vector3<T>>{}, ball.data(), count);
+    inner = 0;
+    Vector3<T> mean{};
+    for (const Vector3<T> &p : ball)
+    {
+        assert(length(p) <= 1 + 4 * std::numeric_limits<T>::epsilon());
+        inner += length(p) < 0.5;
+        mean += p / T(count);
+    }
+    assert(std::fabs(inner / count - 0.125) < 0.005 && length(mean) < 0.01);
+}
+
+template <typename T>
+void test_hemisphere()
+{
+    vec::Philox4x32 rng{6};
+    std::vector<Vector3<T>> v(count);
+    vec::generate(rng, vec::CosineHemisphere<T>{}, v.data(), count);
+    double z{0};
+    double below{0};
+    for (const Vector3<T> &p : v)
+    {
+        assert(p.z >= 0 && std::fabs(length(p) - 1) < 4 * std::numeric_limits<T>::epsilon());
+        z += p.z / double(count);
+        below += p.z < 0.5;
+    }
+    // E[cos theta] = 2/3 and P(cos theta < 1/2) = 1/4
+    assert(std::fabs(z - 2.0 / 3) < 0.005 && std::fabs(below / count - 0.25) < 0.005);
+}
+
+// Chunks starting on block boundaries, from advanced copies, give the same vectors as one call
+void test_reproducible()
+{
+    using D = vec::InUnitBall<Vector3f>;
+    const std::size_t n{5 * vec::kernel_block + 77};
+    vec::Philox4x32 rng{7, 1};
+    rng.discard(3);
+    const vec::Philox4x32 start{rng};
+    std::vector<Vector3f> whole(n);
+    vec::generate(rng, D{}, whole.data(), n);
+
+    std::vector<Vector3f> chunks(n);
+    for (std::size_t begin = 0; begin < n; begin += 2 * vec::kernel_block)
+    {
+        vec::Philox4x32 copy{start};
+        copy.discard(begin * D::words);
+        vec::generate(copy, D{}, chunks.data() + begin, std::min(2 * vec::kernel_block, n - begin));
+    }
+    for (std::size_t i = 0; i < n; ++i)
+        assert(chunks[i] == whole[i]);
+
+    // The same samples into a structure-of-arrays container
+    vec::Philox4x32 again{start};
+    Vector3fArray soa(n);
+    vec::generate(again, D{}, soa);
+    assert(again == rng);
+    for (std::size_t i = 0; i < n; ++i)
+        assert(soa[i] == whole[i]);
+
+    // One at a time: one-element blocks
+    vec::Philox4x32 single{start};
+    for (std::size_t i = 0; i < 10; ++i)
+    {
+        const Vector3f p{D{}(single)};
+        vec::Philox4x32 copy{start};
+        copy.discard(i * D::words);
+        Vector3f q;
+        vec::generate(copy, D{}, &q, 1);
+        assert(p == q);
+    }
+}
+
+// The dispatched copies take the same words; FMAs may move components by a rounding
+void test_dispatched()
+{
+    const std::size_t n{1000};
+    vec::Philox4x32 rng{10};
+    vec::Philox4x32 plain_rng{10};
+    std::vector<Vector3d> dispatched(n);
+    std::vector<Vector3d> plain(n);
+    vec::dispatched::generate(rng, vec::CosineHemisphere<double>{}, dispatched.data(), n);
+    vec::generate(plain_rng, vec::CosineHemisphere<double>{}, plain.data(), n);
+    assert(rng == plain_rng);
+    for (std::size_t i = 0; i < n; ++i)
+        assert(length(dispatched[i] - plain[i]) < 1e-14);
+}
+
+int main()
+{
+    test_philox();
+    test_engine();
+    test_box<float>();
+    test_box<double>();
+    test_sphere<float>();
+    test_sphere<double>();
+    test_ball<float>();
+    test_ball<double>();
+    test_hemisphere<float>();
+    test_hemisphere<double>();
+    test_reproducible();
+    test_dispatched();
+    return 0;
+}